@@ -0,0 +1,41 @@
+% Time the per-call overhead of the MEX dispatcher. Calls with small inputs
+% so the time is dominated by dispatching rather than the work itself.
+% Compares selecting the function by name (how wrappers used to call the
+% dispatcher), by opcode, and through the public wrapper, which adds argument
+% validation on top of the opcode call.
+
+nNodes = [10, 100, 1000];
+nReps = 10;
+
+privateDir = fullfile(fileparts(which("igraph.reindexMembership")), ...
+                      "private");
+oldDir = cd(privateDir);
+dispatcher = @mexIgraphDispatcher;
+cd(oldDir);
+
+opcode = dispatcher("opcode", "reindexMembership");
+names = ["name", "opcode", "wrapper"];
+times = zeros(length(nNodes), length(names));
+
+for n = 1:length(nNodes)
+    memb = randi(5, nNodes(n), 1);
+    calls = {@() dispatcher("reindexMembership", memb), ...
+             @() dispatcher(opcode, memb), ...
+             @() igraph.reindexMembership(memb)};
+    for c = 1:length(calls)
+        t = zeros(nReps, 1);
+        for r = 1:nReps
+            t(r) = timeit(calls{c});
+        end
+        times(n, c) = median(t);
+    end
+end
+
+fprintf("%8s", "nodes");
+fprintf("%12s", names + " (us)");
+fprintf("\n");
+for n = 1:length(nNodes)
+    fprintf("%8d", nNodes(n));
+    fprintf("%12.2f", 1e6 * times(n, :));
+    fprintf("\n");
+end
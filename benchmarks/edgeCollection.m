@@ -0,0 +1,37 @@
+% Compare the time to collect edges from adjacency matrices using the old
+% macro based edge iterator against the templated edge collector. Tests
+% over a range of graph sizes and edge densities for logical and double
+% full matrices and sparse double matrices.
+
+nNodes = round(10 .^ [2:0.25:4]);
+densities = [0.05, 0.25, 0.5];
+formats = {'full logical', 'full double', 'sparse double'};
+methods = {'legacy', 'template'};
+
+times = zeros(length(nNodes), length(densities), length(formats), ...
+              length(methods));
+
+for n = 1:length(nNodes)
+    for d = 1:length(densities)
+        g = randGraph(nNodes(n), densities(d));
+        adjs = {g, double(g), sparse(double(g))};
+        for f = 1:length(formats)
+            for m = 1:length(methods)
+                h = @() collectEdges(adjs{f}, true, methods{m});
+                times(n, d, f, m) = timeit(h, 2);
+            end
+        end
+    end
+end
+
+speedup = times(:, :, :, 1) ./ times(:, :, :, 2);
+
+figure()
+for f = 1:length(formats)
+    subplot(1, length(formats), f);
+    semilogx(nNodes', squeeze(speedup(:, :, f)), Marker = 'o');
+    title(formats{f});
+    xlabel("Number of nodes");
+    ylabel("Speedup (legacy / template)");
+    legend(compose("density %g", densities), Location = "best");
+end
@@ -0,0 +1,52 @@
+#include <igraph.h>
+#include <mxIgraph.h>
+#include <string.h>
+
+#include "legacyEdgeIterator.h"
+#include "mxIterators.h"
+
+/* collectEdges(adj, isdirected, method) collects the edges of adj with
+   either the "legacy" macro iterator or the "template" edge collector.
+   Returns the edge list as an n x 2 matrix (0-indexed) and the weights. */
+void mexFunction(int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  igraph_bool_t const directed = mxIsLogicalScalarTrue(prhs[1]);
+  char method[16];
+  mxIgraphProfile_t profile;
+
+  mxGetString(prhs[2], method, sizeof(method));
+  mxIgraphProfile(prhs[0], &profile);
+
+  igraph_integer_t const n_edges = mxIgraphProfileECount(&profile, directed);
+  igraph_integer_t* edges = mxMalloc(2 * (n_edges + 1) * sizeof(*edges));
+  igraph_real_t* weights = mxMalloc((n_edges + 1) * sizeof(*weights));
+
+  if (strcmp(method, "legacy") == 0) {
+    mxIgraph_eit eit;
+    igraph_integer_t edge_idx = 0;
+
+    mxIgraph_eit_create(prhs[0], &profile, &eit, directed);
+    while (!MXIGRAPH_EIT_END(eit)) {
+      edges[edge_idx] = MXIGRAPH_EIT_GET_ROW(eit);
+      edges[edge_idx + 1] = MXIGRAPH_EIT_GET_COL(eit);
+      weights[edge_idx / 2] = (igraph_real_t)(MXIGRAPH_EIT_GET_WEIGHT(eit));
+      edge_idx += 2;
+      MXIGRAPH_EIT_NEXT(eit);
+    }
+  } else {
+    mxIgraph_collect_edges(prhs[0], &profile, directed, edges, weights);
+  }
+
+  plhs[0] = mxCreateDoubleMatrix(n_edges, 2, mxREAL);
+  plhs[1] = mxCreateDoubleMatrix(n_edges, 1, mxREAL);
+  double* edge_list = mxGetDoubles(plhs[0]);
+  double* weight_list = mxGetDoubles(plhs[1]);
+  for (igraph_integer_t i = 0; i < n_edges; i++) {
+    edge_list[i] = edges[2 * i];
+    edge_list[i + n_edges] = edges[(2 * i) + 1];
+    weight_list[i] = weights[i];
+  }
+
+  mxFree(edges);
+  mxFree(weights);
+}
@@ -17,16 +17,22 @@
  */
 
 #include "mexIgraphFunctions.h"
+#include "utils.h"
 
 #include <mxIgraph.h>
+#include <stdint.h>
 
 static igraph_bool_t setup_ran = false;
+static mxIgraphLookup_t function_lookup;
 
 typedef enum {
-  MXIGRAPH_FUNC_CENTRALITY = 0,
+  MXIGRAPH_FUNC_CACHE = 0,
+  MXIGRAPH_FUNC_CENTRALITY,
   MXIGRAPH_FUNC_CLUSTER,
   MXIGRAPH_FUNC_COMPARE,
+  MXIGRAPH_FUNC_CONSENSUS,
   MXIGRAPH_FUNC_CORRELATEWITH,
+  MXIGRAPH_FUNC_ENSEMBLE,
   MXIGRAPH_FUNC_FAMOUS,
   MXIGRAPH_FUNC_GENERATE,
   MXIGRAPH_FUNC_GENERATEPAIR,
@@ -34,18 +40,85 @@ typedef enum {
   MXIGRAPH_FUNC_ISSUBISOMORPHIC,
   MXIGRAPH_FUNC_ISTREE,
   MXIGRAPH_FUNC_LAYOUT,
+  MXIGRAPH_FUNC_MEMORYBUDGET,
   MXIGRAPH_FUNC_MODULARITY,
+  MXIGRAPH_FUNC_OPCODE,
   MXIGRAPH_FUNC_OPTIMALMODULARITY,
+  MXIGRAPH_FUNC_PAIRWISECOMPARE,
   MXIGRAPH_FUNC_RANDGAME,
   MXIGRAPH_FUNC_READ,
   MXIGRAPH_FUNC_REINDEX_MEMBERSHIP,
   MXIGRAPH_FUNC_REWIRE,
   MXIGRAPH_FUNC_RNG,
+  MXIGRAPH_FUNC_RNGBUFFER,
   MXIGRAPH_FUNC_VERBOSE,
   MXIGRAPH_FUNC_WRITE,
   MXIGRAPH_FUNC_N
 } mexIgraph_funcname_t;
 
+static igraph_error_t opcode_i(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
+
+static char const* const function_names[MXIGRAPH_FUNC_N] = {
+  [MXIGRAPH_FUNC_CACHE] = "cache",
+  [MXIGRAPH_FUNC_CENTRALITY] = "centrality",
+  [MXIGRAPH_FUNC_CLUSTER] = "cluster",
+  [MXIGRAPH_FUNC_COMPARE] = "compare",
+  [MXIGRAPH_FUNC_CONSENSUS] = "consensus",
+  [MXIGRAPH_FUNC_CORRELATEWITH] = "correlateWith",
+  [MXIGRAPH_FUNC_ENSEMBLE] = "ensemble",
+  [MXIGRAPH_FUNC_FAMOUS] = "famous",
+  [MXIGRAPH_FUNC_GENERATE] = "generate",
+  [MXIGRAPH_FUNC_GENERATEPAIR] = "generatePair",
+  [MXIGRAPH_FUNC_ISISOMORPHIC] = "isisomorphic",
+  [MXIGRAPH_FUNC_ISSUBISOMORPHIC] = "issubisomorphic",
+  [MXIGRAPH_FUNC_ISTREE] = "istree",
+  [MXIGRAPH_FUNC_LAYOUT] = "layout",
+  [MXIGRAPH_FUNC_MEMORYBUDGET] = "memoryBudget",
+  [MXIGRAPH_FUNC_MODULARITY] = "modularity",
+  [MXIGRAPH_FUNC_OPCODE] = "opcode",
+  [MXIGRAPH_FUNC_OPTIMALMODULARITY] = "optimalModularity",
+  [MXIGRAPH_FUNC_PAIRWISECOMPARE] = "pairwiseCompare",
+  [MXIGRAPH_FUNC_RANDGAME] = "randgame",
+  [MXIGRAPH_FUNC_READ] = "load",
+  [MXIGRAPH_FUNC_REINDEX_MEMBERSHIP] = "reindexMembership",
+  [MXIGRAPH_FUNC_REWIRE] = "rewire",
+  [MXIGRAPH_FUNC_RNG] = "rng",
+  [MXIGRAPH_FUNC_RNGBUFFER] = "rngBuffer",
+  [MXIGRAPH_FUNC_VERBOSE] = "verbose",
+  [MXIGRAPH_FUNC_WRITE] = "save"
+};
+
+static mexIgraphFunction_t const function_table[MXIGRAPH_FUNC_N] = {
+  [MXIGRAPH_FUNC_CACHE] = mexIgraphCache,
+  [MXIGRAPH_FUNC_CENTRALITY] = mexIgraphCentrality,
+  [MXIGRAPH_FUNC_CLUSTER] = mexIgraphCluster,
+  [MXIGRAPH_FUNC_COMPARE] = mexIgraphCompare,
+  [MXIGRAPH_FUNC_CONSENSUS] = mexIgraphConsensus,
+  [MXIGRAPH_FUNC_CORRELATEWITH] = mexIgraphCorrelateWith,
+  [MXIGRAPH_FUNC_ENSEMBLE] = mexIgraphEnsemble,
+  [MXIGRAPH_FUNC_FAMOUS] = mexIgraphFamous,
+  [MXIGRAPH_FUNC_GENERATE] = mexIgraphGenerate,
+  [MXIGRAPH_FUNC_GENERATEPAIR] = mexIgraphGeneratePair,
+  [MXIGRAPH_FUNC_ISISOMORPHIC] = mexIgraphIsIsomorphic,
+  [MXIGRAPH_FUNC_ISSUBISOMORPHIC] = mexIgraphIsSubIsomorphic,
+  [MXIGRAPH_FUNC_ISTREE] = mexIgraphIsTree,
+  [MXIGRAPH_FUNC_LAYOUT] = mexIgraphLayout,
+  [MXIGRAPH_FUNC_MEMORYBUDGET] = mexIgraphMemoryBudget,
+  [MXIGRAPH_FUNC_MODULARITY] = mexIgraphModularity,
+  [MXIGRAPH_FUNC_OPCODE] = opcode_i,
+  [MXIGRAPH_FUNC_OPTIMALMODULARITY] = mexIgraphOptimalModularity,
+  [MXIGRAPH_FUNC_PAIRWISECOMPARE] = mexIgraphPairwiseCompare,
+  [MXIGRAPH_FUNC_RANDGAME] = mexIgraphRandGame,
+  [MXIGRAPH_FUNC_READ] = mexIgraphRead,
+  [MXIGRAPH_FUNC_REINDEX_MEMBERSHIP] = mexIgraphReindexMembership,
+  [MXIGRAPH_FUNC_REWIRE] = mexIgraphRewire,
+  [MXIGRAPH_FUNC_RNG] = mexIgraphRNG,
+  [MXIGRAPH_FUNC_RNGBUFFER] = mexIgraphRNGBuffer,
+  [MXIGRAPH_FUNC_VERBOSE] = mexIgraphSetHandler,
+  [MXIGRAPH_FUNC_WRITE] = mexIgraphWrite
+};
+
 static void mexIgraphSetupHook()
 {
   if (!setup_ran) {
@@ -53,65 +126,86 @@ static void mexIgraphSetupHook()
 
     mxIgraphSetRNG();
     mxIgraphSetDefaultHandlers();
+
+    if (mxIgraphLookupInit(
+          &function_lookup, function_names, MXIGRAPH_FUNC_N) !=
+        IGRAPH_SUCCESS) {
+      setup_ran = false;
+      IGRAPH_FATAL("Could not build the function lookup table.");
+    }
+  }
+}
+
+/* Opcodes are the hash of the function name. Wrappers request theirs once
+   and pass it on later calls so the name does not need to be copied out of
+   MATLAB and compared on every call. Since the hash only depends on the
+   name, opcodes held by wrappers remain valid after the MEX file is rebuilt
+   with a different set of functions. */
+static igraph_error_t opcode_i(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  char name[MXIGRAPH_NAME_MAX];
+
+  VERIFY_N_INPUTS_EQUAL(1);
+  VERIFY_N_OUTPUTS_ATMOST(1);
+
+  if (!mxIsChar(prhs[0]) ||
+      (mxGetString(prhs[0], name, sizeof(name)) != 0) ||
+      (mxIgraphLookupName(&function_lookup, name) == -1)) {
+    IGRAPH_ERROR("Argument must be the name of an igraph function.",
+      IGRAPH_EINVAL);
   }
+
+  plhs[0] = mxCreateDoubleScalar(mxIgraphHashName(name));
+
+  return IGRAPH_SUCCESS;
+}
+
+/* The function can be given either by name or by opcode. */
+static mexIgraph_funcname_t select_function_i(mxArray const* p)
+{
+  char name[MXIGRAPH_NAME_MAX];
+
+  if (mxIsNumeric(p) && (mxGetNumberOfElements(p) == 1) &&
+      !mxIsComplex(p)) {
+    double const opcode = mxGetScalar(p);
+    if ((opcode >= 0) && (opcode <= UINT32_MAX) &&
+        (opcode == (uint32_t)opcode)) {
+      return mxIgraphLookupHash(&function_lookup, (uint32_t)opcode);
+    }
+
+    return -1;
+  }
+
+  if (mxIsChar(p) && (mxGetString(p, name, sizeof(name)) == 0)) {
+    return mxIgraphLookupName(&function_lookup, name);
+  }
+
+  return -1;
 }
 
 void mexFunction(int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
 {
   mexIgraphSetupHook();
 
+  /* Graphs borrowed from the cache are pinned until released. If the last
+     call ended in an error it never reached its release so do it here. */
+  mxIgraphCacheRelease();
+
+  /* MATLAB's RNG may have been reseeded since the last call. */
+  mxIgraphRNGBufferInvalidate();
+
   mexIgraph_funcname_t function_name;
   mexIgraphFunction_t function;
 
-  char const* function_names[MXIGRAPH_FUNC_N] = {
-    [MXIGRAPH_FUNC_CENTRALITY] = "centrality",
-    [MXIGRAPH_FUNC_CLUSTER] = "cluster",
-    [MXIGRAPH_FUNC_COMPARE] = "compare",
-    [MXIGRAPH_FUNC_CORRELATEWITH] = "correlateWith",
-    [MXIGRAPH_FUNC_FAMOUS] = "famous",
-    [MXIGRAPH_FUNC_GENERATE] = "generate",
-    [MXIGRAPH_FUNC_GENERATEPAIR] = "generatePair",
-    [MXIGRAPH_FUNC_ISISOMORPHIC] = "isisomorphic",
-    [MXIGRAPH_FUNC_ISSUBISOMORPHIC] = "issubisomorphic",
-    [MXIGRAPH_FUNC_ISTREE] = "istree",
-    [MXIGRAPH_FUNC_LAYOUT] = "layout",
-    [MXIGRAPH_FUNC_MODULARITY] = "modularity",
-    [MXIGRAPH_FUNC_OPTIMALMODULARITY] = "optimalModularity",
-    [MXIGRAPH_FUNC_RANDGAME] = "randgame",
-    [MXIGRAPH_FUNC_READ] = "load",
-    [MXIGRAPH_FUNC_REINDEX_MEMBERSHIP] = "reindexMembership",
-    [MXIGRAPH_FUNC_REWIRE] = "rewire",
-    [MXIGRAPH_FUNC_RNG] = "rng",
-    [MXIGRAPH_FUNC_VERBOSE] = "verbose",
-    [MXIGRAPH_FUNC_WRITE] = "save"
-  };
+  if (nrhs < 1) {
+    IGRAPH_FATAL("Missing function name.");
+  }
 
-  function_name =
-    mxIgraphSelectMethod(prhs[0], function_names, MXIGRAPH_FUNC_N);
-  MXIGRAPH_CHECK_METHOD(function_name, prhs[0]);
-
-  mexIgraphFunction_t function_table[MXIGRAPH_FUNC_N] = {
-    [MXIGRAPH_FUNC_CENTRALITY] = mexIgraphCentrality,
-    [MXIGRAPH_FUNC_CLUSTER] = mexIgraphCluster,
-    [MXIGRAPH_FUNC_COMPARE] = mexIgraphCompare,
-    [MXIGRAPH_FUNC_CORRELATEWITH] = mexIgraphCorrelateWith,
-    [MXIGRAPH_FUNC_FAMOUS] = mexIgraphFamous,
-    [MXIGRAPH_FUNC_GENERATE] = mexIgraphGenerate,
-    [MXIGRAPH_FUNC_GENERATEPAIR] = mexIgraphGeneratePair,
-    [MXIGRAPH_FUNC_ISISOMORPHIC] = mexIgraphIsIsomorphic,
-    [MXIGRAPH_FUNC_ISSUBISOMORPHIC] = mexIgraphIsSubIsomorphic,
-    [MXIGRAPH_FUNC_ISTREE] = mexIgraphIsTree,
-    [MXIGRAPH_FUNC_LAYOUT] = mexIgraphLayout,
-    [MXIGRAPH_FUNC_MODULARITY] = mexIgraphModularity,
-    [MXIGRAPH_FUNC_OPTIMALMODULARITY] = mexIgraphOptimalModularity,
-    [MXIGRAPH_FUNC_RANDGAME] = mexIgraphRandGame,
-    [MXIGRAPH_FUNC_READ] = mexIgraphRead,
-    [MXIGRAPH_FUNC_REINDEX_MEMBERSHIP] = mexIgraphReindexMembership,
-    [MXIGRAPH_FUNC_REWIRE] = mexIgraphRewire,
-    [MXIGRAPH_FUNC_RNG] = mexIgraphRNG,
-    [MXIGRAPH_FUNC_VERBOSE] = mexIgraphSetHandler,
-    [MXIGRAPH_FUNC_WRITE] = mexIgraphWrite
-  };
+  function_name = select_function_i(prhs[0]);
+  if (function_name == -1) {
+    IGRAPH_FATAL("Recieved unknown function name or opcode.");
+  }
 
   function = function_table[function_name];
 
@@ -121,6 +215,7 @@ void mexFunction(int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
 
   // prhs[0] is function name, do not need to pass it on.
   igraph_error_t rs = function(nlhs, plhs, nrhs - 1, prhs + 1);
+  mxIgraphCacheRelease();
   if (rs != IGRAPH_SUCCESS) {
     IGRAPH_ERROR_NO_RETURN("", rs);
   };
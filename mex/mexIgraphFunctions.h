@@ -24,14 +24,20 @@
 typedef igraph_error_t (*mexIgraphFunction_t)(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 
+igraph_error_t mexIgraphCache(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphCentrality(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphCluster(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphCompare(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
+igraph_error_t mexIgraphConsensus(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphCorrelateWith(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
+igraph_error_t mexIgraphEnsemble(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphFamous(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphGenerate(
@@ -46,10 +52,14 @@ igraph_error_t mexIgraphIsTree(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphLayout(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
+igraph_error_t mexIgraphMemoryBudget(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphModularity(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphOptimalModularity(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
+igraph_error_t mexIgraphPairwiseCompare(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphRandGame(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphRead(
@@ -60,6 +70,8 @@ igraph_error_t mexIgraphRewire(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphRNG(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
+igraph_error_t mexIgraphRNGBuffer(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphSetHandler(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[]);
 igraph_error_t mexIgraphWrite(
@@ -0,0 +1,80 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "utils.h"
+
+#include <mxIgraph.h>
+
+static mxArray* cache_stats_i(void)
+{
+  mxIgraphCacheStats_t stats;
+  char const* fields[] = { "hits", "misses", "entries", "capacity" };
+  mwSize const n_fields = sizeof(fields) / sizeof(fields[0]);
+  mxArray* p = mxCreateStructMatrix(1, 1, n_fields, fields);
+
+  mxIgraphCacheStats(&stats);
+  mxSetField(p, 0, "hits", mxCreateDoubleScalar(stats.hits));
+  mxSetField(p, 0, "misses", mxCreateDoubleScalar(stats.misses));
+  mxSetField(p, 0, "entries", mxCreateDoubleScalar(stats.size));
+  mxSetField(p, 0, "capacity", mxCreateDoubleScalar(stats.capacity));
+
+  return p;
+}
+
+igraph_error_t mexIgraphCache(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(2);
+  VERIFY_N_OUTPUTS_ATMOST(1);
+
+  typedef enum {
+    MXIGRAPH_CACHE_INFO = 0,
+    MXIGRAPH_CACHE_CLEAR,
+    MXIGRAPH_CACHE_CAPACITY,
+    MXIGRAPH_CACHE_N
+  } mxIgraph_cache_action_t;
+
+  mxIgraph_cache_action_t action;
+  static char const* const actions[MXIGRAPH_CACHE_N] = {
+    [MXIGRAPH_CACHE_INFO] = "info",
+    [MXIGRAPH_CACHE_CLEAR] = "clear",
+    [MXIGRAPH_CACHE_CAPACITY] = "capacity",
+  };
+
+  action = mxIgraphSelectMethod(prhs[0], actions, MXIGRAPH_CACHE_N);
+  MXIGRAPH_CHECK_METHOD(action, prhs[0]);
+
+  switch (action) {
+    case MXIGRAPH_CACHE_INFO:
+      break;
+    case MXIGRAPH_CACHE_CLEAR:
+      mxIgraphCacheClear();
+      break;
+    case MXIGRAPH_CACHE_CAPACITY:
+      mxIgraphCacheSetCapacity((igraph_integer_t)mxGetScalar(prhs[1]));
+      break;
+    default:
+      IGRAPH_FATAL("Got an unexpected cache action.");
+  }
+
+  if (nlhs == 1) {
+    plhs[0] = cache_stats_i();
+  }
+
+  return IGRAPH_SUCCESS;
+}
@@ -20,69 +20,66 @@
 
 #include <mxIgraph.h>
 
-igraph_error_t mexIgraphCentrality(
-  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
-{
-  VERIFY_N_INPUTS_EQUAL(4);
-  VERIFY_N_OUTPUTS_EQUAL(1);
+typedef enum {
+  MXIGRAPH_CENTRALITY_CLOSENESS = 0,
+  MXIGRAPH_CENTRALITY_HARMONIC,
+  MXIGRAPH_CENTRALITY_BETWEENNESS,
+  MXIGRAPH_CENTRALITY_PAGERANK,
+  MXIGRAPH_CENTRALITY_BURT,
+  MXIGRAPH_CENTRALITY_EIGENVECTOR,
+  MXIGRAPH_CENTRALITY_N
+} mxIgraph_centrality_t;
 
-  enum {
-    MXIGRAPH_CENTRALITY_CLOSENESS = 0,
-    MXIGRAPH_CENTRALITY_HARMONIC,
-    MXIGRAPH_CENTRALITY_BETWEENNESS,
-    MXIGRAPH_CENTRALITY_PAGERANK,
-    MXIGRAPH_CENTRALITY_BURT,
-    MXIGRAPH_CENTRALITY_EIGENVECTOR,
-    MXIGRAPH_CENTRALITY_N
-  };
+/* Options read on the main thread so centrality can be calculated on worker
+ threads. */
+typedef struct {
+  mxIgraph_centrality_t method;
+  igraph_bool_t directed;
+  igraph_neimode_t mode;
+  igraph_bool_t normalized;
+  igraph_real_t damping;
+  igraph_vector_int_t vids;
+} mxIgraph_centrality_params_t;
 
-  char const* methods[MXIGRAPH_CENTRALITY_N] = {
-    [MXIGRAPH_CENTRALITY_CLOSENESS] = "closeness",
-    [MXIGRAPH_CENTRALITY_HARMONIC] = "harmonic",
-    [MXIGRAPH_CENTRALITY_BETWEENNESS] = "betweenness",
-    [MXIGRAPH_CENTRALITY_PAGERANK] = "pagerank",
-    [MXIGRAPH_CENTRALITY_BURT] = "burt",
-    [MXIGRAPH_CENTRALITY_EIGENVECTOR] = "eigenvector"
-  };
+/* The graph was built from the same graph options, so its directedness is the
+ resolved "isdirected" flag even when the caller asked for it to be
+ inferred. */
+static igraph_error_t centrality_params_i(mxIgraph_centrality_t const method,
+  igraph_t const* graph, mxArray const* method_options,
+  mxIgraph_centrality_params_t* params)
+{
+  params->method = method;
+  params->directed = igraph_is_directed(graph);
+  params->mode = mxIgraphModeFromOptions(method_options);
+  params->normalized = mxIgraphBoolFromOptions(method_options, "normalized");
+  params->damping = mxIgraphRealFromOptions(method_options, "damping");
+  MXIGRAPH_CHECK_STATUS();
 
-  igraph_integer_t method =
-    mxIgraphSelectMethod(prhs[1], methods, MXIGRAPH_CENTRALITY_N);
-  MXIGRAPH_CHECK_METHOD(method, prhs[1]);
+  IGRAPH_CHECK(
+    mxIgraphVectorIntFromOptions(method_options, "vids", &params->vids, true));
 
-  mxArray const* graph_options = prhs[2];
-  mxArray const* method_options = prhs[3];
+  return IGRAPH_SUCCESS;
+}
 
-  igraph_t graph;
-  igraph_vector_t weights;
-  igraph_vector_t res;
-  igraph_vector_int_t vertices;
+static void centrality_params_destroy_i(mxIgraph_centrality_params_t* params)
+{
+  igraph_vector_int_destroy(&params->vids);
+}
+
+static igraph_error_t centrality_i(igraph_t const* graph,
+  igraph_vector_t const* weights, mxIgraph_centrality_params_t const* params,
+  igraph_vector_t* res)
+{
   igraph_vs_t vids;
   igraph_bool_t warning;
-  igraph_bool_t const directed =
-    mxIgraphBoolFromOptions(graph_options, "isdirected");
-  igraph_neimode_t const mode = mxIgraphModeFromOptions(method_options);
-  igraph_bool_t const normalized =
-    mxIgraphBoolFromOptions(method_options, "normalized");
-  igraph_real_t const damping =
-    mxIgraphRealFromOptions(method_options, "damping");
-  MXIGRAPH_CHECK_STATUS();
 
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &graph, &weights, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph);
-  IGRAPH_FINALLY(igraph_vector_destroy, &weights);
-  IGRAPH_CHECK(
-    mxIgraphVectorIntFromOptions(method_options, "vids", &vertices, true));
-  IGRAPH_FINALLY(igraph_vector_int_destroy, &vertices);
-  IGRAPH_CHECK(igraph_vs_vector(&vids, &vertices));
+  IGRAPH_CHECK(igraph_vs_vector(&vids, &params->vids));
   IGRAPH_FINALLY(igraph_vs_destroy, &vids);
 
-  IGRAPH_CHECK(igraph_vector_init(&res, 0));
-  IGRAPH_FINALLY(igraph_vector_destroy, &res);
-
-  switch (method) {
+  switch (params->method) {
     case MXIGRAPH_CENTRALITY_CLOSENESS:
-      IGRAPH_CHECK(igraph_closeness(&graph, &res, NULL, &warning, vids, mode,
-        MXIGRAPH_WEIGHTS(&weights), normalized));
+      IGRAPH_CHECK(igraph_closeness(graph, res, NULL, &warning, vids,
+        params->mode, weights, params->normalized));
 
       if (warning) {
         IGRAPH_WARNING(
@@ -92,37 +89,179 @@ igraph_error_t mexIgraphCentrality(
       break;
     case MXIGRAPH_CENTRALITY_HARMONIC:
       IGRAPH_CHECK(igraph_harmonic_centrality(
-        &graph, &res, vids, mode, MXIGRAPH_WEIGHTS(&weights), normalized));
+        graph, res, vids, params->mode, weights, params->normalized));
       break;
     case MXIGRAPH_CENTRALITY_BETWEENNESS:
-      IGRAPH_CHECK(igraph_betweenness(
-        &graph, &res, vids, directed, MXIGRAPH_WEIGHTS(&weights)));
+      IGRAPH_CHECK(
+        igraph_betweenness(graph, res, vids, params->directed, weights));
       break;
     case MXIGRAPH_CENTRALITY_PAGERANK:
-      IGRAPH_CHECK(igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_PRPACK, &res,
-        NULL, vids, directed, damping, MXIGRAPH_WEIGHTS(&weights), NULL));
+      IGRAPH_CHECK(igraph_pagerank(graph, IGRAPH_PAGERANK_ALGO_PRPACK, res,
+        NULL, vids, params->directed, params->damping, weights, NULL));
       break;
     case MXIGRAPH_CENTRALITY_BURT:
-      IGRAPH_CHECK(
-        igraph_constraint(&graph, &res, vids, MXIGRAPH_WEIGHTS(&weights)));
+      IGRAPH_CHECK(igraph_constraint(graph, res, vids, weights));
       break;
     case MXIGRAPH_CENTRALITY_EIGENVECTOR:
-      IGRAPH_CHECK(igraph_eigenvector_centrality(&graph, &res, NULL, directed,
-        normalized, MXIGRAPH_WEIGHTS(&weights), NULL));
+      IGRAPH_CHECK(igraph_eigenvector_centrality(graph, res, NULL,
+        params->directed, params->normalized, weights, NULL));
       break;
     default:
       IGRAPH_FATAL("Got unexpected method name.");
   }
 
   igraph_vs_destroy(&vids);
-  igraph_vector_int_destroy(&vertices);
-  igraph_vector_destroy(&weights);
-  igraph_destroy(&graph);
-  IGRAPH_FINALLY_CLEAN(4);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  return IGRAPH_SUCCESS;
+}
+
+/* State shared by the tasks of a batched call. Only the first n_ready
+ entries of each array have been initialized. */
+typedef struct {
+  igraph_integer_t n_ready;
+  igraph_t* graphs;
+  igraph_vector_t* weights;
+  mxIgraph_centrality_params_t* params;
+  igraph_vector_t* results;
+} mxIgraph_centrality_batch_t;
+
+static void centrality_batch_destroy_i(mxIgraph_centrality_batch_t* batch)
+{
+  for (igraph_integer_t i = 0; i < batch->n_ready; i++) {
+    igraph_destroy(batch->graphs + i);
+    igraph_vector_destroy(batch->weights + i);
+    centrality_params_destroy_i(batch->params + i);
+    igraph_vector_destroy(batch->results + i);
+  }
+
+  IGRAPH_FREE(batch->graphs);
+  IGRAPH_FREE(batch->weights);
+  IGRAPH_FREE(batch->params);
+  IGRAPH_FREE(batch->results);
+}
+
+static igraph_error_t centrality_batch_task_i(igraph_integer_t task,
+  igraph_integer_t UNUSED(thread), void* data)
+{
+  mxIgraph_centrality_batch_t* batch = data;
+
+  return centrality_i(batch->graphs + task,
+    MXIGRAPH_WEIGHTS(batch->weights + task), batch->params + task,
+    batch->results + task);
+}
+
+/* Calculate centrality for each graph in a cell array. Graph and method
+ options are cell arrays with one options struct per graph. */
+static igraph_error_t centrality_batch_i(mxArray* plhs[],
+  mxArray const* graphs, mxIgraph_centrality_t const method,
+  mxArray const* graph_options, mxArray const* method_options)
+{
+  igraph_integer_t const n_graphs = mxGetNumberOfElements(graphs);
+  igraph_integer_t failed;
+  mxIgraph_centrality_batch_t batch = { 0 };
+
+  batch.graphs = IGRAPH_CALLOC(n_graphs, igraph_t);
+  batch.weights = IGRAPH_CALLOC(n_graphs, igraph_vector_t);
+  batch.params = IGRAPH_CALLOC(n_graphs, mxIgraph_centrality_params_t);
+  batch.results = IGRAPH_CALLOC(n_graphs, igraph_vector_t);
+  IGRAPH_FINALLY(centrality_batch_destroy_i, &batch);
+  IGRAPH_CHECK_OOM(batch.graphs, "Could not allocate batch.");
+  IGRAPH_CHECK_OOM(batch.weights, "Could not allocate batch.");
+  IGRAPH_CHECK_OOM(batch.params, "Could not allocate batch.");
+  IGRAPH_CHECK_OOM(batch.results, "Could not allocate batch.");
+
+  for (igraph_integer_t i = 0; i < n_graphs; i++) {
+    igraph_t* graph = batch.graphs + i;
+    igraph_vector_t* weights = batch.weights + i;
+    mxIgraph_centrality_params_t* params = batch.params + i;
+
+    IGRAPH_CHECK(mxIgraphFromArray(mxGetCell(graphs, i), graph, weights,
+      mxGetCell(graph_options, i)));
+    IGRAPH_FINALLY(igraph_destroy, graph);
+    IGRAPH_FINALLY(igraph_vector_destroy, weights);
+
+    IGRAPH_CHECK(centrality_params_i(
+      method, graph, mxGetCell(method_options, i), params));
+    IGRAPH_FINALLY(centrality_params_destroy_i, params);
+
+    IGRAPH_CHECK(igraph_vector_init(batch.results + i, 0));
+
+    IGRAPH_FINALLY_CLEAN(3);
+    batch.n_ready++;
+  }
+
+  IGRAPH_FINALLY_CLEAN(1);
+  igraph_error_t const rs =
+    mxIgraphBatchRun(n_graphs, centrality_batch_task_i, &batch, &failed);
+
+  if (rs == IGRAPH_SUCCESS) {
+    plhs[0] = mxCreateCellMatrix(1, n_graphs);
+    for (igraph_integer_t i = 0; i < n_graphs; i++) {
+      mxSetCell(plhs[0], i,
+        mxIgraphVectorToArray(batch.results + i, MXIGRAPH_IDX_KEEP));
+    }
+  }
+
+  centrality_batch_destroy_i(&batch);
+
+  if (rs != IGRAPH_SUCCESS) {
+    IGRAPH_ERRORF(
+      "Failed to calculate centrality of graph %" IGRAPH_PRId ". %s", rs,
+      failed + 1, mxIgraphBatchError());
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+igraph_error_t mexIgraphCentrality(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(4);
+  VERIFY_N_OUTPUTS_EQUAL(1);
+
+  static char const* const methods[MXIGRAPH_CENTRALITY_N] = {
+    [MXIGRAPH_CENTRALITY_CLOSENESS] = "closeness",
+    [MXIGRAPH_CENTRALITY_HARMONIC] = "harmonic",
+    [MXIGRAPH_CENTRALITY_BETWEENNESS] = "betweenness",
+    [MXIGRAPH_CENTRALITY_PAGERANK] = "pagerank",
+    [MXIGRAPH_CENTRALITY_BURT] = "burt",
+    [MXIGRAPH_CENTRALITY_EIGENVECTOR] = "eigenvector"
+  };
+
+  mxIgraph_centrality_t method =
+    mxIgraphSelectMethod(prhs[1], methods, MXIGRAPH_CENTRALITY_N);
+  MXIGRAPH_CHECK_METHOD(method, prhs[1]);
+
+  mxArray const* graph_options = prhs[2];
+  mxArray const* method_options = prhs[3];
+
+  igraph_t const* graph;
+  igraph_vector_t const* weights;
+  igraph_vector_t res;
+  mxIgraph_centrality_params_t params;
+
+  if (mxIsCell(prhs[0])) {
+    return centrality_batch_i(
+      plhs, prhs[0], method, graph_options, method_options);
+  }
+
+  IGRAPH_CHECK(
+    mxIgraphFromArrayCached(prhs[0], &graph, &weights, graph_options));
+  IGRAPH_CHECK(
+    centrality_params_i(method, graph, method_options, &params));
+  IGRAPH_FINALLY(centrality_params_destroy_i, &params);
+
+  IGRAPH_CHECK(igraph_vector_init(&res, 0));
+  IGRAPH_FINALLY(igraph_vector_destroy, &res);
+
+  IGRAPH_CHECK(
+    centrality_i(graph, MXIGRAPH_WEIGHTS(weights), &params, &res));
 
   plhs[0] = mxIgraphVectorToArray(&res, MXIGRAPH_IDX_KEEP);
   igraph_vector_destroy(&res);
-  IGRAPH_FINALLY_CLEAN(1);
+  centrality_params_destroy_i(&params);
+  IGRAPH_FINALLY_CLEAN(2);
 
   return IGRAPH_SUCCESS;
 }
@@ -17,28 +17,124 @@
  */
 
 #include "utils.h"
+#include "mexIgraphCluster.h"
 
 #include <mxIgraph.h>
 #include <string.h>
 
-typedef enum {
-  MXIGRAPH_CLUSTER_OPTIMAL = 0,
-  MXIGRAPH_CLUSTER_SPINGLASS,
-  MXIGRAPH_CLUSTER_LEADINGEIGENVECTOR,
-  MXIGRAPH_CLUSTER_WALKTRAP,
-  MXIGRAPH_CLUSTER_EDGEBETWEENNESS,
-  MXIGRAPH_CLUSTER_FASTGREEDY,
-  MXIGRAPH_CLUSTER_MULTILEVEL,
-  MXIGRAPH_CLUSTER_LEIDEN,
-  MXIGRAPH_CLUSTER_FLUIDCOMMUNITIES,
-  MXIGRAPH_CLUSTER_LABELPROPAGATION,
-  MXIGRAPH_CLUSTER_INFOMAP,
-  MXIGRAPH_CLUSTER_N
-} mxIgraph_cluster_t;
+void mexIgraphClusterParamsDestroy(mxIgraph_cluster_params_t* params)
+{
+  igraph_vector_int_destroy(&params->initial);
+  igraph_vector_bool_destroy(&params->fixed);
+  igraph_vector_destroy(&params->node_weights);
+  igraph_vector_destroy(&params->resolutions);
+}
+
+igraph_error_t mexIgraphClusterParams(mxIgraph_cluster_t const method,
+  mxArray const* opts, mxIgraph_cluster_params_t* params)
+{
+  igraph_bool_t const has_initial =
+    (method == MXIGRAPH_CLUSTER_LEADINGEIGENVECTOR) ||
+    (method == MXIGRAPH_CLUSTER_LEIDEN) ||
+    (method == MXIGRAPH_CLUSTER_LABELPROPAGATION);
+  char name[MXIGRAPH_NAME_MAX];
+
+  switch (method) {
+    case MXIGRAPH_CLUSTER_SPINGLASS:
+      params->n_spins = mxIgraphIntegerFromOptions(opts, "nSpins");
+      params->parallel = mxIgraphBoolFromOptions(opts, "parallel");
+      params->start_temp = mxIgraphRealFromOptions(opts, "tempStart");
+      params->end_temp = mxIgraphRealFromOptions(opts, "tempEnd");
+      params->cool_factor = mxIgraphRealFromOptions(opts, "coolingFactor");
+      params->update_rule =
+        strcmp(mxIgraphStringFromOptions(
+                 opts, "updateRule", name, sizeof(name)),
+          "simple") == 0 ?
+          IGRAPH_SPINCOMM_UPDATE_SIMPLE :
+          IGRAPH_SPINCOMM_UPDATE_CONFIG;
+      params->resolution = mxIgraphRealFromOptions(opts, "resolution");
+      params->neg_resolution = mxIgraphRealFromOptions(opts, "negResolution");
+      break;
+    case MXIGRAPH_CLUSTER_LEADINGEIGENVECTOR:
+      params->n_steps = mxIgraphIntegerFromOptions(opts, "maxSteps");
+      break;
+    case MXIGRAPH_CLUSTER_WALKTRAP:
+      params->n_steps = mxIgraphIntegerFromOptions(opts, "nSteps");
+      break;
+    case MXIGRAPH_CLUSTER_MULTILEVEL:
+      params->resolution = mxIgraphRealFromOptions(opts, "resolution");
+      break;
+    case MXIGRAPH_CLUSTER_LEIDEN:
+      params->resolution = mxIgraphRealFromOptions(opts, "resolution");
+      params->randomness = mxIgraphRealFromOptions(opts, "randomness");
+      params->n_iterations = mxIgraphIntegerFromOptions(opts, "nIterations");
+      params->use_modularity =
+        strcmp(mxIgraphStringFromOptions(opts, "metric", name, sizeof(name)),
+          "modularity") == 0;
+      break;
+    case MXIGRAPH_CLUSTER_FLUIDCOMMUNITIES:
+      params->n_communities = mxIgraphIntegerFromOptions(opts, "nCommunities");
+      break;
+    case MXIGRAPH_CLUSTER_LABELPROPAGATION:
+      params->mode = mxIgraphModeFromOptions(opts);
+      break;
+    case MXIGRAPH_CLUSTER_INFOMAP:
+      params->n_trials = mxIgraphIntegerFromOptions(opts, "nTrials");
+      break;
+    default:
+      break;
+  }
+
+  params->n_starts = mxGetField(opts, 0, "nStarts") ?
+                       mxIgraphIntegerFromOptions(opts, "nStarts") :
+                       1;
+  params->return_all = mxGetField(opts, 0, "returnAll") &&
+                       mxIgraphBoolFromOptions(opts, "returnAll");
+  params->parallel_sweep = mxGetField(opts, 0, "parallelSweep") &&
+                           mxIgraphBoolFromOptions(opts, "parallelSweep");
+  MXIGRAPH_CHECK_STATUS();
+
+  if (has_initial) {
+    IGRAPH_CHECK(
+      mxIgraphVectorIntFromOptions(opts, "initial", &params->initial, true));
+  } else {
+    IGRAPH_CHECK(igraph_vector_int_init(&params->initial, 0));
+  }
+  IGRAPH_FINALLY(igraph_vector_int_destroy, &params->initial);
+
+  if (method == MXIGRAPH_CLUSTER_LABELPROPAGATION) {
+    IGRAPH_CHECK(
+      mxIgraphVectorBoolFromOptions(opts, "fixed", &params->fixed, false));
+  } else {
+    IGRAPH_CHECK(igraph_vector_bool_init(&params->fixed, 0));
+  }
+  IGRAPH_FINALLY(igraph_vector_bool_destroy, &params->fixed);
+
+  if (method == MXIGRAPH_CLUSTER_INFOMAP) {
+    IGRAPH_CHECK(mxIgraphVectorFromOptions(
+      opts, "nodeWeights", &params->node_weights, MXIGRAPH_IDX_KEEP));
+  } else {
+    IGRAPH_CHECK(igraph_vector_init(&params->node_weights, 0));
+  }
+  IGRAPH_FINALLY(igraph_vector_destroy, &params->node_weights);
+
+  if ((method == MXIGRAPH_CLUSTER_MULTILEVEL) ||
+      (method == MXIGRAPH_CLUSTER_LEIDEN)) {
+    IGRAPH_CHECK(mxIgraphVectorFromOptions(
+      opts, "resolution", &params->resolutions, MXIGRAPH_IDX_KEEP));
+  } else {
+    IGRAPH_CHECK(igraph_vector_init(&params->resolutions, 0));
+  }
+
+  IGRAPH_FINALLY_CLEAN(3);
+
+  return IGRAPH_SUCCESS;
+}
 
 static igraph_error_t mxIgraph_optimal_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* UNUSED(opts),
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights,
+  mxIgraph_cluster_params_t const* UNUSED(params),
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
   IGRAPH_CHECK(
     igraph_community_optimal_modularity(graph, NULL, membership, weights));
@@ -47,78 +143,52 @@ static igraph_error_t mxIgraph_optimal_i(igraph_t const* graph,
 }
 
 static igraph_error_t mxIgraph_spinglass_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t const* params,
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
-  igraph_integer_t n_spins = mxIgraphIntegerFromOptions(opts, "nSpins");
-  igraph_bool_t parallel = mxIgraphBoolFromOptions(opts, "parallel");
-  igraph_real_t start_temp = mxIgraphRealFromOptions(opts, "tempStart");
-  igraph_real_t end_temp = mxIgraphRealFromOptions(opts, "tempEnd");
-  igraph_real_t cool_factor = mxIgraphRealFromOptions(opts, "coolingFactor");
-  char const* update_rule_str = mxIgraphStringFromOptions(opts, "updateRule");
-  igraph_real_t gamma = mxIgraphRealFromOptions(opts, "resolution");
-  igraph_real_t gamma_minus = mxIgraphRealFromOptions(opts, "negResolution");
-  MXIGRAPH_CHECK_STATUS();
-
-  igraph_spincomm_update_t update_rule;
   igraph_spinglass_implementation_t implementation =
-    igraph_vector_min(weights) < 0 ?
+    weights && (igraph_vector_min(weights) < 0) ?
       IGRAPH_SPINCOMM_IMP_NEG :
       IGRAPH_SPINCOMM_IMP_ORIG;
 
-  if (strcmp(update_rule_str, "simple") == 0) {
-    update_rule = IGRAPH_SPINCOMM_UPDATE_SIMPLE;
-  } else {
-    update_rule = IGRAPH_SPINCOMM_UPDATE_CONFIG;
-  }
-
   IGRAPH_CHECK(igraph_community_spinglass(graph, weights, NULL, NULL,
-    membership, NULL, n_spins, parallel, start_temp, end_temp, cool_factor,
-    update_rule, gamma, implementation, gamma_minus));
+    membership, NULL, params->n_spins, params->parallel, params->start_temp,
+    params->end_temp, params->cool_factor, params->update_rule,
+    params->resolution, implementation, params->neg_resolution));
 
   return IGRAPH_SUCCESS;
 }
 
 static igraph_error_t mxIgraph_leading_eigenvector_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t const* params,
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
-  igraph_integer_t steps = mxIgraphIntegerFromOptions(opts, "maxSteps");
-  MXIGRAPH_CHECK_STATUS();
-  igraph_vector_int_t init;
-
-  IGRAPH_CHECK(mxIgraphVectorIntFromOptions(opts, "initial", &init, true));
   for (igraph_integer_t i = 0; i < igraph_vcount(graph); i++) {
-    VECTOR(*membership)[i] = VECTOR(init)[i];
+    VECTOR(*membership)[i] = VECTOR(params->initial)[i];
   }
-  igraph_vector_int_destroy(&init);
 
   IGRAPH_CHECK(igraph_community_leading_eigenvector(graph, weights, NULL,
-    membership, steps, NULL, NULL, true, NULL, NULL, NULL, NULL, NULL));
+    membership, params->n_steps, NULL, NULL, true, NULL, NULL, NULL, NULL,
+    NULL));
 
   return IGRAPH_SUCCESS;
 }
 
 static igraph_error_t mxIgraph_walktrap_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t const* params,
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
-  igraph_integer_t steps = mxIgraphIntegerFromOptions(opts, "nSteps");
-  MXIGRAPH_CHECK_STATUS();
-
-  IGRAPH_CHECK(
-    igraph_community_walktrap(graph, weights, steps, NULL, NULL, membership));
+  IGRAPH_CHECK(igraph_community_walktrap(
+    graph, weights, params->n_steps, NULL, NULL, membership));
 
   return IGRAPH_SUCCESS;
 }
 
 static igraph_error_t mxIgraph_edge_betweenness_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights,
+  mxIgraph_cluster_params_t const* UNUSED(params),
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
-  igraph_bool_t isweighted = mxIgraphBoolFromOptions(opts, "isweighted");
-  MXIGRAPH_CHECK_STATUS();
-
   IGRAPH_CHECK(igraph_community_edge_betweenness(graph, NULL, NULL, NULL, NULL,
     NULL, membership, igraph_is_directed(graph), weights));
 
@@ -126,8 +196,9 @@ static igraph_error_t mxIgraph_edge_betweenness_i(igraph_t const* graph,
 }
 
 static igraph_error_t mxIgraph_fastgreedy_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* UNUSED(opts),
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights,
+  mxIgraph_cluster_params_t const* UNUSED(params),
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
   IGRAPH_CHECK(
     igraph_community_fastgreedy(graph, weights, NULL, NULL, membership));
@@ -136,41 +207,30 @@ static igraph_error_t mxIgraph_fastgreedy_i(igraph_t const* graph,
 }
 
 static igraph_error_t mxIgraph_multilevel_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t const* params,
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
-  igraph_real_t resolution = mxIgraphRealFromOptions(opts, "resolution");
-  MXIGRAPH_CHECK_STATUS();
-
   IGRAPH_CHECK(igraph_community_multilevel(
-    graph, weights, resolution, membership, NULL, NULL));
+    graph, weights, params->resolution, membership, NULL, NULL));
 
   return IGRAPH_SUCCESS;
 }
 
 static igraph_error_t mxIgraph_leiden_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t const* params,
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
-  igraph_real_t resolution = mxIgraphRealFromOptions(opts, "resolution");
-  igraph_real_t beta = mxIgraphRealFromOptions(opts, "randomness");
-  igraph_integer_t n_iterations =
-    mxIgraphIntegerFromOptions(opts, "nIterations");
-  igraph_bool_t use_modularity =
-    strcmp(mxIgraphStringFromOptions(opts, "metric"), "modularity") == 0;
-  MXIGRAPH_CHECK_STATUS();
-
+  igraph_bool_t const needs_strength =
+    params->use_modularity && (igraph_vector_size(&params->node_weights) == 0);
   igraph_vector_t node_weights;
-  igraph_vector_t* node_weights_ptr = NULL;
-  igraph_vector_int_t init;
+  igraph_vector_t const* node_weights_ptr =
+    params->use_modularity ? &params->node_weights : NULL;
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromOptions(opts, "initial", &init, true));
   for (igraph_integer_t i = 0; i < igraph_vcount(graph); i++) {
-    VECTOR(*membership)[i] = VECTOR(init)[i];
+    VECTOR(*membership)[i] = VECTOR(params->initial)[i];
   }
-  igraph_vector_int_destroy(&init);
 
-  if (use_modularity) {
+  if (needs_strength) {
     IGRAPH_CHECK(igraph_vector_init(&node_weights, igraph_vcount(graph)));
     IGRAPH_FINALLY(igraph_vector_destroy, &node_weights);
     IGRAPH_CHECK(igraph_strength(
@@ -179,9 +239,10 @@ static igraph_error_t mxIgraph_leiden_i(igraph_t const* graph,
   }
 
   IGRAPH_CHECK(igraph_community_leiden(graph, weights, node_weights_ptr,
-    resolution, beta, true, n_iterations, membership, NULL, NULL));
+    params->resolution, params->randomness, true, params->n_iterations,
+    membership, NULL, NULL));
 
-  if (use_modularity) {
+  if (needs_strength) {
     igraph_vector_destroy(&node_weights);
     IGRAPH_FINALLY_CLEAN(1);
   }
@@ -190,82 +251,534 @@ static igraph_error_t mxIgraph_leiden_i(igraph_t const* graph,
 }
 
 static igraph_error_t mxIgraph_fluid_communities_i(igraph_t const* graph,
-  igraph_vector_t const* UNUSED(weights), mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* UNUSED(weights),
+  mxIgraph_cluster_params_t const* params, igraph_vector_int_t* membership,
+  igraph_real_t* UNUSED(quality))
 {
-  igraph_integer_t n_communities =
-    mxIgraphIntegerFromOptions(opts, "nCommunities");
-  MXIGRAPH_CHECK_STATUS();
-
-  IGRAPH_CHECK(
-    igraph_community_fluid_communities(graph, n_communities, membership));
+  IGRAPH_CHECK(igraph_community_fluid_communities(
+    graph, params->n_communities, membership));
 
   return IGRAPH_SUCCESS;
 }
 
 static igraph_error_t mxIgraph_label_propagation_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t const* params,
+  igraph_vector_int_t* membership, igraph_real_t* UNUSED(quality))
 {
-  igraph_vector_int_t initial;
-  igraph_neimode_t mode = mxIgraphModeFromOptions(opts);
-  MXIGRAPH_CHECK_STATUS();
-  igraph_vector_bool_t fixed;
+  IGRAPH_CHECK(igraph_community_label_propagation(graph, membership,
+    params->mode, weights, &params->initial, &params->fixed));
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromOptions(opts, "initial", &initial, true));
-  IGRAPH_FINALLY(igraph_vector_int_destroy, &initial);
-  IGRAPH_CHECK(mxIgraphVectorBoolFromOptions(opts, "fixed", &fixed, false));
-  IGRAPH_FINALLY(igraph_vector_bool_destroy, &fixed);
+  return IGRAPH_SUCCESS;
+}
 
-  IGRAPH_CHECK(igraph_community_label_propagation(
-    graph, membership, mode, weights, &initial, &fixed));
+static igraph_error_t mxIgraph_infomap_i(igraph_t const* graph,
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t const* params,
+  igraph_vector_int_t* membership, igraph_real_t* quality)
+{
+  IGRAPH_CHECK(igraph_community_infomap(graph, weights, &params->node_weights,
+    params->n_trials, membership, quality));
 
-  igraph_vector_int_destroy(&initial);
-  igraph_vector_bool_destroy(&fixed);
-  IGRAPH_FINALLY_CLEAN(2);
+  return IGRAPH_SUCCESS;
+}
+
+/* Run a cluster method and, if score is set, rate the partition it found.
+ Infomap partitions are rated by their codelength (lower is better), all
+ others by their modularity (higher is better). */
+igraph_error_t mexIgraphClusterRun(mxIgraph_cluster_method_t const* method,
+  igraph_t const* graph, igraph_vector_t const* weights,
+  mxIgraph_cluster_params_t const* params, igraph_bool_t const score,
+  igraph_vector_int_t* membership, igraph_real_t* quality)
+{
+  IGRAPH_CHECK(method->fn(graph, weights, params, membership, quality));
+
+  if (score && (method->id != MXIGRAPH_CLUSTER_INFOMAP)) {
+    IGRAPH_CHECK(
+      igraph_modularity(graph, membership, weights, 1, true, quality));
+  }
 
   return IGRAPH_SUCCESS;
 }
 
-static igraph_error_t mxIgraph_infomap_i(igraph_t const* graph,
-  igraph_vector_t const* weights, mxArray const* opts,
-  igraph_vector_int_t* membership)
+static igraph_bool_t cluster_is_better_i(
+  mxIgraph_cluster_method_t const* method, igraph_real_t const quality,
+  igraph_real_t const other)
 {
-  igraph_integer_t n_trials = mxIgraphIntegerFromOptions(opts, "nTrials");
-  MXIGRAPH_CHECK_STATUS();
-  igraph_vector_t v_weights;
-  igraph_real_t codelength = 0;
+  return method->id == MXIGRAPH_CLUSTER_INFOMAP ? quality < other :
+                                                  quality > other;
+}
+
+/* State shared by the restarts of a multi-start call.
+
+ Every restart clusters the same converted graph. igraph graphs cache some
+ of their properties the first time they are asked for, so reading one
+ graph from several threads at once is not safe and each thread gets its
+ own copy. When only the best partition is wanted each thread keeps the
+ best partition it has seen and a workspace for the next restart, rather
+ than holding on to every restart's partition. */
+typedef struct {
+  mxIgraph_cluster_method_t method;
+  mxIgraph_cluster_params_t* params;
+  igraph_vector_t const* weights;
+  igraph_bool_t score;
+  igraph_integer_t n_threads;
+  igraph_integer_t n_copies;
+  igraph_integer_t n_memberships;
+  igraph_t const** graphs;
+  igraph_t* copies;
+  igraph_vector_int_t* memberships;
+  igraph_vector_int_t* best;
+  igraph_integer_t* best_start;
+  igraph_real_t* quality;
+} mxIgraph_cluster_starts_t;
+
+static void cluster_starts_destroy_i(mxIgraph_cluster_starts_t* starts)
+{
+  for (igraph_integer_t i = 0; i < starts->n_copies; i++) {
+    igraph_destroy(starts->copies + i);
+  }
+
+  for (igraph_integer_t i = 0; i < starts->n_memberships; i++) {
+    igraph_vector_int_destroy(starts->memberships + i);
+  }
+
+  if (!starts->params->return_all) {
+    for (igraph_integer_t i = 0; i < starts->n_memberships; i++) {
+      igraph_vector_int_destroy(starts->best + i);
+    }
+  }
+
+  mexIgraphClusterParamsDestroy(starts->params);
+  IGRAPH_FREE(starts->graphs);
+  IGRAPH_FREE(starts->copies);
+  IGRAPH_FREE(starts->memberships);
+  IGRAPH_FREE(starts->best);
+  IGRAPH_FREE(starts->best_start);
+  IGRAPH_FREE(starts->quality);
+}
+
+static igraph_error_t cluster_starts_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
+{
+  mxIgraph_cluster_starts_t* starts = data;
+  igraph_bool_t const return_all = starts->params->return_all;
+  igraph_vector_int_t* membership =
+    starts->memberships + (return_all ? task : thread);
+
+  IGRAPH_CHECK(mexIgraphClusterRun(&starts->method, starts->graphs[thread],
+    starts->weights, starts->params, starts->score, membership,
+    starts->quality + task));
+
+  /* Tasks on a thread run in increasing order so only strictly better
+     partitions replace the current best, keeping the earliest on ties. */
+  if (!return_all) {
+    igraph_integer_t const best = starts->best_start[thread];
+    if ((best < 0) || cluster_is_better_i(&starts->method,
+                        starts->quality[task], starts->quality[best])) {
+      igraph_vector_int_t tmp = starts->best[thread];
+      starts->best[thread] = *membership;
+      *membership = tmp;
+      starts->best_start[thread] = task;
+    }
+  }
 
-  IGRAPH_CHECK(mxIgraphVectorFromOptions(
-    opts, "nodeWeights", &v_weights, MXIGRAPH_IDX_KEEP));
-  IGRAPH_FINALLY(igraph_vector_destroy, &v_weights);
+  return IGRAPH_SUCCESS;
+}
 
-  IGRAPH_CHECK(igraph_community_infomap(
-    graph, weights, &v_weights, n_trials, membership, &codelength));
+/* Cluster one graph n_starts times, each restart with its own random number
+ stream, and return either the best partition and its quality or all of
+ them. Takes ownership of params. */
+static igraph_error_t cluster_starts_i(int nlhs, mxArray* plhs[],
+  mxIgraph_cluster_method_t const* method, igraph_t const* graph,
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t* params)
+{
+  igraph_integer_t const n_starts = params->n_starts;
+  igraph_integer_t const n_nodes = igraph_vcount(graph);
+  igraph_bool_t const return_all = params->return_all;
+  igraph_integer_t failed;
+  igraph_integer_t best = -1;
+  mxIgraph_cluster_starts_t starts = {
+    .method = *method,
+    .params = params,
+    .weights = weights,
+    .score = !return_all || (nlhs > 1),
+    .n_threads = mxIgraphThreadCount() < n_starts ? mxIgraphThreadCount() :
+                                                    n_starts,
+  };
+  igraph_integer_t const n_memberships =
+    return_all ? n_starts : starts.n_threads;
+
+  IGRAPH_FINALLY(cluster_starts_destroy_i, &starts);
+  starts.graphs = IGRAPH_CALLOC(starts.n_threads, igraph_t const*);
+  starts.copies = IGRAPH_CALLOC(starts.n_threads, igraph_t);
+  starts.memberships = IGRAPH_CALLOC(n_memberships, igraph_vector_int_t);
+  starts.best = IGRAPH_CALLOC(starts.n_threads, igraph_vector_int_t);
+  starts.best_start = IGRAPH_CALLOC(starts.n_threads, igraph_integer_t);
+  starts.quality = IGRAPH_CALLOC(n_starts, igraph_real_t);
+  IGRAPH_CHECK_OOM(starts.graphs, "Could not allocate restarts.");
+  IGRAPH_CHECK_OOM(starts.copies, "Could not allocate restarts.");
+  IGRAPH_CHECK_OOM(starts.memberships, "Could not allocate restarts.");
+  IGRAPH_CHECK_OOM(starts.best, "Could not allocate restarts.");
+  IGRAPH_CHECK_OOM(starts.best_start, "Could not allocate restarts.");
+  IGRAPH_CHECK_OOM(starts.quality, "Could not allocate restarts.");
+
+  starts.graphs[0] = graph;
+  for (igraph_integer_t i = 1; i < starts.n_threads; i++) {
+    IGRAPH_CHECK(igraph_copy(starts.copies + starts.n_copies, graph));
+    starts.graphs[i] = starts.copies + starts.n_copies;
+    starts.n_copies++;
+  }
+
+  for (igraph_integer_t i = 0; i < n_memberships; i++) {
+    IGRAPH_CHECK(igraph_vector_int_init(starts.memberships + i, n_nodes));
+    IGRAPH_FINALLY(igraph_vector_int_destroy, starts.memberships + i);
+    if (!return_all) {
+      IGRAPH_CHECK(igraph_vector_int_init(starts.best + i, n_nodes));
+      starts.best_start[i] = -1;
+    }
+    IGRAPH_FINALLY_CLEAN(1);
+    starts.n_memberships++;
+  }
 
-  igraph_vector_destroy(&v_weights);
   IGRAPH_FINALLY_CLEAN(1);
+  igraph_error_t const rs =
+    mxIgraphBatchRun(n_starts, cluster_starts_task_i, &starts, &failed);
+
+  if ((rs == IGRAPH_SUCCESS) && return_all) {
+    plhs[0] = mxCreateDoubleMatrix(n_starts, n_nodes, mxREAL);
+    double* memberships = mxGetDoubles(plhs[0]);
+    for (igraph_integer_t i = 0; i < n_starts; i++) {
+      for (igraph_integer_t j = 0; j < n_nodes; j++) {
+        memberships[i + (j * n_starts)] =
+          VECTOR(starts.memberships[i])[j] + 1;
+      }
+    }
+
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleMatrix(n_starts, 1, mxREAL);
+      double* quality = mxGetDoubles(plhs[1]);
+      for (igraph_integer_t i = 0; i < n_starts; i++) {
+        quality[i] = starts.quality[i];
+      }
+    }
+  } else if (rs == IGRAPH_SUCCESS) {
+    igraph_integer_t best_thread = -1;
+    for (igraph_integer_t i = 0; i < starts.n_threads; i++) {
+      igraph_integer_t const candidate = starts.best_start[i];
+      if ((candidate >= 0) &&
+          ((best < 0) ||
+            cluster_is_better_i(method, starts.quality[candidate],
+              starts.quality[best]) ||
+            ((starts.quality[candidate] == starts.quality[best]) &&
+              (candidate < best)))) {
+        best = candidate;
+        best_thread = i;
+      }
+    }
+
+    plhs[0] = mxIgraphVectorIntToArray(
+      starts.best + best_thread, MXIGRAPH_IDX_SHIFT);
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleScalar(starts.quality[best]);
+    }
+  }
+
+  cluster_starts_destroy_i(&starts);
+
+  if (rs != IGRAPH_SUCCESS) {
+    IGRAPH_ERRORF("Restart %" IGRAPH_PRId " failed. %s", rs, failed + 1,
+      mxIgraphBatchError());
+  }
 
   return IGRAPH_SUCCESS;
 }
 
-igraph_error_t mexIgraphCluster(
-  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+/* State shared by the steps of a resolution sweep. Each thread clusters its
+ own copy of the graph and has its own workspace membership. */
+typedef struct {
+  mxIgraph_cluster_method_t method;
+  mxIgraph_cluster_params_t* params;
+  igraph_vector_t const* weights;
+  igraph_bool_t warm_start;
+  igraph_integer_t n_threads;
+  igraph_integer_t n_copies;
+  igraph_integer_t n_work;
+  igraph_t const** graphs;
+  igraph_t* copies;
+  igraph_vector_int_t* work;
+  igraph_matrix_int_t memberships;
+  igraph_vector_t quality;
+  igraph_vector_int_t n_comms;
+} mxIgraph_cluster_sweep_t;
+
+static void cluster_sweep_destroy_i(mxIgraph_cluster_sweep_t* sweep)
 {
-  VERIFY_N_INPUTS_EQUAL(4);
-  VERIFY_N_OUTPUTS_EQUAL(1);
+  for (igraph_integer_t i = 0; i < sweep->n_copies; i++) {
+    igraph_destroy(sweep->copies + i);
+  }
 
-  mxArray const* graph_options = prhs[2];
-  mxArray const* method_options = prhs[3];
-  mxIgraph_cluster_t method;
-  igraph_t graph;
-  igraph_vector_t weights;
-  igraph_vector_int_t membership;
-  typedef igraph_error_t (*cluster_method_t)(igraph_t const*,
-    igraph_vector_t const*, mxArray const*, igraph_vector_int_t*);
-  cluster_method_t cluster_method;
+  for (igraph_integer_t i = 0; i < sweep->n_work; i++) {
+    igraph_vector_int_destroy(sweep->work + i);
+  }
+
+  mexIgraphClusterParamsDestroy(sweep->params);
+  igraph_matrix_int_destroy(&sweep->memberships);
+  igraph_vector_destroy(&sweep->quality);
+  igraph_vector_int_destroy(&sweep->n_comms);
+  IGRAPH_FREE(sweep->graphs);
+  IGRAPH_FREE(sweep->copies);
+  IGRAPH_FREE(sweep->work);
+}
+
+/* Cluster at one resolution. With warm starts, Leiden starts from the
+ partition found at the previous resolution, which is still in the
+ thread's workspace. Leiden copies the initial partition into the output
+ before starting so sharing the vector is safe. */
+static igraph_error_t cluster_sweep_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
+{
+  mxIgraph_cluster_sweep_t* sweep = data;
+  igraph_vector_int_t* membership = sweep->work + thread;
+  mxIgraph_cluster_params_t step = *sweep->params;
+  igraph_integer_t n_comms = 0;
+
+  step.resolution = VECTOR(sweep->params->resolutions)[task];
+  if (sweep->warm_start && (task > 0)) {
+    step.initial = *membership;
+  }
+
+  IGRAPH_CHECK(mexIgraphClusterRun(&sweep->method, sweep->graphs[thread],
+    sweep->weights, &step, true, membership,
+    &VECTOR(sweep->quality)[task]));
+
+  for (igraph_integer_t i = 0; i < igraph_vector_int_size(membership); i++) {
+    MATRIX(sweep->memberships, task, i) = VECTOR(*membership)[i];
+    if (VECTOR(*membership)[i] >= n_comms) {
+      n_comms = VECTOR(*membership)[i] + 1;
+    }
+  }
+  VECTOR(sweep->n_comms)[task] = n_comms;
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Cluster one graph at each value of the resolution option, returning the
+ memberships, qualities and number of communities at every resolution.
+
+ The graph is converted and, for Leiden with the modularity metric, node
+ strengths are computed once for the whole sweep. Sequential sweeps run on
+ the calling thread and warm start Leiden from the previous resolution's
+ partition. Parallel sweeps cluster every resolution independently on the
+ thread pool, each with its own random number stream, so their results
+ do not depend on the number of threads. Takes ownership of params. */
+static igraph_error_t cluster_sweep_i(int nlhs, mxArray* plhs[],
+  mxIgraph_cluster_method_t const* method, igraph_t const* graph,
+  igraph_vector_t const* weights, mxIgraph_cluster_params_t* params)
+{
+  igraph_integer_t const n_res = igraph_vector_size(&params->resolutions);
+  igraph_integer_t const n_nodes = igraph_vcount(graph);
+  igraph_integer_t failed;
+  igraph_error_t rs = IGRAPH_SUCCESS;
+  mxIgraph_cluster_sweep_t sweep = {
+    .method = *method,
+    .params = params,
+    .weights = weights,
+    .warm_start = !params->parallel_sweep,
+    .n_threads = 1,
+  };
+
+  if (params->parallel_sweep) {
+    sweep.n_threads =
+      mxIgraphThreadCount() < n_res ? mxIgraphThreadCount() : n_res;
+  }
+
+  IGRAPH_FINALLY(mexIgraphClusterParamsDestroy, params);
+  IGRAPH_CHECK(igraph_matrix_int_init(&sweep.memberships, n_res, n_nodes));
+  IGRAPH_FINALLY(igraph_matrix_int_destroy, &sweep.memberships);
+  IGRAPH_VECTOR_INIT_FINALLY(&sweep.quality, n_res);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&sweep.n_comms, n_res);
+  IGRAPH_FINALLY_CLEAN(4);
+
+  IGRAPH_FINALLY(cluster_sweep_destroy_i, &sweep);
+  sweep.graphs = IGRAPH_CALLOC(sweep.n_threads, igraph_t const*);
+  sweep.copies = IGRAPH_CALLOC(sweep.n_threads, igraph_t);
+  sweep.work = IGRAPH_CALLOC(sweep.n_threads, igraph_vector_int_t);
+  IGRAPH_CHECK_OOM(sweep.graphs, "Could not allocate sweep.");
+  IGRAPH_CHECK_OOM(sweep.copies, "Could not allocate sweep.");
+  IGRAPH_CHECK_OOM(sweep.work, "Could not allocate sweep.");
+
+  if ((method->id == MXIGRAPH_CLUSTER_LEIDEN) && params->use_modularity) {
+    IGRAPH_CHECK(igraph_vector_resize(&params->node_weights, n_nodes));
+    IGRAPH_CHECK(igraph_strength(graph, &params->node_weights,
+      igraph_vss_all(), IGRAPH_ALL, true, weights));
+  }
+
+  sweep.graphs[0] = graph;
+  for (igraph_integer_t i = 1; i < sweep.n_threads; i++) {
+    IGRAPH_CHECK(igraph_copy(sweep.copies + sweep.n_copies, graph));
+    sweep.graphs[i] = sweep.copies + sweep.n_copies;
+    sweep.n_copies++;
+  }
+
+  for (igraph_integer_t i = 0; i < sweep.n_threads; i++) {
+    IGRAPH_CHECK(igraph_vector_int_init(sweep.work + i, n_nodes));
+    sweep.n_work++;
+  }
+
+  if (params->parallel_sweep) {
+    IGRAPH_FINALLY_CLEAN(1);
+    rs = mxIgraphBatchRun(n_res, cluster_sweep_task_i, &sweep, &failed);
+    IGRAPH_FINALLY(cluster_sweep_destroy_i, &sweep);
+  } else {
+    for (igraph_integer_t i = 0; i < n_res; i++) {
+      IGRAPH_CHECK(cluster_sweep_task_i(i, 0, &sweep));
+    }
+  }
+
+  if (rs != IGRAPH_SUCCESS) {
+    IGRAPH_ERRORF("Failed to cluster at resolution %g. %s", rs,
+      VECTOR(params->resolutions)[failed], mxIgraphBatchError());
+  }
+
+  plhs[0] = mxIgraphMatrixIntToArray(&sweep.memberships, MXIGRAPH_IDX_SHIFT);
+  if (nlhs > 1) {
+    plhs[1] = mxCreateDoubleMatrix(n_res, 1, mxREAL);
+    double* quality = mxGetDoubles(plhs[1]);
+    for (igraph_integer_t i = 0; i < n_res; i++) {
+      quality[i] = VECTOR(sweep.quality)[i];
+    }
+  }
+
+  if (nlhs > 2) {
+    plhs[2] = mxCreateDoubleMatrix(n_res, 1, mxREAL);
+    double* n_comms = mxGetDoubles(plhs[2]);
+    for (igraph_integer_t i = 0; i < n_res; i++) {
+      n_comms[i] = VECTOR(sweep.n_comms)[i];
+    }
+  }
+
+  cluster_sweep_destroy_i(&sweep);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  return IGRAPH_SUCCESS;
+}
+
+/* State shared by the tasks of a batched call. Only the first n_ready
+ entries of each array have been initialized. */
+typedef struct {
+  mxIgraph_cluster_method_t method;
+  igraph_bool_t score;
+  igraph_integer_t n_ready;
+  igraph_t* graphs;
+  igraph_vector_t* weights;
+  mxIgraph_cluster_params_t* params;
+  igraph_vector_int_t* memberships;
+  igraph_real_t* quality;
+} mxIgraph_cluster_batch_t;
+
+static void cluster_batch_destroy_i(mxIgraph_cluster_batch_t* batch)
+{
+  for (igraph_integer_t i = 0; i < batch->n_ready; i++) {
+    igraph_destroy(batch->graphs + i);
+    igraph_vector_destroy(batch->weights + i);
+    mexIgraphClusterParamsDestroy(batch->params + i);
+    igraph_vector_int_destroy(batch->memberships + i);
+  }
+
+  IGRAPH_FREE(batch->graphs);
+  IGRAPH_FREE(batch->weights);
+  IGRAPH_FREE(batch->params);
+  IGRAPH_FREE(batch->memberships);
+  IGRAPH_FREE(batch->quality);
+}
 
-  char const* methods[MXIGRAPH_CLUSTER_N] = {
+static igraph_error_t cluster_batch_task_i(igraph_integer_t task,
+  igraph_integer_t UNUSED(thread), void* data)
+{
+  mxIgraph_cluster_batch_t* batch = data;
+
+  return mexIgraphClusterRun(&batch->method, batch->graphs + task,
+    MXIGRAPH_WEIGHTS(batch->weights + task), batch->params + task,
+    batch->score, batch->memberships + task, batch->quality + task);
+}
+
+/* Cluster each graph in a cell array. Graph and method options are cell
+ arrays with one options struct per graph so defaults that depend on the
+ graph can differ between graphs. */
+static igraph_error_t cluster_batch_i(int nlhs, mxArray* plhs[],
+  mxArray const* graphs, mxIgraph_cluster_method_t const* method,
+  mxArray const* graph_options, mxArray const* method_options)
+{
+  igraph_integer_t const n_graphs = mxGetNumberOfElements(graphs);
+  igraph_integer_t failed;
+  mxIgraph_cluster_batch_t batch = { .method = *method, .score = nlhs > 1 };
+
+  batch.graphs = IGRAPH_CALLOC(n_graphs, igraph_t);
+  batch.weights = IGRAPH_CALLOC(n_graphs, igraph_vector_t);
+  batch.params = IGRAPH_CALLOC(n_graphs, mxIgraph_cluster_params_t);
+  batch.memberships = IGRAPH_CALLOC(n_graphs, igraph_vector_int_t);
+  batch.quality = IGRAPH_CALLOC(n_graphs, igraph_real_t);
+  IGRAPH_FINALLY(cluster_batch_destroy_i, &batch);
+  IGRAPH_CHECK_OOM(batch.graphs, "Could not allocate batch.");
+  IGRAPH_CHECK_OOM(batch.weights, "Could not allocate batch.");
+  IGRAPH_CHECK_OOM(batch.params, "Could not allocate batch.");
+  IGRAPH_CHECK_OOM(batch.memberships, "Could not allocate batch.");
+  IGRAPH_CHECK_OOM(batch.quality, "Could not allocate batch.");
+
+  for (igraph_integer_t i = 0; i < n_graphs; i++) {
+    igraph_t* graph = batch.graphs + i;
+    igraph_vector_t* weights = batch.weights + i;
+    mxIgraph_cluster_params_t* params = batch.params + i;
+
+    IGRAPH_CHECK(mxIgraphFromArray(mxGetCell(graphs, i), graph, weights,
+      mxGetCell(graph_options, i)));
+    IGRAPH_FINALLY(igraph_destroy, graph);
+    IGRAPH_FINALLY(igraph_vector_destroy, weights);
+
+    IGRAPH_CHECK(mexIgraphClusterParams(
+      method->id, mxGetCell(method_options, i), params));
+    IGRAPH_FINALLY(mexIgraphClusterParamsDestroy, params);
+
+    IGRAPH_CHECK(
+      igraph_vector_int_init(batch.memberships + i, igraph_vcount(graph)));
+
+    IGRAPH_FINALLY_CLEAN(3);
+    batch.n_ready++;
+  }
+
+  IGRAPH_FINALLY_CLEAN(1);
+  igraph_error_t const rs =
+    mxIgraphBatchRun(n_graphs, cluster_batch_task_i, &batch, &failed);
+
+  if (rs == IGRAPH_SUCCESS) {
+    plhs[0] = mxCreateCellMatrix(1, n_graphs);
+    for (igraph_integer_t i = 0; i < n_graphs; i++) {
+      mxSetCell(plhs[0], i,
+        mxIgraphVectorIntToArray(batch.memberships + i, MXIGRAPH_IDX_SHIFT));
+    }
+
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleMatrix(1, n_graphs, mxREAL);
+      double* quality = mxGetDoubles(plhs[1]);
+      for (igraph_integer_t i = 0; i < n_graphs; i++) {
+        quality[i] = batch.quality[i];
+      }
+    }
+  }
+
+  cluster_batch_destroy_i(&batch);
+
+  if (rs != IGRAPH_SUCCESS) {
+    IGRAPH_ERRORF("Failed to cluster graph %" IGRAPH_PRId ". %s", rs,
+      failed + 1, mxIgraphBatchError());
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+igraph_error_t mexIgraphClusterSelectMethod(
+  mxArray const* name, mxIgraph_cluster_method_t* method)
+{
+  static char const* const methods[MXIGRAPH_CLUSTER_N] = {
     [MXIGRAPH_CLUSTER_OPTIMAL] = "optimal",
     [MXIGRAPH_CLUSTER_SPINGLASS] = "spinglass",
     [MXIGRAPH_CLUSTER_LEADINGEIGENVECTOR] = "leadingeigenvector",
@@ -279,10 +792,10 @@ igraph_error_t mexIgraphCluster(
     [MXIGRAPH_CLUSTER_INFOMAP] = "infomap",
   };
 
-  method = mxIgraphSelectMethod(prhs[1], methods, MXIGRAPH_CLUSTER_N);
-  MXIGRAPH_CHECK_METHOD(method, prhs[1]);
+  method->id = mxIgraphSelectMethod(name, methods, MXIGRAPH_CLUSTER_N);
+  MXIGRAPH_CHECK_METHOD(method->id, name);
 
-  cluster_method_t method_table[MXIGRAPH_CLUSTER_N] = {
+  mxIgraph_cluster_fn_t method_table[MXIGRAPH_CLUSTER_N] = {
     [MXIGRAPH_CLUSTER_OPTIMAL] = mxIgraph_optimal_i,
     [MXIGRAPH_CLUSTER_SPINGLASS] = mxIgraph_spinglass_i,
     [MXIGRAPH_CLUSTER_LEADINGEIGENVECTOR] = mxIgraph_leading_eigenvector_i,
@@ -296,27 +809,68 @@ igraph_error_t mexIgraphCluster(
     [MXIGRAPH_CLUSTER_INFOMAP] = mxIgraph_infomap_i
   };
 
-  cluster_method = method_table[method];
-  if (!cluster_method) {
+  method->fn = method_table[method->id];
+  if (!method->fn) {
     IGRAPH_ERRORF("Cluster method \"%s\" not implemented.",
-      IGRAPH_UNIMPLEMENTED, mxArrayToString(prhs[1]));
+      IGRAPH_UNIMPLEMENTED, mxArrayToString(name));
   }
 
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &graph, &weights, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph);
-  IGRAPH_FINALLY(igraph_vector_destroy, &weights);
+  return IGRAPH_SUCCESS;
+}
 
-  IGRAPH_CHECK(igraph_vector_int_init(&membership, igraph_vcount(&graph)));
+igraph_error_t mexIgraphCluster(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(4);
+  VERIFY_N_OUTPUTS_ATMOST(3);
+
+  mxArray const* graph_options = prhs[2];
+  mxArray const* method_options = prhs[3];
+  mxIgraph_cluster_method_t method;
+  igraph_t const* graph;
+  igraph_vector_t const* weights;
+  igraph_vector_int_t membership;
+  mxIgraph_cluster_params_t params;
+  igraph_real_t quality = IGRAPH_NAN;
+
+  IGRAPH_CHECK(mexIgraphClusterSelectMethod(prhs[1], &method));
+
+  if (mxIsCell(prhs[0])) {
+    return cluster_batch_i(
+      nlhs, plhs, prhs[0], &method, graph_options, method_options);
+  }
+
+  IGRAPH_CHECK(
+    mxIgraphFromArrayCached(prhs[0], &graph, &weights, graph_options));
+
+  IGRAPH_CHECK(mexIgraphClusterParams(method.id, method_options, &params));
+  IGRAPH_FINALLY(mexIgraphClusterParamsDestroy, &params);
+
+  if (igraph_vector_size(&params.resolutions) > 1) {
+    IGRAPH_FINALLY_CLEAN(1);
+    return cluster_sweep_i(
+      nlhs, plhs, &method, graph, MXIGRAPH_WEIGHTS(weights), &params);
+  }
+
+  if (params.n_starts > 1) {
+    IGRAPH_FINALLY_CLEAN(1);
+    return cluster_starts_i(
+      nlhs, plhs, &method, graph, MXIGRAPH_WEIGHTS(weights), &params);
+  }
+
+  IGRAPH_CHECK(igraph_vector_int_init(&membership, igraph_vcount(graph)));
   IGRAPH_FINALLY(igraph_vector_int_destroy, &membership);
 
-  IGRAPH_CHECK(cluster_method(
-    &graph, MXIGRAPH_WEIGHTS(&weights), method_options, &membership));
-  igraph_destroy(&graph);
-  igraph_vector_destroy(&weights);
+  IGRAPH_CHECK(mexIgraphClusterRun(&method, graph, MXIGRAPH_WEIGHTS(weights),
+    &params, nlhs > 1, &membership, &quality));
 
   plhs[0] = mxIgraphVectorIntToArray(&membership, MXIGRAPH_IDX_SHIFT);
+  if (nlhs > 1) {
+    plhs[1] = mxCreateDoubleScalar(quality);
+  }
   igraph_vector_int_destroy(&membership);
-  IGRAPH_FINALLY_CLEAN(3);
+  mexIgraphClusterParamsDestroy(&params);
+  IGRAPH_FINALLY_CLEAN(2);
 
   return IGRAPH_SUCCESS;
 }
@@ -0,0 +1,93 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEXIGRAPHCLUSTER_H
+#define MEXIGRAPHCLUSTER_H
+
+#include <mxIgraph.h>
+
+/* Cluster methods shared with other dispatcher functions that run community
+ detection as part of their work. */
+
+typedef enum {
+  MXIGRAPH_CLUSTER_OPTIMAL = 0,
+  MXIGRAPH_CLUSTER_SPINGLASS,
+  MXIGRAPH_CLUSTER_LEADINGEIGENVECTOR,
+  MXIGRAPH_CLUSTER_WALKTRAP,
+  MXIGRAPH_CLUSTER_EDGEBETWEENNESS,
+  MXIGRAPH_CLUSTER_FASTGREEDY,
+  MXIGRAPH_CLUSTER_MULTILEVEL,
+  MXIGRAPH_CLUSTER_LEIDEN,
+  MXIGRAPH_CLUSTER_FLUIDCOMMUNITIES,
+  MXIGRAPH_CLUSTER_LABELPROPAGATION,
+  MXIGRAPH_CLUSTER_INFOMAP,
+  MXIGRAPH_CLUSTER_N
+} mxIgraph_cluster_t;
+
+/* Method options read on the main thread so the methods themselves never
+ call into MATLAB and can run on worker threads. Vectors not used by the
+ method are left empty, except Leiden with the modularity metric uses
+ node_weights as precomputed node strengths when it is set.
+
+ Multilevel and Leiden read every value of the resolution option into
+ resolutions and the first into resolution. */
+typedef struct {
+  igraph_integer_t n_spins;
+  igraph_bool_t parallel;
+  igraph_real_t start_temp;
+  igraph_real_t end_temp;
+  igraph_real_t cool_factor;
+  igraph_spincomm_update_t update_rule;
+  igraph_real_t resolution;
+  igraph_real_t neg_resolution;
+  igraph_real_t randomness;
+  igraph_integer_t n_steps;
+  igraph_integer_t n_iterations;
+  igraph_bool_t use_modularity;
+  igraph_integer_t n_communities;
+  igraph_neimode_t mode;
+  igraph_integer_t n_trials;
+  igraph_integer_t n_starts;
+  igraph_bool_t return_all;
+  igraph_bool_t parallel_sweep;
+  igraph_vector_int_t initial;
+  igraph_vector_bool_t fixed;
+  igraph_vector_t node_weights;
+  igraph_vector_t resolutions;
+} mxIgraph_cluster_params_t;
+
+typedef igraph_error_t (*mxIgraph_cluster_fn_t)(igraph_t const*,
+  igraph_vector_t const*, mxIgraph_cluster_params_t const*,
+  igraph_vector_int_t*, igraph_real_t*);
+
+typedef struct {
+  mxIgraph_cluster_t id;
+  mxIgraph_cluster_fn_t fn;
+} mxIgraph_cluster_method_t;
+
+igraph_error_t mexIgraphClusterSelectMethod(
+  mxArray const* name, mxIgraph_cluster_method_t* method);
+igraph_error_t mexIgraphClusterParams(mxIgraph_cluster_t const method,
+  mxArray const* opts, mxIgraph_cluster_params_t* params);
+void mexIgraphClusterParamsDestroy(mxIgraph_cluster_params_t* params);
+igraph_error_t mexIgraphClusterRun(mxIgraph_cluster_method_t const* method,
+  igraph_t const* graph, igraph_vector_t const* weights,
+  mxIgraph_cluster_params_t const* params, igraph_bool_t const score,
+  igraph_vector_int_t* membership, igraph_real_t* quality);
+
+#endif
@@ -18,9 +18,24 @@
 
 #include "utils.h"
 
+#include <math.h>
 #include <mxIgraph.h>
 #include <string.h>
 
+/* Number of partition pairs compared per task. */
+#define PAIRWISE_CHUNK_SIZE 1024
+
+static char const* const compare_methods_i[] = {
+  [IGRAPH_COMMCMP_VI] = "vi",
+  [IGRAPH_COMMCMP_NMI] = "nmi",
+  [IGRAPH_COMMCMP_RAND] = "rand",
+  [IGRAPH_COMMCMP_SPLIT_JOIN] = "split_join",
+  [IGRAPH_COMMCMP_ADJUSTED_RAND] = "adjusted_rand",
+};
+
+static igraph_integer_t const compare_n_methods_i =
+  sizeof(compare_methods_i) / sizeof(*compare_methods_i);
+
 igraph_error_t mexIgraphCompare(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
 {
@@ -33,13 +48,8 @@ igraph_error_t mexIgraphCompare(
   igraph_community_comparison_t method;
   igraph_real_t res;
 
-  char const* methods[] = { [IGRAPH_COMMCMP_VI] = "vi",
-    [IGRAPH_COMMCMP_NMI] = "nmi",
-    [IGRAPH_COMMCMP_RAND] = "rand",
-    [IGRAPH_COMMCMP_SPLIT_JOIN] = "split_join",
-    [IGRAPH_COMMCMP_ADJUSTED_RAND] = "adjusted_rand" };
-  igraph_integer_t n_methods = sizeof(methods) / sizeof(*methods);
-  method = mxIgraphSelectMethod(method_name, methods, n_methods);
+  method = mxIgraphSelectMethod(
+    method_name, compare_methods_i, compare_n_methods_i);
   MXIGRAPH_CHECK_METHOD(method, method_name);
 
   IGRAPH_CHECK(
@@ -61,3 +71,423 @@ igraph_error_t mexIgraphCompare(
 
   return IGRAPH_SUCCESS;
 }
+
+/* State for comparing many partitions at once.
+
+ Partitions are stored one per column, the first n_rows being compared
+ against either each other (all pairs) or the remaining n_cols. Every
+ partition is reindexed once and its nodes grouped by community, so the
+ contingency table of a pair can be built by walking the communities of the
+ first partition and counting which communities of the second partition
+ their nodes fall in. Only the non-zero cells of the table are visited and
+ every score is accumulated from the same pass.
+
+ Communities of all partitions share one set of offsets: the communities of
+ partition p start at comm_offsets[p] and community c spans
+ comm_nodes[comm_starts[comm_offsets[p] + c]] up to the start of the next
+ community. */
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_integer_t n_rows;
+  igraph_integer_t n_cols;
+  igraph_bool_t all_pairs;
+  igraph_integer_t n_pairs;
+  igraph_integer_t n_tasks;
+  igraph_vector_int_t methods;
+  igraph_integer_t n_methods;
+
+  igraph_matrix_int_t parts;
+  igraph_vector_int_t comm_offsets;
+  igraph_vector_int_t comm_starts;
+  igraph_vector_int_t comm_nodes;
+  igraph_vector_t entropy;
+  igraph_vector_t same_pairs;
+
+  igraph_integer_t max_comms;
+  igraph_vector_int_t counts;
+  igraph_vector_int_t col_max;
+  igraph_vector_int_t touched;
+
+  igraph_vector_t scores;
+} mxIgraph_pairwise_t;
+
+static void pairwise_destroy_i(mxIgraph_pairwise_t* cmp)
+{
+  igraph_vector_int_destroy(&cmp->methods);
+  igraph_matrix_int_destroy(&cmp->parts);
+  igraph_vector_int_destroy(&cmp->comm_offsets);
+  igraph_vector_int_destroy(&cmp->comm_starts);
+  igraph_vector_int_destroy(&cmp->comm_nodes);
+  igraph_vector_destroy(&cmp->entropy);
+  igraph_vector_destroy(&cmp->same_pairs);
+  igraph_vector_int_destroy(&cmp->counts);
+  igraph_vector_int_destroy(&cmp->col_max);
+  igraph_vector_int_destroy(&cmp->touched);
+  igraph_vector_destroy(&cmp->scores);
+}
+
+static igraph_error_t pairwise_methods_i(
+  mxIgraph_pairwise_t* cmp, mxArray const* method_names)
+{
+  igraph_bool_t needs_rand = false;
+  igraph_integer_t method;
+
+  cmp->n_methods = mxGetNumberOfElements(method_names);
+  IGRAPH_CHECK(igraph_vector_int_resize(&cmp->methods, cmp->n_methods));
+
+  for (igraph_integer_t i = 0; i < cmp->n_methods; i++) {
+    mxArray const* name = mxGetCell(method_names, i);
+    method =
+      mxIgraphSelectMethod(name, compare_methods_i, compare_n_methods_i);
+    MXIGRAPH_CHECK_METHOD(method, name);
+
+    VECTOR(cmp->methods)[i] = method;
+    needs_rand |= (method == IGRAPH_COMMCMP_RAND) ||
+                  (method == IGRAPH_COMMCMP_ADJUSTED_RAND);
+  }
+
+  if (needs_rand && (cmp->n_nodes < 2)) {
+    IGRAPH_ERROR("Rand indices are not defined for fewer than two nodes.",
+      IGRAPH_EINVAL);
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Reindex every partition and group its nodes by community. */
+static igraph_error_t pairwise_index_i(mxIgraph_pairwise_t* cmp)
+{
+  igraph_integer_t const n_parts = igraph_matrix_int_ncol(&cmp->parts);
+  igraph_integer_t const n_nodes = cmp->n_nodes;
+  igraph_real_t const n = n_nodes;
+  igraph_vector_int_t part;
+  igraph_integer_t n_comms;
+  igraph_integer_t offset = 0;
+  igraph_integer_t* starts;
+  igraph_integer_t* nodes;
+
+  IGRAPH_CHECK(igraph_vector_int_resize(&cmp->comm_offsets, n_parts + 1));
+  IGRAPH_CHECK(igraph_vector_int_resize(&cmp->comm_nodes, n_parts * n_nodes));
+  IGRAPH_CHECK(igraph_vector_resize(&cmp->entropy, n_parts));
+  IGRAPH_CHECK(igraph_vector_resize(&cmp->same_pairs, n_parts));
+
+  cmp->max_comms = 0;
+  for (igraph_integer_t p = 0; p < n_parts; p++) {
+    igraph_vector_int_view(&part, &MATRIX(cmp->parts, 0, p), n_nodes);
+    IGRAPH_CHECK(igraph_reindex_membership(&part, NULL, &n_comms));
+
+    VECTOR(cmp->comm_offsets)[p] = offset;
+    offset += n_comms;
+    if (n_comms > cmp->max_comms) {
+      cmp->max_comms = n_comms;
+    }
+  }
+  VECTOR(cmp->comm_offsets)[n_parts] = offset;
+
+  IGRAPH_CHECK(igraph_vector_int_resize(&cmp->comm_starts, offset + 1));
+  igraph_vector_int_null(&cmp->comm_starts);
+  starts = VECTOR(cmp->comm_starts);
+  nodes = VECTOR(cmp->comm_nodes);
+
+  for (igraph_integer_t p = 0; p < n_parts; p++) {
+    igraph_integer_t const* memb = &MATRIX(cmp->parts, 0, p);
+    igraph_integer_t const first = VECTOR(cmp->comm_offsets)[p];
+    igraph_integer_t const last = VECTOR(cmp->comm_offsets)[p + 1];
+    igraph_real_t entropy = 0;
+    igraph_real_t same_pairs = 0;
+
+    for (igraph_integer_t i = 0; i < n_nodes; i++) {
+      starts[first + memb[i] + 1]++;
+    }
+
+    for (igraph_integer_t c = first; c < last; c++) {
+      igraph_real_t const size = starts[c + 1];
+      entropy -= (size / n) * log(size / n);
+      same_pairs += size * (size - 1);
+    }
+    VECTOR(cmp->entropy)[p] = entropy;
+    VECTOR(cmp->same_pairs)[p] = same_pairs;
+
+    starts[first] = p * n_nodes;
+    for (igraph_integer_t c = first; c < last; c++) {
+      starts[c + 1] += starts[c];
+    }
+
+    for (igraph_integer_t i = 0; i < n_nodes; i++) {
+      nodes[starts[first + memb[i]]++] = i;
+    }
+
+    /* Filling shifted every start to the next community's start. */
+    for (igraph_integer_t c = last; c > first; c--) {
+      starts[c] = starts[c - 1];
+    }
+    starts[first] = p * n_nodes;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t pairwise_init_i(mxIgraph_pairwise_t* cmp,
+  mxArray const* memberships, mxArray const* others,
+  mxArray const* method_names)
+{
+  igraph_matrix_int_t second;
+  igraph_integer_t n_threads;
+
+  IGRAPH_CHECK(
+    mxIgraphMatrixIntFromArray(memberships, &cmp->parts, MXIGRAPH_IDX_SHIFT));
+  IGRAPH_FINALLY(igraph_matrix_int_destroy, &cmp->parts);
+
+  cmp->n_nodes = igraph_matrix_int_nrow(&cmp->parts);
+  cmp->n_rows = igraph_matrix_int_ncol(&cmp->parts);
+  cmp->all_pairs = mxIsEmpty(others);
+
+  if (cmp->all_pairs) {
+    cmp->n_cols = cmp->n_rows;
+    cmp->n_pairs = (cmp->n_rows * (cmp->n_rows + 1)) / 2;
+  } else {
+    IGRAPH_CHECK(
+      mxIgraphMatrixIntFromArray(others, &second, MXIGRAPH_IDX_SHIFT));
+    IGRAPH_FINALLY(igraph_matrix_int_destroy, &second);
+
+    if (igraph_matrix_int_nrow(&second) != cmp->n_nodes) {
+      IGRAPH_ERROR("Partitions must all have the same number of nodes.",
+        IGRAPH_EINVAL);
+    }
+
+    cmp->n_cols = igraph_matrix_int_ncol(&second);
+    cmp->n_pairs = cmp->n_rows * cmp->n_cols;
+    IGRAPH_CHECK(igraph_matrix_int_resize(
+      &cmp->parts, cmp->n_nodes, cmp->n_rows + cmp->n_cols));
+    memcpy(&MATRIX(cmp->parts, 0, cmp->n_rows), VECTOR(second.data),
+      sizeof(igraph_integer_t) * cmp->n_nodes * cmp->n_cols);
+
+    igraph_matrix_int_destroy(&second);
+    IGRAPH_FINALLY_CLEAN(1);
+  }
+
+  cmp->n_tasks =
+    (cmp->n_pairs + PAIRWISE_CHUNK_SIZE - 1) / PAIRWISE_CHUNK_SIZE;
+  n_threads = mxIgraphThreadCount() < cmp->n_tasks ? mxIgraphThreadCount() :
+                                                     cmp->n_tasks;
+
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cmp->methods, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cmp->comm_offsets, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cmp->comm_starts, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cmp->comm_nodes, 0);
+  IGRAPH_VECTOR_INIT_FINALLY(&cmp->entropy, 0);
+  IGRAPH_VECTOR_INIT_FINALLY(&cmp->same_pairs, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cmp->counts, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cmp->col_max, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cmp->touched, 0);
+  IGRAPH_VECTOR_INIT_FINALLY(&cmp->scores, 0);
+
+  IGRAPH_CHECK(pairwise_methods_i(cmp, method_names));
+
+  IGRAPH_CHECK(pairwise_index_i(cmp));
+
+  IGRAPH_CHECK(
+    igraph_vector_int_resize(&cmp->counts, n_threads * cmp->max_comms));
+  IGRAPH_CHECK(
+    igraph_vector_int_resize(&cmp->col_max, n_threads * cmp->max_comms));
+  IGRAPH_CHECK(
+    igraph_vector_int_resize(&cmp->touched, n_threads * cmp->max_comms));
+  igraph_vector_int_null(&cmp->counts);
+  igraph_vector_int_null(&cmp->col_max);
+  IGRAPH_CHECK(igraph_vector_resize(
+    &cmp->scores, cmp->n_methods * cmp->n_rows * cmp->n_cols));
+
+  IGRAPH_FINALLY_CLEAN(11);
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Score partition a against partition b with every requested method.
+
+ Walks the non-zero cells of the pair's contingency table once. Formulas
+ match igraph_compare_communities. */
+static void pairwise_score_i(mxIgraph_pairwise_t* cmp, igraph_integer_t a,
+  igraph_integer_t b, igraph_integer_t thread, igraph_real_t* res,
+  igraph_integer_t stride)
+{
+  igraph_integer_t const n_nodes = cmp->n_nodes;
+  igraph_real_t const n = n_nodes;
+  igraph_integer_t const* starts = VECTOR(cmp->comm_starts);
+  igraph_integer_t const* nodes = VECTOR(cmp->comm_nodes);
+  igraph_integer_t const* memb_b = &MATRIX(cmp->parts, 0, b);
+  igraph_integer_t const first_a = VECTOR(cmp->comm_offsets)[a];
+  igraph_integer_t const first_b = VECTOR(cmp->comm_offsets)[b];
+  igraph_integer_t const n_comms_a =
+    VECTOR(cmp->comm_offsets)[a + 1] - first_a;
+  igraph_integer_t const n_comms_b =
+    VECTOR(cmp->comm_offsets)[b + 1] - first_b;
+  igraph_integer_t* counts = VECTOR(cmp->counts) + (thread * cmp->max_comms);
+  igraph_integer_t* col_max = VECTOR(cmp->col_max) + (thread * cmp->max_comms);
+  igraph_integer_t* touched = VECTOR(cmp->touched) + (thread * cmp->max_comms);
+  igraph_real_t mut_inf = 0;
+  igraph_real_t same_pairs = 0;
+  igraph_integer_t row_max_sum = 0;
+  igraph_integer_t col_max_sum = 0;
+
+  for (igraph_integer_t c = first_a; c < first_a + n_comms_a; c++) {
+    igraph_real_t const size_a = starts[c + 1] - starts[c];
+    igraph_integer_t n_touched = 0;
+    igraph_integer_t row_max = 0;
+
+    for (igraph_integer_t i = starts[c]; i < starts[c + 1]; i++) {
+      igraph_integer_t const d = memb_b[nodes[i]];
+      if (counts[d]++ == 0) {
+        touched[n_touched++] = d;
+      }
+    }
+
+    for (igraph_integer_t t = 0; t < n_touched; t++) {
+      igraph_integer_t const d = touched[t];
+      igraph_integer_t const n_ij = counts[d];
+      igraph_real_t const size_b =
+        starts[first_b + d + 1] - starts[first_b + d];
+
+      mut_inf += n_ij * log((n * n_ij) / (size_a * size_b));
+      same_pairs += (igraph_real_t)n_ij * (n_ij - 1);
+      row_max = n_ij > row_max ? n_ij : row_max;
+      col_max[d] = n_ij > col_max[d] ? n_ij : col_max[d];
+      counts[d] = 0;
+    }
+    row_max_sum += row_max;
+  }
+
+  for (igraph_integer_t d = 0; d < n_comms_b; d++) {
+    col_max_sum += col_max[d];
+    col_max[d] = 0;
+  }
+  mut_inf /= n;
+
+  for (igraph_integer_t m = 0; m < cmp->n_methods; m++) {
+    igraph_real_t const h_a = VECTOR(cmp->entropy)[a];
+    igraph_real_t const h_b = VECTOR(cmp->entropy)[b];
+    igraph_real_t const n_pairs = n * (n - 1);
+    igraph_real_t const frac_a = VECTOR(cmp->same_pairs)[a] / n_pairs;
+    igraph_real_t const frac_b = VECTOR(cmp->same_pairs)[b] / n_pairs;
+    igraph_real_t rand;
+    igraph_real_t expected;
+
+    switch (VECTOR(cmp->methods)[m]) {
+      case IGRAPH_COMMCMP_VI:
+        res[m * stride] = h_a + h_b - (2 * mut_inf);
+        break;
+      case IGRAPH_COMMCMP_NMI:
+        res[m * stride] =
+          (h_a == 0) && (h_b == 0) ? 1 : (2 * mut_inf) / (h_a + h_b);
+        break;
+      case IGRAPH_COMMCMP_SPLIT_JOIN:
+        res[m * stride] = (2 * n_nodes) - row_max_sum - col_max_sum;
+        break;
+      case IGRAPH_COMMCMP_RAND:
+      case IGRAPH_COMMCMP_ADJUSTED_RAND:
+        if ((n_comms_a == 1) && (n_comms_b == 1)) {
+          res[m * stride] = 1;
+          break;
+        }
+
+        rand = 1 + (2 * same_pairs / n_pairs) - frac_a - frac_b;
+        if (VECTOR(cmp->methods)[m] == IGRAPH_COMMCMP_ADJUSTED_RAND) {
+          expected = (frac_a * frac_b) + ((1 - frac_a) * (1 - frac_b));
+          rand = (rand - expected) / (1 - expected);
+        }
+        res[m * stride] = rand;
+        break;
+      default:
+        res[m * stride] = IGRAPH_NAN;
+    }
+  }
+}
+
+/* Map a linear pair index to the pair's row and column in the score
+ matrix. All pairs only includes the upper triangle, column by column. */
+static void pairwise_pair_i(mxIgraph_pairwise_t const* cmp,
+  igraph_integer_t const k, igraph_integer_t* row, igraph_integer_t* col)
+{
+  if (!cmp->all_pairs) {
+    *row = k % cmp->n_rows;
+    *col = k / cmp->n_rows;
+    return;
+  }
+
+  *col = (igraph_integer_t)((sqrt((8.0 * k) + 1) - 1) / 2);
+  while (((*col * (*col + 1)) / 2) > k) {
+    (*col)--;
+  }
+  while ((((*col + 1) * (*col + 2)) / 2) <= k) {
+    (*col)++;
+  }
+  *row = k - ((*col * (*col + 1)) / 2);
+}
+
+static igraph_error_t pairwise_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
+{
+  mxIgraph_pairwise_t* cmp = data;
+  igraph_integer_t const first = task * PAIRWISE_CHUNK_SIZE;
+  igraph_integer_t const last = first + PAIRWISE_CHUNK_SIZE < cmp->n_pairs ?
+                                  first + PAIRWISE_CHUNK_SIZE :
+                                  cmp->n_pairs;
+  igraph_integer_t const stride = cmp->n_rows * cmp->n_cols;
+  igraph_real_t* scores = VECTOR(cmp->scores);
+  igraph_integer_t row;
+  igraph_integer_t col;
+
+  pairwise_pair_i(cmp, first, &row, &col);
+  for (igraph_integer_t k = first; k < last; k++) {
+    igraph_integer_t const b = cmp->all_pairs ? col : cmp->n_rows + col;
+
+    pairwise_score_i(
+      cmp, row, b, thread, scores + row + (col * cmp->n_rows), stride);
+
+    if (cmp->all_pairs && (row != col)) {
+      for (igraph_integer_t m = 0; m < cmp->n_methods; m++) {
+        scores[(m * stride) + col + (row * cmp->n_rows)] =
+          scores[(m * stride) + row + (col * cmp->n_rows)];
+      }
+    }
+
+    if (++row == (cmp->all_pairs ? col + 1 : cmp->n_rows)) {
+      row = 0;
+      col++;
+    }
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+igraph_error_t mexIgraphPairwiseCompare(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(3);
+  VERIFY_N_OUTPUTS_ATMOST((int)mxGetNumberOfElements(prhs[2]));
+
+  mxIgraph_pairwise_t cmp;
+  igraph_integer_t failed;
+  igraph_error_t rs;
+
+  IGRAPH_CHECK(pairwise_init_i(&cmp, prhs[0], prhs[1], prhs[2]));
+  IGRAPH_FINALLY(pairwise_destroy_i, &cmp);
+
+  IGRAPH_FINALLY_CLEAN(1);
+  rs = mxIgraphBatchRun(cmp.n_tasks, pairwise_task_i, &cmp, &failed);
+  if (rs != IGRAPH_SUCCESS) {
+    pairwise_destroy_i(&cmp);
+    IGRAPH_ERRORF(
+      "Failed to compare partitions. %s", rs, mxIgraphBatchError());
+  }
+
+  for (igraph_integer_t m = 0; m < (nlhs > 1 ? nlhs : 1); m++) {
+    plhs[m] = mxCreateDoubleMatrix(cmp.n_rows, cmp.n_cols, mxREAL);
+    memcpy(mxGetDoubles(plhs[m]),
+      VECTOR(cmp.scores) + (m * cmp.n_rows * cmp.n_cols),
+      sizeof(igraph_real_t) * cmp.n_rows * cmp.n_cols);
+  }
+
+  pairwise_destroy_i(&cmp);
+
+  return IGRAPH_SUCCESS;
+}
@@ -0,0 +1,557 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "utils.h"
+#include "mexIgraphCluster.h"
+
+#include <mxIgraph.h>
+
+/* Number of co-assignment matrix columns counted per task. */
+#define CONSENSUS_CHUNK_SIZE 256
+
+/* State for building co-assignment matrices and iterating consensus
+ clustering on them.
+
+ Memberships are stored with one partition per row so the communities a
+ node belongs to across all partitions are contiguous. When pairs are not
+ restricted to a graph's edges, each partition's nodes are also grouped by
+ community so a node's co-members can be listed without a scan over all
+ nodes.
+
+ Co-assignment counts are kept in compressed column form. Since the matrix
+ is symmetric, column j also lists row j. */
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_real_t threshold;
+  igraph_bool_t has_graph;
+  igraph_adjlist_t neighbors;
+  igraph_matrix_int_t memberships;
+
+  igraph_vector_int_t part_starts;
+  igraph_vector_int_t comm_starts;
+  igraph_vector_int_t comm_nodes;
+
+  igraph_integer_t n_tasks;
+  igraph_vector_int_t counts;
+  igraph_vector_int_t marks;
+  igraph_vector_int_list_t task_rows;
+  igraph_vector_int_list_t task_hits;
+
+  igraph_vector_int_t col_starts;
+  igraph_vector_int_t row_idx;
+  igraph_vector_int_t hits;
+
+  mxIgraph_cluster_method_t method;
+  mxIgraph_cluster_params_t params;
+  igraph_bool_t has_params;
+  igraph_integer_t n_starts;
+  igraph_vector_t weights;
+  igraph_vector_int_list_t work;
+  igraph_t* graphs;
+  igraph_integer_t n_graphs;
+} mxIgraph_consensus_t;
+
+static void consensus_destroy_graphs_i(mxIgraph_consensus_t* cons)
+{
+  for (igraph_integer_t i = 0; i < cons->n_graphs; i++) {
+    igraph_destroy(cons->graphs + i);
+  }
+  cons->n_graphs = 0;
+}
+
+static void consensus_destroy_i(mxIgraph_consensus_t* cons)
+{
+  if (cons->has_graph) {
+    igraph_adjlist_destroy(&cons->neighbors);
+  }
+
+  if (cons->has_params) {
+    mexIgraphClusterParamsDestroy(&cons->params);
+  }
+
+  consensus_destroy_graphs_i(cons);
+  IGRAPH_FREE(cons->graphs);
+
+  igraph_matrix_int_destroy(&cons->memberships);
+  igraph_vector_int_destroy(&cons->part_starts);
+  igraph_vector_int_destroy(&cons->comm_starts);
+  igraph_vector_int_destroy(&cons->comm_nodes);
+  igraph_vector_int_destroy(&cons->counts);
+  igraph_vector_int_destroy(&cons->marks);
+  igraph_vector_int_list_destroy(&cons->task_rows);
+  igraph_vector_int_list_destroy(&cons->task_hits);
+  igraph_vector_int_destroy(&cons->col_starts);
+  igraph_vector_int_destroy(&cons->row_idx);
+  igraph_vector_int_destroy(&cons->hits);
+  igraph_vector_destroy(&cons->weights);
+  igraph_vector_int_list_destroy(&cons->work);
+}
+
+static igraph_error_t consensus_init_i(mxIgraph_consensus_t* cons,
+  mxArray const* memberships, mxArray const* graph,
+  mxArray const* graph_options)
+{
+  igraph_bool_t const all_pairs = mxIsEmpty(graph);
+  igraph_integer_t n_threads;
+
+  IGRAPH_CHECK(mxIgraphMatrixIntFromArray(
+    memberships, &cons->memberships, MXIGRAPH_IDX_SHIFT));
+  IGRAPH_FINALLY(igraph_matrix_int_destroy, &cons->memberships);
+
+  cons->n_nodes = igraph_matrix_int_ncol(&cons->memberships);
+  cons->n_tasks =
+    (cons->n_nodes + CONSENSUS_CHUNK_SIZE - 1) / CONSENSUS_CHUNK_SIZE;
+  n_threads = !all_pairs                               ? 0 :
+              mxIgraphThreadCount() < cons->n_tasks ? mxIgraphThreadCount() :
+                                                      cons->n_tasks;
+
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->part_starts, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->comm_starts, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->comm_nodes, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->counts, n_threads * cons->n_nodes);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->marks, n_threads * cons->n_nodes);
+  IGRAPH_CHECK(igraph_vector_int_list_init(&cons->task_rows, cons->n_tasks));
+  IGRAPH_FINALLY(igraph_vector_int_list_destroy, &cons->task_rows);
+  IGRAPH_CHECK(igraph_vector_int_list_init(&cons->task_hits, cons->n_tasks));
+  IGRAPH_FINALLY(igraph_vector_int_list_destroy, &cons->task_hits);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->col_starts, cons->n_nodes + 1);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->row_idx, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&cons->hits, 0);
+  IGRAPH_VECTOR_INIT_FINALLY(&cons->weights, 0);
+  IGRAPH_CHECK(igraph_vector_int_list_init(&cons->work, 0));
+  IGRAPH_FINALLY(igraph_vector_int_list_destroy, &cons->work);
+
+  if (!all_pairs) {
+    igraph_t g;
+
+    IGRAPH_CHECK(mxIgraphFromArray(graph, &g, NULL, graph_options));
+    IGRAPH_FINALLY(igraph_destroy, &g);
+
+    if (igraph_vcount(&g) != cons->n_nodes) {
+      IGRAPH_ERRORF("Memberships have %" IGRAPH_PRId " nodes but the graph "
+                    "has %" IGRAPH_PRId " nodes.",
+        IGRAPH_EINVAL, cons->n_nodes, igraph_vcount(&g));
+    }
+
+    IGRAPH_CHECK(igraph_adjlist_init(
+      &g, &cons->neighbors, IGRAPH_ALL, IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE));
+    igraph_destroy(&g);
+    IGRAPH_FINALLY_CLEAN(1);
+    cons->has_graph = true;
+  }
+
+  IGRAPH_FINALLY_CLEAN(13);
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Renumber each partition's communities 0..k - 1 and, when counting all
+ node pairs, group every partition's nodes by community. */
+static igraph_error_t consensus_index_i(mxIgraph_consensus_t* cons)
+{
+  igraph_integer_t const n_parts = igraph_matrix_int_nrow(&cons->memberships);
+  igraph_integer_t const n_nodes = cons->n_nodes;
+  igraph_integer_t n_starts = 0;
+  igraph_vector_int_t part;
+
+  if (cons->has_graph) {
+    return IGRAPH_SUCCESS;
+  }
+
+  igraph_vector_int_fill(&cons->marks, -1);
+
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&part, n_nodes);
+  IGRAPH_CHECK(igraph_vector_int_resize(&cons->part_starts, n_parts));
+  for (igraph_integer_t p = 0; p < n_parts; p++) {
+    igraph_integer_t n_comms;
+
+    IGRAPH_CHECK(igraph_matrix_int_get_row(&cons->memberships, &part, p));
+    IGRAPH_CHECK(igraph_reindex_membership(&part, NULL, &n_comms));
+    IGRAPH_CHECK(igraph_matrix_int_set_row(&cons->memberships, &part, p));
+
+    VECTOR(cons->part_starts)[p] = n_starts;
+    n_starts += n_comms + 1;
+  }
+  igraph_vector_int_destroy(&part);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  IGRAPH_CHECK(igraph_vector_int_resize(&cons->comm_starts, n_starts));
+  IGRAPH_CHECK(igraph_vector_int_resize(&cons->comm_nodes, n_parts * n_nodes));
+  igraph_vector_int_null(&cons->comm_starts);
+
+  /* Counting sort of each partition's nodes by community. Nodes are placed
+     in increasing order so each community's node list is sorted. */
+  for (igraph_integer_t p = 0; p < n_parts; p++) {
+    igraph_integer_t* starts =
+      VECTOR(cons->comm_starts) + VECTOR(cons->part_starts)[p];
+    igraph_integer_t* nodes = VECTOR(cons->comm_nodes) + (p * n_nodes);
+    igraph_integer_t const n_comms =
+      (p + 1 < n_parts ? VECTOR(cons->part_starts)[p + 1] : n_starts) -
+      VECTOR(cons->part_starts)[p] - 1;
+
+    for (igraph_integer_t i = 0; i < n_nodes; i++) {
+      starts[MATRIX(cons->memberships, p, i) + 1]++;
+    }
+
+    for (igraph_integer_t c = 0; c < n_comms; c++) {
+      starts[c + 1] += starts[c];
+    }
+
+    for (igraph_integer_t i = 0; i < n_nodes; i++) {
+      nodes[starts[MATRIX(cons->memberships, p, i)]++] = i;
+    }
+
+    for (igraph_integer_t c = n_comms; c > 0; c--) {
+      starts[c] = starts[c - 1];
+    }
+    starts[0] = 0;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+static int consensus_compare_i(void const* a, void const* b)
+{
+  igraph_integer_t const x = *(igraph_integer_t const*)a;
+  igraph_integer_t const y = *(igraph_integer_t const*)b;
+
+  return (x > y) - (x < y);
+}
+
+/* Count, for every node pair in a chunk of columns, the number of partitions
+ placing both nodes in the same community and keep pairs meeting the
+ threshold. */
+static igraph_error_t consensus_count_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
+{
+  mxIgraph_consensus_t* cons = data;
+  igraph_integer_t const n_parts = igraph_matrix_int_nrow(&cons->memberships);
+  igraph_integer_t const n_nodes = cons->n_nodes;
+  igraph_real_t const min_hits = cons->threshold * n_parts;
+  igraph_integer_t const first = task * CONSENSUS_CHUNK_SIZE;
+  igraph_integer_t const last = first + CONSENSUS_CHUNK_SIZE < n_nodes ?
+                                  first + CONSENSUS_CHUNK_SIZE :
+                                  n_nodes;
+  igraph_integer_t* counts = VECTOR(cons->counts) + (thread * n_nodes);
+  igraph_integer_t* marks = VECTOR(cons->marks) + (thread * n_nodes);
+  igraph_vector_int_t* rows =
+    igraph_vector_int_list_get_ptr(&cons->task_rows, task);
+  igraph_vector_int_t* hits =
+    igraph_vector_int_list_get_ptr(&cons->task_hits, task);
+
+  igraph_vector_int_clear(rows);
+  igraph_vector_int_clear(hits);
+  for (igraph_integer_t j = first; j < last; j++) {
+    igraph_integer_t const* memb_j = &MATRIX(cons->memberships, 0, j);
+    igraph_integer_t const col_start = igraph_vector_int_size(rows);
+
+    if (cons->has_graph) {
+      igraph_vector_int_t const* neis =
+        igraph_adjlist_get(&cons->neighbors, j);
+
+      for (igraph_integer_t k = 0; k < igraph_vector_int_size(neis); k++) {
+        igraph_integer_t const i = VECTOR(*neis)[k];
+        igraph_integer_t const* memb_i = &MATRIX(cons->memberships, 0, i);
+        igraph_integer_t n_hits = 0;
+
+        for (igraph_integer_t p = 0; p < n_parts; p++) {
+          n_hits += memb_i[p] == memb_j[p];
+        }
+
+        if ((n_hits > 0) && (n_hits >= min_hits)) {
+          IGRAPH_CHECK(igraph_vector_int_push_back(rows, i));
+          IGRAPH_CHECK(igraph_vector_int_push_back(hits, n_hits));
+        }
+      }
+    } else {
+      igraph_integer_t n_kept = col_start;
+
+      for (igraph_integer_t p = 0; p < n_parts; p++) {
+        igraph_integer_t const* starts = VECTOR(cons->comm_starts) +
+                                         VECTOR(cons->part_starts)[p] +
+                                         memb_j[p];
+        igraph_integer_t const* nodes =
+          VECTOR(cons->comm_nodes) + (p * n_nodes);
+
+        for (igraph_integer_t k = starts[0]; k < starts[1]; k++) {
+          igraph_integer_t const i = nodes[k];
+          if (i == j) {
+            continue;
+          }
+
+          if (marks[i] != j) {
+            marks[i] = j;
+            counts[i] = 0;
+            IGRAPH_CHECK(igraph_vector_int_push_back(rows, i));
+          }
+          counts[i]++;
+        }
+      }
+
+      for (igraph_integer_t k = col_start; k < igraph_vector_int_size(rows);
+           k++) {
+        if (counts[VECTOR(*rows)[k]] >= min_hits) {
+          VECTOR(*rows)[n_kept++] = VECTOR(*rows)[k];
+        }
+      }
+      IGRAPH_CHECK(igraph_vector_int_resize(rows, n_kept));
+
+      igraph_qsort(VECTOR(*rows) + col_start, n_kept - col_start,
+        sizeof(igraph_integer_t), consensus_compare_i);
+      for (igraph_integer_t k = col_start; k < n_kept; k++) {
+        IGRAPH_CHECK(
+          igraph_vector_int_push_back(hits, counts[VECTOR(*rows)[k]]));
+      }
+    }
+
+    VECTOR(cons->col_starts)[j + 1] =
+      igraph_vector_int_size(rows) - col_start;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Join the per task results into a single compressed column matrix. */
+static igraph_error_t consensus_collect_i(mxIgraph_consensus_t* cons)
+{
+  igraph_integer_t* col_starts = VECTOR(cons->col_starts);
+
+  col_starts[0] = 0;
+  for (igraph_integer_t j = 0; j < cons->n_nodes; j++) {
+    col_starts[j + 1] += col_starts[j];
+  }
+
+  IGRAPH_CHECK(
+    igraph_vector_int_resize(&cons->row_idx, col_starts[cons->n_nodes]));
+  IGRAPH_CHECK(
+    igraph_vector_int_resize(&cons->hits, col_starts[cons->n_nodes]));
+
+  for (igraph_integer_t t = 0; t < cons->n_tasks; t++) {
+    igraph_vector_int_t* rows =
+      igraph_vector_int_list_get_ptr(&cons->task_rows, t);
+    igraph_vector_int_t* hits =
+      igraph_vector_int_list_get_ptr(&cons->task_hits, t);
+    igraph_integer_t const offset = col_starts[t * CONSENSUS_CHUNK_SIZE];
+
+    for (igraph_integer_t k = 0; k < igraph_vector_int_size(rows); k++) {
+      VECTOR(cons->row_idx)[offset + k] = VECTOR(*rows)[k];
+      VECTOR(cons->hits)[offset + k] = VECTOR(*hits)[k];
+    }
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Consensus is reached once every kept pair is placed in the same community
+ by all partitions. */
+static igraph_bool_t consensus_converged_i(mxIgraph_consensus_t const* cons)
+{
+  igraph_integer_t const n_parts = igraph_matrix_int_nrow(&cons->memberships);
+
+  for (igraph_integer_t k = 0; k < igraph_vector_int_size(&cons->hits);
+       k++) {
+    if (VECTOR(cons->hits)[k] != n_parts) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* Build the weighted graph of the current co-assignment matrix and one copy
+ per thread to cluster it with. Clustering methods can update a graph's
+ cached properties so threads can not share a graph. */
+static igraph_error_t consensus_graphs_i(mxIgraph_consensus_t* cons)
+{
+  igraph_integer_t const n_parts = igraph_matrix_int_nrow(&cons->memberships);
+  igraph_integer_t const n_threads = mxIgraphThreadCount() < cons->n_starts ?
+                                       mxIgraphThreadCount() :
+                                       cons->n_starts;
+  igraph_vector_int_t edges;
+  igraph_integer_t n_edges = 0;
+
+  consensus_destroy_graphs_i(cons);
+
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&edges, igraph_vector_int_size(&cons->hits));
+  IGRAPH_CHECK(igraph_vector_resize(
+    &cons->weights, igraph_vector_int_size(&cons->hits) / 2));
+  for (igraph_integer_t j = 0; j < cons->n_nodes; j++) {
+    for (igraph_integer_t k = VECTOR(cons->col_starts)[j];
+         k < VECTOR(cons->col_starts)[j + 1]; k++) {
+      igraph_integer_t const i = VECTOR(cons->row_idx)[k];
+      if (i >= j) {
+        break;
+      }
+
+      VECTOR(edges)[2 * n_edges] = i;
+      VECTOR(edges)[(2 * n_edges) + 1] = j;
+      VECTOR(cons->weights)[n_edges] =
+        (igraph_real_t)VECTOR(cons->hits)[k] / n_parts;
+      n_edges++;
+    }
+  }
+
+  IGRAPH_CHECK(igraph_create(cons->graphs, &edges, cons->n_nodes, false));
+  cons->n_graphs++;
+  igraph_vector_int_destroy(&edges);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  for (igraph_integer_t i = 1; i < n_threads; i++) {
+    IGRAPH_CHECK(igraph_copy(cons->graphs + i, cons->graphs));
+    cons->n_graphs++;
+  }
+
+  IGRAPH_CHECK(igraph_vector_int_list_resize(&cons->work, n_threads));
+  for (igraph_integer_t i = 0; i < n_threads; i++) {
+    IGRAPH_CHECK(igraph_vector_int_resize(
+      igraph_vector_int_list_get_ptr(&cons->work, i), cons->n_nodes));
+  }
+
+  IGRAPH_CHECK(igraph_matrix_int_resize(
+    &cons->memberships, cons->n_starts, cons->n_nodes));
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t consensus_cluster_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
+{
+  mxIgraph_consensus_t* cons = data;
+  igraph_vector_int_t* membership =
+    igraph_vector_int_list_get_ptr(&cons->work, thread);
+  igraph_real_t quality;
+
+  IGRAPH_CHECK(mexIgraphClusterRun(&cons->method, cons->graphs + thread,
+    &cons->weights, &cons->params, false, membership, &quality));
+
+  for (igraph_integer_t i = 0; i < cons->n_nodes; i++) {
+    MATRIX(cons->memberships, task, i) = VECTOR(*membership)[i];
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+static mxArray* consensus_to_array_i(mxIgraph_consensus_t const* cons)
+{
+  igraph_integer_t const n_parts = igraph_matrix_int_nrow(&cons->memberships);
+  igraph_integer_t const nnz = igraph_vector_int_size(&cons->hits);
+  mxArray* p = mxCreateSparse(
+    cons->n_nodes, cons->n_nodes, nnz > 0 ? nnz : 1, mxREAL);
+  mwIndex* jc = mxGetJc(p);
+  mwIndex* ir = mxGetIr(p);
+  mxDouble* pr = mxGetDoubles(p);
+
+  for (igraph_integer_t j = 0; j <= cons->n_nodes; j++) {
+    jc[j] = VECTOR(cons->col_starts)[j];
+  }
+
+  for (igraph_integer_t k = 0; k < nnz; k++) {
+    ir[k] = VECTOR(cons->row_idx)[k];
+    pr[k] = (mxDouble)VECTOR(cons->hits)[k] / n_parts;
+  }
+
+  return p;
+}
+
+igraph_error_t mexIgraphConsensus(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(5);
+  VERIFY_N_OUTPUTS_ATMOST(2);
+
+  mxArray const* opts = prhs[3];
+  mxArray const* method_name = mxGetField(opts, 0, "method");
+  igraph_bool_t const iterate = method_name && !mxIsEmpty(method_name);
+  mxIgraph_consensus_t cons = {
+    .threshold = mxIgraphRealFromOptions(opts, "threshold"),
+  };
+  igraph_integer_t max_iterations = 0;
+  igraph_integer_t failed;
+  igraph_error_t rs;
+
+  if (iterate) {
+    cons.n_starts = mxIgraphIntegerFromOptions(opts, "nStarts");
+    max_iterations = mxIgraphIntegerFromOptions(opts, "maxIterations");
+  }
+  MXIGRAPH_CHECK_STATUS();
+
+  IGRAPH_CHECK(consensus_init_i(&cons, prhs[0], prhs[1], prhs[2]));
+  IGRAPH_FINALLY(consensus_destroy_i, &cons);
+
+  if (iterate) {
+    IGRAPH_CHECK(mexIgraphClusterSelectMethod(method_name, &cons.method));
+    IGRAPH_CHECK(
+      mexIgraphClusterParams(cons.method.id, prhs[4], &cons.params));
+    cons.has_params = true;
+
+    cons.graphs = IGRAPH_CALLOC(cons.n_starts, igraph_t);
+    IGRAPH_CHECK_OOM(cons.graphs, "Could not allocate consensus graphs.");
+  }
+
+  for (igraph_integer_t iter = 0;; iter++) {
+    IGRAPH_CHECK(consensus_index_i(&cons));
+
+    IGRAPH_FINALLY_CLEAN(1);
+    rs = mxIgraphBatchRun(cons.n_tasks, consensus_count_task_i, &cons,
+      &failed);
+    if (rs != IGRAPH_SUCCESS) {
+      consensus_destroy_i(&cons);
+      IGRAPH_ERRORF(
+        "Failed to count co-assignments. %s", rs, mxIgraphBatchError());
+    }
+    IGRAPH_FINALLY(consensus_destroy_i, &cons);
+
+    IGRAPH_CHECK(consensus_collect_i(&cons));
+
+    if (!iterate || (iter == max_iterations) ||
+        consensus_converged_i(&cons)) {
+      break;
+    }
+
+    IGRAPH_CHECK(consensus_graphs_i(&cons));
+
+    IGRAPH_FINALLY_CLEAN(1);
+    rs = mxIgraphBatchRun(cons.n_starts, consensus_cluster_task_i, &cons,
+      &failed);
+    if (rs != IGRAPH_SUCCESS) {
+      consensus_destroy_i(&cons);
+      IGRAPH_ERRORF("Failed to cluster consensus graph in restart "
+                    "%" IGRAPH_PRId " of iteration %" IGRAPH_PRId ". %s",
+        rs, failed + 1, iter + 1, mxIgraphBatchError());
+    }
+    IGRAPH_FINALLY(consensus_destroy_i, &cons);
+  }
+
+  plhs[0] = consensus_to_array_i(&cons);
+
+  if (nlhs > 1) {
+    igraph_vector_int_t membership;
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&membership, cons.n_nodes);
+    IGRAPH_CHECK(
+      igraph_matrix_int_get_row(&cons.memberships, &membership, 0));
+    IGRAPH_CHECK(igraph_reindex_membership(&membership, NULL, NULL));
+    plhs[1] = mxIgraphVectorIntToArray(&membership, MXIGRAPH_IDX_SHIFT);
+    igraph_vector_int_destroy(&membership);
+    IGRAPH_FINALLY_CLEAN(1);
+  }
+
+  consensus_destroy_i(&cons);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  return IGRAPH_SUCCESS;
+}
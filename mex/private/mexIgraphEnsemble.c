@@ -0,0 +1,264 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "utils.h"
+
+#include <mxIgraph.h>
+
+typedef enum {
+  MXIGRAPH_NULL_REWIRE = 0,
+  MXIGRAPH_NULL_CONFIGURATION,
+  MXIGRAPH_NULL_ERDOSRENYI,
+  MXIGRAPH_NULL_N
+} mxIgraph_null_model_t;
+
+typedef enum {
+  MXIGRAPH_STATISTIC_MODULARITY = 0,
+  MXIGRAPH_STATISTIC_TRANSITIVITY,
+  MXIGRAPH_STATISTIC_ASSORTATIVITY,
+  MXIGRAPH_STATISTIC_PATHLENGTH,
+  MXIGRAPH_STATISTIC_N
+} mxIgraph_statistic_t;
+
+typedef struct mxIgraph_ensemble_t mxIgraph_ensemble_t;
+
+typedef igraph_error_t (*null_model_t)(
+  mxIgraph_ensemble_t const*, igraph_t*);
+typedef igraph_error_t (*statistic_t)(
+  mxIgraph_ensemble_t const*, igraph_t const*, igraph_real_t*);
+
+/* Everything the replicates need, read on the main thread. Replicates only
+ read the template so it can be shared between threads. */
+struct mxIgraph_ensemble_t {
+  null_model_t null_model;
+  statistic_t statistic;
+  igraph_t template;
+  igraph_bool_t directed;
+  igraph_integer_t n_rewires;
+  igraph_real_t resolution;
+  igraph_vector_int_t out_degree;
+  igraph_vector_int_t in_degree;
+  igraph_vector_int_t membership;
+  igraph_real_t* values;
+};
+
+static igraph_error_t mxIgraph_rewire_i(
+  mxIgraph_ensemble_t const* ens, igraph_t* replicate)
+{
+  IGRAPH_CHECK(igraph_copy(replicate, &ens->template));
+  IGRAPH_FINALLY(igraph_destroy, replicate);
+  IGRAPH_CHECK(
+    igraph_rewire(replicate, ens->n_rewires, IGRAPH_REWIRING_SIMPLE));
+  IGRAPH_FINALLY_CLEAN(1);
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t mxIgraph_configuration_i(
+  mxIgraph_ensemble_t const* ens, igraph_t* replicate)
+{
+  IGRAPH_CHECK(igraph_degree_sequence_game(replicate, &ens->out_degree,
+    ens->directed ? &ens->in_degree : NULL, IGRAPH_DEGSEQ_CONFIGURATION));
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t mxIgraph_erdos_renyi_i(
+  mxIgraph_ensemble_t const* ens, igraph_t* replicate)
+{
+  IGRAPH_CHECK(igraph_erdos_renyi_game_gnm(replicate,
+    igraph_vcount(&ens->template), igraph_ecount(&ens->template),
+    ens->directed, false));
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t mxIgraph_modularity_i(
+  mxIgraph_ensemble_t const* ens, igraph_t const* graph, igraph_real_t* res)
+{
+  IGRAPH_CHECK(igraph_modularity(graph, &ens->membership, NULL,
+    ens->resolution, ens->directed, res));
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t mxIgraph_transitivity_i(
+  mxIgraph_ensemble_t const* UNUSED(ens), igraph_t const* graph,
+  igraph_real_t* res)
+{
+  IGRAPH_CHECK(
+    igraph_transitivity_undirected(graph, res, IGRAPH_TRANSITIVITY_NAN));
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t mxIgraph_assortativity_i(
+  mxIgraph_ensemble_t const* ens, igraph_t const* graph, igraph_real_t* res)
+{
+  IGRAPH_CHECK(igraph_assortativity_degree(graph, res, ens->directed));
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t mxIgraph_path_length_i(
+  mxIgraph_ensemble_t const* ens, igraph_t const* graph, igraph_real_t* res)
+{
+  IGRAPH_CHECK(
+    igraph_average_path_length(graph, res, NULL, ens->directed, false, true));
+
+  return IGRAPH_SUCCESS;
+}
+
+static void ensemble_destroy_i(mxIgraph_ensemble_t* ens)
+{
+  igraph_destroy(&ens->template);
+  igraph_vector_int_destroy(&ens->out_degree);
+  igraph_vector_int_destroy(&ens->in_degree);
+  igraph_vector_int_destroy(&ens->membership);
+  IGRAPH_FREE(ens->values);
+}
+
+static igraph_error_t ensemble_task_i(
+  igraph_integer_t task, igraph_integer_t UNUSED(thread), void* data)
+{
+  mxIgraph_ensemble_t* ens = data;
+  igraph_t replicate;
+
+  IGRAPH_CHECK(ens->null_model(ens, &replicate));
+  IGRAPH_FINALLY(igraph_destroy, &replicate);
+
+  IGRAPH_CHECK(ens->statistic(ens, &replicate, ens->values + task));
+
+  igraph_destroy(&replicate);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  return IGRAPH_SUCCESS;
+}
+
+igraph_error_t mexIgraphEnsemble(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(5);
+  VERIFY_N_OUTPUTS_ATMOST(2);
+
+  mxArray const* graph_options = prhs[3];
+  mxArray const* method_options = prhs[4];
+  mxIgraph_null_model_t model;
+  mxIgraph_statistic_t statistic;
+  mxIgraph_ensemble_t ens = { 0 };
+  igraph_integer_t const n_replicates =
+    mxIgraphIntegerFromOptions(method_options, "nReplicates");
+  igraph_real_t observed;
+  igraph_integer_t failed;
+  MXIGRAPH_CHECK_STATUS();
+
+  static char const* const models[MXIGRAPH_NULL_N] = {
+    [MXIGRAPH_NULL_REWIRE] = "rewire",
+    [MXIGRAPH_NULL_CONFIGURATION] = "configuration",
+    [MXIGRAPH_NULL_ERDOSRENYI] = "erdosrenyi",
+  };
+
+  null_model_t model_table[MXIGRAPH_NULL_N] = {
+    [MXIGRAPH_NULL_REWIRE] = mxIgraph_rewire_i,
+    [MXIGRAPH_NULL_CONFIGURATION] = mxIgraph_configuration_i,
+    [MXIGRAPH_NULL_ERDOSRENYI] = mxIgraph_erdos_renyi_i,
+  };
+
+  static char const* const statistics[MXIGRAPH_STATISTIC_N] = {
+    [MXIGRAPH_STATISTIC_MODULARITY] = "modularity",
+    [MXIGRAPH_STATISTIC_TRANSITIVITY] = "transitivity",
+    [MXIGRAPH_STATISTIC_ASSORTATIVITY] = "assortativity",
+    [MXIGRAPH_STATISTIC_PATHLENGTH] = "pathlength",
+  };
+
+  statistic_t statistic_table[MXIGRAPH_STATISTIC_N] = {
+    [MXIGRAPH_STATISTIC_MODULARITY] = mxIgraph_modularity_i,
+    [MXIGRAPH_STATISTIC_TRANSITIVITY] = mxIgraph_transitivity_i,
+    [MXIGRAPH_STATISTIC_ASSORTATIVITY] = mxIgraph_assortativity_i,
+    [MXIGRAPH_STATISTIC_PATHLENGTH] = mxIgraph_path_length_i,
+  };
+
+  model = mxIgraphSelectMethod(prhs[1], models, MXIGRAPH_NULL_N);
+  MXIGRAPH_CHECK_METHOD(model, prhs[1]);
+  statistic = mxIgraphSelectMethod(prhs[2], statistics, MXIGRAPH_STATISTIC_N);
+  MXIGRAPH_CHECK_METHOD(statistic, prhs[2]);
+  ens.null_model = model_table[model];
+  ens.statistic = statistic_table[statistic];
+
+  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &ens.template, NULL, graph_options));
+  IGRAPH_FINALLY(igraph_destroy, &ens.template);
+  ens.directed = igraph_is_directed(&ens.template);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&ens.out_degree, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&ens.in_degree, 0);
+
+  if (statistic == MXIGRAPH_STATISTIC_MODULARITY) {
+    ens.resolution = mxIgraphRealFromOptions(method_options, "resolution");
+    MXIGRAPH_CHECK_STATUS();
+    IGRAPH_CHECK(mxIgraphVectorIntFromOptions(
+      method_options, "membership", &ens.membership, MXIGRAPH_IDX_SHIFT));
+  } else {
+    IGRAPH_CHECK(igraph_vector_int_init(&ens.membership, 0));
+  }
+  IGRAPH_FINALLY(igraph_vector_int_destroy, &ens.membership);
+
+  if (model == MXIGRAPH_NULL_REWIRE) {
+    ens.n_rewires = mxIgraphIntegerFromOptions(method_options, "nRewires");
+    MXIGRAPH_CHECK_STATUS();
+  }
+
+  /* Degrees are taken once so replicates do not each query the
+     template. */
+  if (model == MXIGRAPH_NULL_CONFIGURATION) {
+    IGRAPH_CHECK(igraph_degree(&ens.template, &ens.out_degree,
+      igraph_vss_all(), ens.directed ? IGRAPH_OUT : IGRAPH_ALL, true));
+    if (ens.directed) {
+      IGRAPH_CHECK(igraph_degree(&ens.template, &ens.in_degree,
+        igraph_vss_all(), IGRAPH_IN, true));
+    }
+  }
+
+  IGRAPH_CHECK(ens.statistic(&ens, &ens.template, &observed));
+
+  ens.values = IGRAPH_CALLOC(n_replicates, igraph_real_t);
+  IGRAPH_CHECK_OOM(ens.values, "Could not allocate ensemble statistics.");
+
+  IGRAPH_FINALLY_CLEAN(4);
+  igraph_error_t const rs =
+    mxIgraphBatchRun(n_replicates, ensemble_task_i, &ens, &failed);
+
+  if (rs == IGRAPH_SUCCESS) {
+    plhs[0] = mxCreateDoubleMatrix(n_replicates, 1, mxREAL);
+    double* values = mxGetDoubles(plhs[0]);
+    for (igraph_integer_t i = 0; i < n_replicates; i++) {
+      values[i] = ens.values[i];
+    }
+
+    if (nlhs > 1) {
+      plhs[1] = mxCreateDoubleScalar(observed);
+    }
+  }
+
+  ensemble_destroy_i(&ens);
+
+  if (rs != IGRAPH_SUCCESS) {
+    IGRAPH_ERRORF("Failed to evaluate replicate %" IGRAPH_PRId ". %s", rs,
+      failed + 1, mxIgraphBatchError());
+  }
+
+  return IGRAPH_SUCCESS;
+}
@@ -47,7 +47,7 @@ typedef enum {
 
 static igraph_error_t mxIgraph_star_i(mxArray const* opts, igraph_t* graph)
 {
-  char const* modes[] = { [IGRAPH_STAR_OUT] = "out",
+  static char const* const modes[] = { [IGRAPH_STAR_OUT] = "out",
     [IGRAPH_STAR_IN] = "in",
     [IGRAPH_STAR_MUTUAL] = "mutual",
     [IGRAPH_STAR_UNDIRECTED] = "undirected" };
@@ -69,7 +69,7 @@ static igraph_error_t mxIgraph_star_i(mxArray const* opts, igraph_t* graph)
 
 static igraph_error_t mxIgraph_wheel_i(mxArray const* opts, igraph_t* graph)
 {
-  char const* modes[] = { [IGRAPH_WHEEL_OUT] = "out",
+  static char const* const modes[] = { [IGRAPH_WHEEL_OUT] = "out",
     [IGRAPH_WHEEL_IN] = "in",
     [IGRAPH_WHEEL_MUTUAL] = "mutual",
     [IGRAPH_WHEEL_UNDIRECTED] = "undirected" };
@@ -106,7 +106,7 @@ static igraph_error_t mxIgraph_ring_i(mxArray const* opts, igraph_t* graph)
 static igraph_error_t mxIgraph_kary_tree_i(
   mxArray const* opts, igraph_t* graph)
 {
-  char const* types[] = { [IGRAPH_TREE_OUT] = "out",
+  static char const* const types[] = { [IGRAPH_TREE_OUT] = "out",
     [IGRAPH_TREE_IN] = "in",
     [IGRAPH_TREE_UNDIRECTED] = "undirected" };
   igraph_integer_t const n_types = 3;
@@ -128,7 +128,7 @@ static igraph_error_t mxIgraph_kary_tree_i(
 static igraph_error_t mxIgraph_regular_tree_i(
   mxArray const* opts, igraph_t* graph)
 {
-  char const* types[] = { [IGRAPH_TREE_OUT] = "out",
+  static char const* const types[] = { [IGRAPH_TREE_OUT] = "out",
     [IGRAPH_TREE_IN] = "in",
     [IGRAPH_TREE_UNDIRECTED] = "undirected" };
   igraph_integer_t const n_types = 3;
@@ -258,7 +258,7 @@ igraph_error_t mexIgraphGenerate(
   typedef igraph_error_t (*generator_method_t)(mxArray const* prhs, igraph_t*);
   generator_method_t generator_method;
 
-  char const* generators[MXIGRAPH_GENERATOR_N] = {
+  static char const* const generators[MXIGRAPH_GENERATOR_N] = {
     [MXIGRAPH_GENERATOR_STAR] = "star",
     [MXIGRAPH_GENERATOR_WHEEL] = "wheel",
     [MXIGRAPH_GENERATOR_RING] = "ring",
@@ -27,18 +27,16 @@ igraph_error_t mexIgraphIsIsomorphic(
   VERIFY_N_OUTPUTS_EQUAL(1);
 
   mxArray const* graph_options = prhs[2];
-  igraph_t graph1, graph2;
+  igraph_t const *graph1, *graph2;
+  igraph_vector_t const *weights1, *weights2;
   igraph_bool_t flag;
 
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &graph1, NULL, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph1);
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[1], &graph2, NULL, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph2);
+  IGRAPH_CHECK(
+    mxIgraphFromArrayCached(prhs[0], &graph1, &weights1, graph_options));
+  IGRAPH_CHECK(
+    mxIgraphFromArrayCached(prhs[1], &graph2, &weights2, graph_options));
 
-  IGRAPH_CHECK(igraph_isomorphic(&graph1, &graph2, &flag));
-  igraph_destroy(&graph1);
-  igraph_destroy(&graph2);
-  IGRAPH_FINALLY_CLEAN(2);
+  IGRAPH_CHECK(igraph_isomorphic(graph1, graph2, &flag));
 
   plhs[0] = mxCreateLogicalScalar(flag);
 
@@ -52,18 +50,16 @@ igraph_error_t mexIgraphIsSubIsomorphic(
   VERIFY_N_OUTPUTS_EQUAL(1);
 
   mxArray const* graph_options = prhs[2];
-  igraph_t graph1, graph2;
+  igraph_t const *graph1, *graph2;
+  igraph_vector_t const *weights1, *weights2;
   igraph_bool_t flag;
 
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &graph1, NULL, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph1);
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[1], &graph2, NULL, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph2);
+  IGRAPH_CHECK(
+    mxIgraphFromArrayCached(prhs[0], &graph1, &weights1, graph_options));
+  IGRAPH_CHECK(
+    mxIgraphFromArrayCached(prhs[1], &graph2, &weights2, graph_options));
 
-  IGRAPH_CHECK(igraph_subisomorphic(&graph1, &graph2, &flag));
-  igraph_destroy(&graph1);
-  igraph_destroy(&graph2);
-  IGRAPH_FINALLY_CLEAN(2);
+  IGRAPH_CHECK(igraph_subisomorphic(graph1, graph2, &flag));
 
   plhs[0] = mxCreateLogicalScalar(flag);
 
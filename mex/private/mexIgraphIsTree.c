@@ -27,26 +27,23 @@ igraph_error_t mexIgraphIsTree(
   VERIFY_N_OUTPUTS_EQUAL(1);
 
   mxArray const* opts = prhs[1];
-  igraph_t graph;
+  igraph_t const* graph;
+  igraph_vector_t const* weights;
   igraph_neimode_t mode = mxIgraphModeFromOptions(opts);
   igraph_bool_t find_root = mxIgraphBoolFromOptions(opts, "findRoot");
   MXIGRAPH_CHECK_STATUS();
   igraph_integer_t root;
   igraph_bool_t flag;
 
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &graph, NULL, opts));
-  IGRAPH_FINALLY(igraph_destroy, &graph);
+  IGRAPH_CHECK(mxIgraphFromArrayCached(prhs[0], &graph, &weights, opts));
 
   if (find_root) {
-    IGRAPH_CHECK(igraph_is_tree(&graph, &flag, &root, mode));
+    IGRAPH_CHECK(igraph_is_tree(graph, &flag, &root, mode));
     plhs[0] = mxCreateDoubleScalar(flag ? root + 1 : 0);
   } else {
-    IGRAPH_CHECK(igraph_is_tree(&graph, &flag, NULL, mode));
+    IGRAPH_CHECK(igraph_is_tree(graph, &flag, NULL, mode));
     plhs[0] = mxCreateLogicalScalar(flag);
   }
 
-  igraph_destroy(&graph);
-  IGRAPH_FINALLY_CLEAN(1);
-
   return IGRAPH_SUCCESS;
 }
@@ -19,7 +19,6 @@
 #include "utils.h"
 
 #include <mxIgraph.h>
-#include <string.h>
 
 typedef enum {
   MXIGRAPH_LAYOUT_RANDOM = 0,
@@ -40,19 +39,17 @@ typedef enum {
 } mxIgraph_layout_t;
 
 static igraph_error_t set_pos_i(
-  mxArray const* opts, igraph_bool_t* use_seed, igraph_matrix_t* pos)
+  mxArray const* initial, igraph_bool_t* use_seed, igraph_matrix_t* pos)
 {
-  mxArray const* p = mxIgraphGetArgument(opts, "initial");
-  MXIGRAPH_CHECK_STATUS();
-  *use_seed = !mxIsEmpty(p);
+  *use_seed = initial && !mxIsEmpty(initial);
 
   if (!(*use_seed)) {
     return IGRAPH_SUCCESS;
   }
 
   igraph_matrix_t init;
-  igraph_integer_t n_nodes = mxGetM(p);
-  IGRAPH_CHECK(mxIgraphMatrixFromArray(p, &init, MXIGRAPH_IDX_KEEP));
+  igraph_integer_t n_nodes = mxGetM(initial);
+  IGRAPH_CHECK(mxIgraphMatrixFromArray(initial, &init, MXIGRAPH_IDX_KEEP));
   IGRAPH_FINALLY(igraph_matrix_destroy, &init);
   IGRAPH_CHECK(igraph_matrix_resize(pos, n_nodes, 2));
   for (igraph_integer_t j = 0; j < 2; j++) {
@@ -74,14 +71,27 @@ static igraph_error_t mxIgraph_random_i(igraph_t const* graph,
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  mxArray const* order;
+} mxIgraph_circle_opts_t;
+
+static mxIgraphOption_t circle_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_circle_opts_t, order, "order", ARRAY),
+};
+
 static igraph_error_t mxIgraph_circle_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
+  mxIgraph_circle_opts_t params;
   igraph_vector_int_t order;
   igraph_vs_t vs;
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromArray(opts, &order, MXIGRAPH_IDX_SHIFT));
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, circle_options_i, MXIGRAPH_N_OPTIONS(circle_options_i), &params));
+
+  IGRAPH_CHECK(
+    mxIgraphVectorIntFromArray(params.order, &order, MXIGRAPH_IDX_SHIFT));
   IGRAPH_FINALLY(igraph_vector_int_destroy, &order);
   IGRAPH_CHECK(igraph_vs_vector(&vs, &order));
   IGRAPH_FINALLY(igraph_vs_destroy, &vs);
@@ -95,18 +105,32 @@ static igraph_error_t mxIgraph_circle_i(igraph_t const* graph,
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t center;
+  mxArray const* order;
+} mxIgraph_star_opts_t;
+
+static mxIgraphOption_t star_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(
+    mxIgraph_star_opts_t, center, "center", INDEX, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(mxIgraph_star_opts_t, order, "order", ARRAY),
+};
+
 static igraph_error_t mxIgraph_star_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
-  igraph_integer_t center = mxIgraphIntegerFromOptions(opts, "center");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_star_opts_t params;
   igraph_vector_int_t order;
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromArray(opts, &order, MXIGRAPH_IDX_SHIFT));
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, star_options_i, MXIGRAPH_N_OPTIONS(star_options_i), &params));
+
+  IGRAPH_CHECK(
+    mxIgraphVectorIntFromArray(params.order, &order, MXIGRAPH_IDX_SHIFT));
   IGRAPH_FINALLY(igraph_vector_int_destroy, &order);
 
-  IGRAPH_CHECK(igraph_layout_star(graph, pos, center, &order));
+  IGRAPH_CHECK(igraph_layout_star(graph, pos, params.center, &order));
 
   igraph_vector_int_destroy(&order);
   IGRAPH_FINALLY_CLEAN(1);
@@ -114,54 +138,99 @@ static igraph_error_t mxIgraph_star_i(igraph_t const* graph,
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t width;
+} mxIgraph_grid_opts_t;
+
+static mxIgraphOption_t grid_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(
+    mxIgraph_grid_opts_t, width, "width", INTEGER, 0, IGRAPH_INFINITY),
+};
+
 static igraph_error_t mxIgraph_grid_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
-  igraph_integer_t width = mxIgraphIntegerFromOptions(opts, "width");
-  MXIGRAPH_CHECK_STATUS();
-  IGRAPH_CHECK(igraph_layout_grid(graph, pos, width));
+  mxIgraph_grid_opts_t params;
+
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, grid_options_i, MXIGRAPH_N_OPTIONS(grid_options_i), &params));
+  IGRAPH_CHECK(igraph_layout_grid(graph, pos, params.width));
+
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_iterations;
+  igraph_real_t charge;
+  igraph_real_t mass;
+  igraph_real_t spring_length;
+  igraph_real_t spring_constant;
+  igraph_real_t step_max;
+  mxArray const* initial;
+} mxIgraph_graphopt_opts_t;
+
+static mxIgraphOption_t graphopt_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_graphopt_opts_t, n_iterations,
+    "nIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(mxIgraph_graphopt_opts_t, charge, "charge", REAL),
+  MXIGRAPH_OPTION(mxIgraph_graphopt_opts_t, mass, "mass", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_graphopt_opts_t, spring_length, "springLength", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_graphopt_opts_t, spring_constant, "springConstant", REAL),
+  MXIGRAPH_OPTION(mxIgraph_graphopt_opts_t, step_max, "stepMax", REAL),
+  MXIGRAPH_OPTION(mxIgraph_graphopt_opts_t, initial, "initial", ARRAY),
+};
+
 static igraph_error_t mxIgraph_graphopt_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
-  igraph_integer_t n_iterations =
-    mxIgraphIntegerFromOptions(opts, "nIterations");
-  igraph_real_t node_charge = mxIgraphRealFromOptions(opts, "charge");
-  igraph_real_t node_mass = mxIgraphRealFromOptions(opts, "mass");
-  igraph_real_t spring_length = mxIgraphRealFromOptions(opts, "springLength");
-  igraph_real_t spring_constant =
-    mxIgraphRealFromOptions(opts, "springConstant");
-  igraph_real_t max_sa_movement = mxIgraphRealFromOptions(opts, "stepMax");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_graphopt_opts_t params;
   igraph_bool_t use_seed;
 
-  IGRAPH_CHECK(set_pos_i(opts, &use_seed, pos));
-  IGRAPH_CHECK(igraph_layout_graphopt(graph, pos, n_iterations, node_charge,
-    node_mass, spring_length, spring_constant, max_sa_movement, use_seed));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, graphopt_options_i,
+    MXIGRAPH_N_OPTIONS(graphopt_options_i), &params));
+
+  IGRAPH_CHECK(set_pos_i(params.initial, &use_seed, pos));
+  IGRAPH_CHECK(igraph_layout_graphopt(graph, pos, params.n_iterations,
+    params.charge, params.mass, params.spring_length, params.spring_constant,
+    params.step_max, use_seed));
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_real_t hgap;
+  igraph_real_t vgap;
+  igraph_integer_t max_iterations;
+  mxArray const* types;
+} mxIgraph_bipartite_opts_t;
+
+static mxIgraphOption_t bipartite_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_bipartite_opts_t, hgap, "hgap", REAL),
+  MXIGRAPH_OPTION(mxIgraph_bipartite_opts_t, vgap, "vgap", REAL),
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_bipartite_opts_t, max_iterations,
+    "maxIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(mxIgraph_bipartite_opts_t, types, "types", ARRAY),
+};
+
 static igraph_error_t mxIgraph_bipartite_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
+  mxIgraph_bipartite_opts_t params;
   igraph_vector_bool_t types;
-  igraph_real_t hgap = mxIgraphRealFromOptions(opts, "hgap");
-  igraph_real_t vgap = mxIgraphRealFromOptions(opts, "vgap");
-  igraph_real_t max_iterations =
-    mxIgraphIntegerFromOptions(opts, "maxIterations");
-  MXIGRAPH_CHECK_STATUS();
 
-  IGRAPH_CHECK(mxIgraphVectorBoolFromOptions(opts, "types", &types, false));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, bipartite_options_i,
+    MXIGRAPH_N_OPTIONS(bipartite_options_i), &params));
+
+  IGRAPH_CHECK(mxIgraphVectorBoolFromArray(params.types, &types, false));
   IGRAPH_FINALLY(igraph_vector_bool_destroy, &types);
 
-  IGRAPH_CHECK(
-    igraph_layout_bipartite(graph, &types, pos, hgap, vgap, max_iterations));
+  IGRAPH_CHECK(igraph_layout_bipartite(graph, &types, pos, params.hgap,
+    params.vgap, params.max_iterations));
 
   igraph_vector_bool_destroy(&types);
   IGRAPH_FINALLY_CLEAN(1);
@@ -169,101 +238,163 @@ static igraph_error_t mxIgraph_bipartite_i(igraph_t const* graph,
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_iterations;
+  igraph_real_t start_temp;
+  igraph_integer_t grid;
+  mxArray const* initial;
+} mxIgraph_fruchterman_reingold_opts_t;
+
+static char const* const grid_methods_i[] = {
+  [IGRAPH_LAYOUT_GRID] = "grid",
+  [IGRAPH_LAYOUT_NOGRID] = "nogrid",
+  [IGRAPH_LAYOUT_AUTOGRID] = "auto",
+};
+
+static mxIgraphOption_t fruchterman_reingold_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_fruchterman_reingold_opts_t, n_iterations,
+    "nIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(
+    mxIgraph_fruchterman_reingold_opts_t, start_temp, "startTemp", REAL),
+  MXIGRAPH_OPTION_CHOICES(
+    mxIgraph_fruchterman_reingold_opts_t, grid, "grid", grid_methods_i),
+  MXIGRAPH_OPTION(
+    mxIgraph_fruchterman_reingold_opts_t, initial, "initial", ARRAY),
+};
+
 static igraph_error_t mxIgraph_fruchterman_reingold_i(igraph_t const* graph,
   igraph_vector_t const* weights, mxArray const* opts, igraph_matrix_t* pos)
 {
-  igraph_integer_t n_iter = mxIgraphIntegerFromOptions(opts, "nIterations");
-  igraph_real_t start_temp = mxIgraphRealFromOptions(opts, "startTemp");
-  char const* grid_method = mxIgraphStringFromOptions(opts, "grid");
-  MXIGRAPH_CHECK_STATUS();
-
+  mxIgraph_fruchterman_reingold_opts_t params;
   igraph_bool_t use_seed;
-  igraph_layout_grid_t grid;
 
-  IGRAPH_CHECK(set_pos_i(opts, &use_seed, pos));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, fruchterman_reingold_options_i,
+    MXIGRAPH_N_OPTIONS(fruchterman_reingold_options_i), &params));
 
-  if (strcmp(grid_method, "auto") == 0) {
-    grid = IGRAPH_LAYOUT_AUTOGRID;
-  } else if (strcmp(grid_method, "grid") == 0) {
-    grid = IGRAPH_LAYOUT_GRID;
-  } else if (strcmp(grid_method, "nogrid") == 0) {
-    grid = IGRAPH_LAYOUT_NOGRID;
-  } else {
-    IGRAPH_FATALF(
-      "Fruchtermen-Reingold layout got unexpected grid method \"%s\"",
-      grid_method);
-  }
+  IGRAPH_CHECK(set_pos_i(params.initial, &use_seed, pos));
 
-  IGRAPH_CHECK(igraph_layout_fruchterman_reingold(graph, pos, use_seed, n_iter,
-    start_temp, grid, weights, NULL, NULL, NULL, NULL));
+  IGRAPH_CHECK(igraph_layout_fruchterman_reingold(graph, pos, use_seed,
+    params.n_iterations, params.start_temp,
+    (igraph_layout_grid_t)params.grid, weights, NULL, NULL, NULL, NULL));
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t max_iterations;
+  igraph_real_t epsilon;
+  igraph_real_t constant;
+  mxArray const* initial;
+} mxIgraph_kamada_kawai_opts_t;
+
+static mxIgraphOption_t kamada_kawai_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_kamada_kawai_opts_t, max_iterations,
+    "maxIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(mxIgraph_kamada_kawai_opts_t, epsilon, "epsilon", REAL),
+  MXIGRAPH_OPTION(mxIgraph_kamada_kawai_opts_t, constant, "constant", REAL),
+  MXIGRAPH_OPTION(mxIgraph_kamada_kawai_opts_t, initial, "initial", ARRAY),
+};
+
 static igraph_error_t mxIgraph_kamada_kawai_i(igraph_t const* graph,
   igraph_vector_t const* weights, mxArray const* opts, igraph_matrix_t* pos)
 {
-  igraph_integer_t max_iter =
-    mxIgraphIntegerFromOptions(opts, "maxIterations");
-  igraph_real_t epsilon = mxIgraphRealFromOptions(opts, "epsilon");
-  igraph_real_t kkconst = mxIgraphRealFromOptions(opts, "constant");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_kamada_kawai_opts_t params;
   igraph_bool_t use_seed;
 
-  IGRAPH_CHECK(set_pos_i(opts, &use_seed, pos));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, kamada_kawai_options_i,
+    MXIGRAPH_N_OPTIONS(kamada_kawai_options_i), &params));
 
-  IGRAPH_CHECK(igraph_layout_kamada_kawai(graph, pos, use_seed, max_iter,
-    epsilon, kkconst, weights, NULL, NULL, NULL, NULL));
+  IGRAPH_CHECK(set_pos_i(params.initial, &use_seed, pos));
+
+  IGRAPH_CHECK(igraph_layout_kamada_kawai(graph, pos, use_seed,
+    params.max_iterations, params.epsilon, params.constant, weights, NULL,
+    NULL, NULL, NULL));
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t max_iterations;
+  igraph_real_t temp_max;
+  igraph_real_t temp_min;
+  igraph_real_t temp_init;
+  mxArray const* initial;
+} mxIgraph_gem_opts_t;
+
+static mxIgraphOption_t gem_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_gem_opts_t, max_iterations,
+    "maxIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(mxIgraph_gem_opts_t, temp_max, "tempMax", REAL),
+  MXIGRAPH_OPTION(mxIgraph_gem_opts_t, temp_min, "tempMin", REAL),
+  MXIGRAPH_OPTION(mxIgraph_gem_opts_t, temp_init, "tempInit", REAL),
+  MXIGRAPH_OPTION(mxIgraph_gem_opts_t, initial, "initial", ARRAY),
+};
+
 static igraph_error_t mxIgraph_gem_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
-  igraph_integer_t max_iter =
-    mxIgraphIntegerFromOptions(opts, "maxIterations");
-  igraph_real_t temp_max = mxIgraphRealFromOptions(opts, "tempMax");
-  igraph_real_t temp_min = mxIgraphRealFromOptions(opts, "tempMin");
-  igraph_real_t temp_init = mxIgraphRealFromOptions(opts, "tempInit");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_gem_opts_t params;
   igraph_bool_t use_seed;
 
-  IGRAPH_CHECK(set_pos_i(opts, &use_seed, pos));
-  IGRAPH_CHECK(igraph_layout_gem(
-    graph, pos, use_seed, max_iter, temp_max, temp_min, temp_init));
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, gem_options_i, MXIGRAPH_N_OPTIONS(gem_options_i), &params));
+
+  IGRAPH_CHECK(set_pos_i(params.initial, &use_seed, pos));
+  IGRAPH_CHECK(igraph_layout_gem(graph, pos, use_seed, params.max_iterations,
+    params.temp_max, params.temp_min, params.temp_init));
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t max_iterations;
+  igraph_integer_t fine_iterations;
+  igraph_real_t cooling_factor;
+  igraph_real_t weight_node_dist;
+  igraph_real_t weight_border;
+  igraph_real_t weight_edge_lengths;
+  igraph_real_t weight_edge_crossings;
+  igraph_real_t weight_node_edge_dist;
+  mxArray const* initial;
+} mxIgraph_davidson_harel_opts_t;
+
+static mxIgraphOption_t davidson_harel_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_davidson_harel_opts_t, max_iterations,
+    "maxIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_davidson_harel_opts_t, fine_iterations,
+    "fineIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(mxIgraph_davidson_harel_opts_t, cooling_factor,
+    "coolingFactor", REAL),
+  MXIGRAPH_OPTION(mxIgraph_davidson_harel_opts_t, weight_node_dist,
+    "weightNodeDist", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_davidson_harel_opts_t, weight_border, "weightBorder", REAL),
+  MXIGRAPH_OPTION(mxIgraph_davidson_harel_opts_t, weight_edge_lengths,
+    "weightEdgeLen", REAL),
+  MXIGRAPH_OPTION(mxIgraph_davidson_harel_opts_t, weight_edge_crossings,
+    "weightEdgeCross", REAL),
+  MXIGRAPH_OPTION(mxIgraph_davidson_harel_opts_t, weight_node_edge_dist,
+    "weightNodeEdgeDist", REAL),
+  MXIGRAPH_OPTION(mxIgraph_davidson_harel_opts_t, initial, "initial", ARRAY),
+};
+
 static igraph_error_t mxIgraph_davidson_harel_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
-  igraph_integer_t max_iter =
-    mxIgraphIntegerFromOptions(opts, "maxIterations");
-  igraph_integer_t fine_iter =
-    mxIgraphIntegerFromOptions(opts, "fineIterations");
-  igraph_real_t cool_factor = mxIgraphRealFromOptions(opts, "coolingFactor");
-  igraph_real_t weight_node_dist =
-    mxIgraphRealFromOptions(opts, "weightNodeDist");
-  igraph_real_t weight_border = mxIgraphRealFromOptions(opts, "weightBorder");
-  igraph_real_t weight_edge_lengths =
-    mxIgraphRealFromOptions(opts, "weightEdgeLen");
-  igraph_real_t weight_edge_crossings =
-    mxIgraphRealFromOptions(opts, "weightEdgeCross");
-  igraph_real_t weight_node_edge_dist =
-    mxIgraphRealFromOptions(opts, "weightNodeEdgeDist");
-  MXIGRAPH_CHECK_STATUS();
-
+  mxIgraph_davidson_harel_opts_t params;
   igraph_bool_t use_seed;
 
-  IGRAPH_CHECK(set_pos_i(opts, &use_seed, pos));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, davidson_harel_options_i,
+    MXIGRAPH_N_OPTIONS(davidson_harel_options_i), &params));
+
+  IGRAPH_CHECK(set_pos_i(params.initial, &use_seed, pos));
 
-  IGRAPH_CHECK(igraph_layout_davidson_harel(graph, pos, use_seed, max_iter,
-    fine_iter, cool_factor, weight_node_dist, weight_border,
-    weight_edge_lengths, weight_edge_crossings, weight_node_edge_dist));
+  IGRAPH_CHECK(igraph_layout_davidson_harel(graph, pos, use_seed,
+    params.max_iterations, params.fine_iterations, params.cooling_factor,
+    params.weight_node_dist, params.weight_border, params.weight_edge_lengths,
+    params.weight_edge_crossings, params.weight_node_edge_dist));
 
   return IGRAPH_SUCCESS;
 }
@@ -289,61 +420,94 @@ static igraph_error_t mxIgraph_mds_i(igraph_t const* graph,
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t max_iterations;
+  igraph_real_t step_max;
+  igraph_real_t area;
+  igraph_real_t cool_exp;
+  igraph_real_t repulse_radius;
+  igraph_real_t cell_size;
+  igraph_integer_t root;
+} mxIgraph_lgl_opts_t;
+
+static mxIgraphOption_t lgl_options_i[] = {
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_lgl_opts_t, max_iterations,
+    "maxIterations", INTEGER, 1, IGRAPH_INFINITY),
+  MXIGRAPH_OPTION(mxIgraph_lgl_opts_t, step_max, "stepMax", REAL),
+  MXIGRAPH_OPTION(mxIgraph_lgl_opts_t, area, "area", REAL),
+  MXIGRAPH_OPTION(mxIgraph_lgl_opts_t, cool_exp, "coolExp", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_lgl_opts_t, repulse_radius, "repulseRadius", REAL),
+  MXIGRAPH_OPTION(mxIgraph_lgl_opts_t, cell_size, "cellSize", REAL),
+  MXIGRAPH_OPTION_BOUNDED(
+    mxIgraph_lgl_opts_t, root, "root", INDEX, 1, IGRAPH_INFINITY),
+};
+
 static igraph_error_t mxIgraph_lgl_i(igraph_t const* graph,
   igraph_vector_t const* UNUSED(weights), mxArray const* opts,
   igraph_matrix_t* pos)
 {
-  igraph_integer_t max_iter =
-    mxIgraphIntegerFromOptions(opts, "maxIterations");
-  igraph_real_t max_delta = mxIgraphRealFromOptions(opts, "stepMax");
-  igraph_real_t area = mxIgraphRealFromOptions(opts, "area");
-  igraph_real_t coolexp = mxIgraphRealFromOptions(opts, "coolExp");
-  igraph_real_t repulserad = mxIgraphRealFromOptions(opts, "repulseRadius");
-  igraph_real_t cellsize = mxIgraphRealFromOptions(opts, "cellSize");
-  igraph_integer_t root = mxIgraphIntegerFromOptions(opts, "root");
-  MXIGRAPH_CHECK_STATUS();
-
-  IGRAPH_CHECK(igraph_layout_lgl(graph, pos, max_iter, max_delta, area,
-    coolexp, repulserad, cellsize, root));
+  mxIgraph_lgl_opts_t params;
+
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, lgl_options_i, MXIGRAPH_N_OPTIONS(lgl_options_i), &params));
+
+  IGRAPH_CHECK(igraph_layout_lgl(graph, pos, params.max_iterations,
+    params.step_max, params.area, params.cool_exp, params.repulse_radius,
+    params.cell_size, params.root));
 
   return IGRAPH_SUCCESS;
 }
 
-static igraph_error_t mxIgraph_reingold_tilford_i(igraph_t const* graph,
-  igraph_vector_t const* UNUSED(weights), mxArray const* opts,
-  igraph_matrix_t* pos)
+typedef struct {
+  igraph_neimode_t mode;
+  mxArray const* roots;
+} mxIgraph_reingold_tilford_opts_t;
+
+static mxIgraphOption_t reingold_tilford_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_reingold_tilford_opts_t, mode, "mode", MODE),
+  MXIGRAPH_OPTION(mxIgraph_reingold_tilford_opts_t, roots, "root", ARRAY),
+};
+
+static igraph_error_t reingold_tilford_i(igraph_t const* graph,
+  mxArray const* opts, igraph_matrix_t* pos, igraph_bool_t const circular)
 {
-  igraph_neimode_t mode = mxIgraphModeFromOptions(opts);
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_reingold_tilford_opts_t params;
   igraph_vector_int_t roots;
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromArray(opts, &roots, MXIGRAPH_IDX_SHIFT));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, reingold_tilford_options_i,
+    MXIGRAPH_N_OPTIONS(reingold_tilford_options_i), &params));
+
+  IGRAPH_CHECK(
+    mxIgraphVectorIntFromArray(params.roots, &roots, MXIGRAPH_IDX_SHIFT));
   IGRAPH_FINALLY(igraph_vector_int_destroy, &roots);
 
-  IGRAPH_CHECK(igraph_layout_reingold_tilford(graph, pos, mode, &roots, NULL));
+  if (circular) {
+    IGRAPH_CHECK(igraph_layout_reingold_tilford_circular(
+      graph, pos, params.mode, &roots, NULL));
+  } else {
+    IGRAPH_CHECK(igraph_layout_reingold_tilford(
+      graph, pos, params.mode, &roots, NULL));
+  }
+
   igraph_vector_int_destroy(&roots);
   IGRAPH_FINALLY_CLEAN(1);
 
   return IGRAPH_SUCCESS;
 }
 
+static igraph_error_t mxIgraph_reingold_tilford_i(igraph_t const* graph,
+  igraph_vector_t const* UNUSED(weights), mxArray const* opts,
+  igraph_matrix_t* pos)
+{
+  return reingold_tilford_i(graph, opts, pos, false);
+}
+
 static igraph_error_t mxIgraph_reingold_tilford_circular_i(
   igraph_t const* graph, igraph_vector_t const* UNUSED(weights),
   mxArray const* opts, igraph_matrix_t* pos)
 {
-  igraph_neimode_t mode = mxIgraphModeFromOptions(opts);
-  MXIGRAPH_CHECK_STATUS();
-  igraph_vector_int_t roots;
-
-  IGRAPH_CHECK(mxIgraphVectorIntFromArray(opts, &roots, MXIGRAPH_IDX_SHIFT));
-  IGRAPH_FINALLY(igraph_vector_int_destroy, &roots);
-
-  IGRAPH_CHECK(
-    igraph_layout_reingold_tilford_circular(graph, pos, mode, &roots, NULL));
-  igraph_vector_int_destroy(&roots);
-  IGRAPH_FINALLY_CLEAN(1);
-
-  return IGRAPH_SUCCESS;
+  return reingold_tilford_i(graph, opts, pos, true);
 }
 
 igraph_error_t mexIgraphLayout(
@@ -352,8 +516,8 @@ igraph_error_t mexIgraphLayout(
   VERIFY_N_INPUTS_EQUAL(4);
   VERIFY_N_OUTPUTS_EQUAL(1);
 
-  igraph_t graph;
-  igraph_vector_t weights;
+  igraph_t const* graph;
+  igraph_vector_t const* weights;
   mxArray const* graph_options = prhs[2];
   mxIgraph_layout_t method;
   mxArray const* method_options = prhs[3];
@@ -362,7 +526,7 @@ igraph_error_t mexIgraphLayout(
     igraph_t const*, igraph_vector_t const*, mxArray const*, igraph_matrix_t*);
   layout_method_t layout_method;
 
-  char const* methods[MXIGRAPH_LAYOUT_N] = {
+  static char const* const methods[MXIGRAPH_LAYOUT_N] = {
     [MXIGRAPH_LAYOUT_RANDOM] = "random",
     [MXIGRAPH_LAYOUT_CIRCLE] = "circle",
     [MXIGRAPH_LAYOUT_STAR] = "star",
@@ -406,20 +570,17 @@ igraph_error_t mexIgraphLayout(
       IGRAPH_UNIMPLEMENTED, mxArrayToString(prhs[1]));
   }
 
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &graph, &weights, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph);
-  IGRAPH_FINALLY(igraph_vector_destroy, &weights);
+  IGRAPH_CHECK(
+    mxIgraphFromArrayCached(prhs[0], &graph, &weights, graph_options));
   IGRAPH_CHECK(igraph_matrix_init(&pos, 0, 0));
   IGRAPH_FINALLY(igraph_matrix_destroy, &pos);
 
   IGRAPH_CHECK(
-    layout_method(&graph, MXIGRAPH_WEIGHTS(&weights), method_options, &pos));
-  igraph_destroy(&graph);
-  igraph_vector_destroy(&weights);
+    layout_method(graph, MXIGRAPH_WEIGHTS(weights), method_options, &pos));
 
   plhs[0] = mxIgraphMatrixToArray(&pos, MXIGRAPH_IDX_KEEP);
   igraph_matrix_destroy(&pos);
-  IGRAPH_FINALLY_CLEAN(3);
+  IGRAPH_FINALLY_CLEAN(1);
 
   return IGRAPH_SUCCESS;
 }
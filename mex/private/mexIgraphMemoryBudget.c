@@ -0,0 +1,64 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "utils.h"
+
+#include <mxIgraph.h>
+
+igraph_error_t mexIgraphMemoryBudget(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(2);
+  VERIFY_N_OUTPUTS_ATMOST(1);
+
+  typedef enum {
+    MXIGRAPH_BUDGET_GET = 0,
+    MXIGRAPH_BUDGET_SET,
+    MXIGRAPH_BUDGET_DEFAULT,
+    MXIGRAPH_BUDGET_N
+  } mxIgraph_budget_action_t;
+
+  mxIgraph_budget_action_t action;
+  static char const* const actions[MXIGRAPH_BUDGET_N] = {
+    [MXIGRAPH_BUDGET_GET] = "get",
+    [MXIGRAPH_BUDGET_SET] = "set",
+    [MXIGRAPH_BUDGET_DEFAULT] = "default",
+  };
+
+  action = mxIgraphSelectMethod(prhs[0], actions, MXIGRAPH_BUDGET_N);
+  MXIGRAPH_CHECK_METHOD(action, prhs[0]);
+
+  switch (action) {
+    case MXIGRAPH_BUDGET_GET:
+      break;
+    case MXIGRAPH_BUDGET_SET:
+      mxIgraphSetMemoryBudget(mxGetScalar(prhs[1]));
+      break;
+    case MXIGRAPH_BUDGET_DEFAULT:
+      mxIgraphSetMemoryBudget(-1);
+      break;
+    default:
+      IGRAPH_FATAL("Got an unexpected memory budget action.");
+  }
+
+  if (nlhs == 1) {
+    plhs[0] = mxCreateDoubleScalar(mxIgraphMemoryBudget());
+  }
+
+  return IGRAPH_SUCCESS;
+}
@@ -19,42 +19,241 @@
 #include "utils.h"
 
 #include <mxIgraph.h>
+#include <string.h>
+
+/* State for scoring many partitions of one graph at several resolutions.
+
+ Node strengths and the total edge weight do not depend on the partition,
+ so they are computed once. Each partition then needs a single pass over
+ the edges to sum the weight inside its communities. Community strengths
+ come from the node strengths, and every resolution is scored from the same
+ sums. Follows igraph_modularity, except that the partition is scored at
+ every resolution at once.
+
+ Partitions are stored one per column. The per-community contributions of
+ partition p are stored in contrib starting at contrib_offsets[p], as an
+ n_comms x n_res column major matrix. */
+typedef struct {
+  igraph_t const* graph;
+  igraph_vector_t const* weights;
+  igraph_bool_t directed;
+  igraph_real_t total_weight;
+  igraph_vector_t out_strength;
+  igraph_vector_t in_strength;
+  igraph_vector_t resolutions;
+  igraph_matrix_int_t memberships;
+  igraph_vector_int_t n_comms;
+  igraph_vector_int_t contrib_offsets;
+  igraph_vector_t contrib;
+  igraph_matrix_t modularity;
+} mxIgraph_modularity_t;
+
+static void modularity_destroy_i(mxIgraph_modularity_t* mod)
+{
+  igraph_vector_destroy(&mod->out_strength);
+  igraph_vector_destroy(&mod->in_strength);
+  igraph_vector_destroy(&mod->resolutions);
+  igraph_matrix_int_destroy(&mod->memberships);
+  igraph_vector_int_destroy(&mod->n_comms);
+  igraph_vector_int_destroy(&mod->contrib_offsets);
+  igraph_vector_destroy(&mod->contrib);
+  igraph_matrix_destroy(&mod->modularity);
+}
+
+static igraph_error_t modularity_strength_i(mxIgraph_modularity_t* mod)
+{
+  igraph_integer_t const n_edges = igraph_ecount(mod->graph);
+
+  mod->total_weight = 0;
+  for (igraph_integer_t eid = 0; eid < n_edges; eid++) {
+    igraph_real_t const w = mod->weights ? VECTOR(*mod->weights)[eid] : 1;
+
+    if (w < 0) {
+      IGRAPH_ERROR("Negative weight in weight vector.", IGRAPH_EINVAL);
+    }
+
+    VECTOR(mod->out_strength)[IGRAPH_FROM(mod->graph, eid)] += w;
+    VECTOR(mod->in_strength)[IGRAPH_TO(mod->graph, eid)] += w;
+    mod->total_weight += w;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Validate every partition and find its number of communities. Community
+ IDs are kept as given so contributions line up with the caller's IDs. */
+static igraph_error_t modularity_index_i(mxIgraph_modularity_t* mod)
+{
+  igraph_integer_t const n_nodes = igraph_matrix_int_nrow(&mod->memberships);
+  igraph_integer_t const n_parts = igraph_matrix_int_ncol(&mod->memberships);
+  igraph_integer_t const n_res = igraph_vector_size(&mod->resolutions);
+  igraph_integer_t offset = 0;
+
+  if (n_nodes != igraph_vcount(mod->graph)) {
+    IGRAPH_ERROR("Membership vector size differs from number of vertices.",
+      IGRAPH_EINVAL);
+  }
+
+  IGRAPH_CHECK(igraph_vector_int_resize(&mod->n_comms, n_parts));
+  IGRAPH_CHECK(igraph_vector_int_resize(&mod->contrib_offsets, n_parts));
+  for (igraph_integer_t p = 0; p < n_parts; p++) {
+    igraph_integer_t const* memb = &MATRIX(mod->memberships, 0, p);
+    igraph_integer_t n_comms = 0;
+
+    for (igraph_integer_t i = 0; i < n_nodes; i++) {
+      if (memb[i] < 0) {
+        IGRAPH_ERROR("Invalid membership vector: negative entry.",
+          IGRAPH_EINVAL);
+      }
+      n_comms = memb[i] >= n_comms ? memb[i] + 1 : n_comms;
+    }
+
+    VECTOR(mod->n_comms)[p] = n_comms;
+    VECTOR(mod->contrib_offsets)[p] = offset;
+    offset += n_comms * n_res;
+  }
+
+  IGRAPH_CHECK(igraph_vector_resize(&mod->contrib, offset));
+  IGRAPH_CHECK(igraph_matrix_resize(&mod->modularity, n_parts, n_res));
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t modularity_task_i(
+  igraph_integer_t task, igraph_integer_t UNUSED(thread), void* data)
+{
+  mxIgraph_modularity_t* mod = data;
+  igraph_integer_t const n_nodes = igraph_vcount(mod->graph);
+  igraph_integer_t const n_edges = igraph_ecount(mod->graph);
+  igraph_integer_t const n_res = igraph_vector_size(&mod->resolutions);
+  igraph_integer_t const n_comms = VECTOR(mod->n_comms)[task];
+  igraph_integer_t const* memb = &MATRIX(mod->memberships, 0, task);
+  igraph_real_t* contrib =
+    VECTOR(mod->contrib) + VECTOR(mod->contrib_offsets)[task];
+  igraph_real_t const multiplier = mod->directed ? 1 : 2;
+  igraph_real_t const scale = 1 / (multiplier * mod->total_weight);
+  igraph_vector_t internal;
+  igraph_vector_t k_out;
+  igraph_vector_t k_in;
+
+  IGRAPH_VECTOR_INIT_FINALLY(&internal, n_comms);
+  IGRAPH_VECTOR_INIT_FINALLY(&k_out, n_comms);
+  IGRAPH_VECTOR_INIT_FINALLY(&k_in, n_comms);
+
+  for (igraph_integer_t eid = 0; eid < n_edges; eid++) {
+    igraph_integer_t const c = memb[IGRAPH_FROM(mod->graph, eid)];
+    igraph_real_t const w = mod->weights ? VECTOR(*mod->weights)[eid] : 1;
+    if (c == memb[IGRAPH_TO(mod->graph, eid)]) {
+      VECTOR(internal)[c] += w;
+    }
+  }
+
+  for (igraph_integer_t i = 0; i < n_nodes; i++) {
+    VECTOR(k_out)[memb[i]] += VECTOR(mod->out_strength)[i];
+    VECTOR(k_in)[memb[i]] += VECTOR(mod->in_strength)[i];
+  }
+
+  if (!mod->directed) {
+    IGRAPH_CHECK(igraph_vector_add(&k_out, &k_in));
+    IGRAPH_CHECK(igraph_vector_update(&k_in, &k_out));
+  }
+
+  /* Modularity is undefined without edge weight, as in igraph. */
+  for (igraph_integer_t r = 0; r < n_res; r++) {
+    igraph_real_t const resolution = VECTOR(mod->resolutions)[r];
+    igraph_real_t q = mod->total_weight > 0 ? 0 : IGRAPH_NAN;
+
+    for (igraph_integer_t c = 0; c < n_comms; c++) {
+      igraph_real_t const e = multiplier * VECTOR(internal)[c] * scale;
+      igraph_real_t const a_out = VECTOR(k_out)[c] * scale;
+      igraph_real_t const a_in = VECTOR(k_in)[c] * scale;
+
+      contrib[c + (r * n_comms)] = e - (resolution * a_out * a_in);
+      q += contrib[c + (r * n_comms)];
+    }
+
+    MATRIX(mod->modularity, task, r) = q;
+  }
+
+  igraph_vector_destroy(&internal);
+  igraph_vector_destroy(&k_out);
+  igraph_vector_destroy(&k_in);
+  IGRAPH_FINALLY_CLEAN(3);
+
+  return IGRAPH_SUCCESS;
+}
+
+static mxArray* modularity_contrib_to_array_i(mxIgraph_modularity_t const* mod)
+{
+  igraph_integer_t const n_parts = igraph_matrix_int_ncol(&mod->memberships);
+  igraph_integer_t const n_res = igraph_vector_size(&mod->resolutions);
+  mxArray* p = mxCreateCellMatrix(n_parts, 1);
+
+  for (igraph_integer_t i = 0; i < n_parts; i++) {
+    igraph_integer_t const n_comms = VECTOR(mod->n_comms)[i];
+    mxArray* contrib = mxCreateDoubleMatrix(n_comms, n_res, mxREAL);
+    memcpy(mxGetDoubles(contrib),
+      VECTOR(mod->contrib) + VECTOR(mod->contrib_offsets)[i],
+      sizeof(igraph_real_t) * n_comms * n_res);
+    mxSetCell(p, i, contrib);
+  }
+
+  return p;
+}
 
 igraph_error_t mexIgraphModularity(
   int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
 {
   VERIFY_N_INPUTS_EQUAL(4);
-  VERIFY_N_OUTPUTS_EQUAL(1);
+  VERIFY_N_OUTPUTS_ATMOST(2);
 
   mxArray const* graph_options = prhs[2];
   mxArray const* method_options = prhs[3];
 
-  igraph_t graph;
-  igraph_vector_t weights;
-  igraph_vector_int_t membership;
-  igraph_real_t resolution =
-    mxIgraphRealFromOptions(method_options, "resolution");
-  igraph_bool_t directed =
-    mxIgraphBoolFromOptions(graph_options, "isdirected");
-  igraph_real_t modularity;
+  mxIgraph_modularity_t mod;
+  igraph_integer_t failed;
+  igraph_error_t rs;
   MXIGRAPH_CHECK_STATUS();
 
-  IGRAPH_CHECK(mxIgraphFromArray(prhs[0], &graph, &weights, graph_options));
-  IGRAPH_FINALLY(igraph_destroy, &graph);
-  IGRAPH_FINALLY(igraph_vector_destroy, &weights);
-  IGRAPH_CHECK(
-    mxIgraphVectorIntFromArray(prhs[1], &membership, MXIGRAPH_IDX_SHIFT));
-  IGRAPH_FINALLY(igraph_vector_int_destroy, &membership);
+  IGRAPH_CHECK(mxIgraphFromArrayCached(
+    prhs[0], &mod.graph, &mod.weights, graph_options));
+  mod.weights = MXIGRAPH_WEIGHTS(mod.weights);
+  mod.directed = igraph_is_directed(mod.graph);
 
-  IGRAPH_CHECK(igraph_modularity(&graph, &membership,
-    MXIGRAPH_WEIGHTS(&weights), resolution, directed, &modularity));
+  IGRAPH_VECTOR_INIT_FINALLY(&mod.out_strength, igraph_vcount(mod.graph));
+  IGRAPH_VECTOR_INIT_FINALLY(&mod.in_strength, igraph_vcount(mod.graph));
+  IGRAPH_CHECK(mxIgraphVectorFromOptions(
+    method_options, "resolution", &mod.resolutions, MXIGRAPH_IDX_KEEP));
+  IGRAPH_FINALLY(igraph_vector_destroy, &mod.resolutions);
+  IGRAPH_CHECK(mxIgraphMatrixIntFromArray(
+    prhs[1], &mod.memberships, MXIGRAPH_IDX_SHIFT));
+  IGRAPH_FINALLY(igraph_matrix_int_destroy, &mod.memberships);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&mod.n_comms, 0);
+  IGRAPH_VECTOR_INT_INIT_FINALLY(&mod.contrib_offsets, 0);
+  IGRAPH_VECTOR_INIT_FINALLY(&mod.contrib, 0);
+  IGRAPH_MATRIX_INIT_FINALLY(&mod.modularity, 0, 0);
 
-  plhs[0] = mxCreateDoubleScalar(modularity);
+  IGRAPH_CHECK(modularity_strength_i(&mod));
+  IGRAPH_CHECK(modularity_index_i(&mod));
 
-  igraph_vector_int_destroy(&membership);
-  igraph_vector_destroy(&weights);
-  igraph_destroy(&graph);
-  IGRAPH_FINALLY_CLEAN(3);
+  IGRAPH_FINALLY_CLEAN(8);
+  rs = mxIgraphBatchRun(igraph_matrix_int_ncol(&mod.memberships),
+    modularity_task_i, &mod, &failed);
+  if (rs != IGRAPH_SUCCESS) {
+    modularity_destroy_i(&mod);
+    IGRAPH_ERRORF("Failed to score partition %" IGRAPH_PRId ". %s", rs,
+      failed + 1, mxIgraphBatchError());
+  }
+  IGRAPH_FINALLY(modularity_destroy_i, &mod);
+
+  plhs[0] = mxIgraphMatrixToArray(&mod.modularity, MXIGRAPH_IDX_KEEP);
+
+  if (nlhs > 1) {
+    plhs[1] = modularity_contrib_to_array_i(&mod);
+  }
+
+  modularity_destroy_i(&mod);
+  IGRAPH_FINALLY_CLEAN(1);
 
   return IGRAPH_SUCCESS;
 }
@@ -43,7 +43,7 @@ igraph_error_t mexIgraphRNG(
   mxArray const* generator_name = prhs[1];
   igraph_integer_t generator;
 
-  char const* generators[MXIGRAPH_GENERATOR_N] = {
+  static char const* const generators[MXIGRAPH_GENERATOR_N] = {
     [MXIGRAPH_GENERATOR_MATLAB] = "matlab",
     [MXIGRAPH_GENERATOR_MT19937] = "mt19937",
     [MXIGRAPH_GENERATOR_GLIBC2] = "glibc2",
@@ -97,3 +97,42 @@ igraph_error_t mexIgraphRNG(
 
   return IGRAPH_SUCCESS;
 }
+
+igraph_error_t mexIgraphRNGBuffer(
+  int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  VERIFY_N_INPUTS_EQUAL(2);
+  VERIFY_N_OUTPUTS_ATMOST(1);
+
+  typedef enum {
+    MXIGRAPH_RNG_BUFFER_GET = 0,
+    MXIGRAPH_RNG_BUFFER_SET,
+    MXIGRAPH_RNG_BUFFER_N
+  } mxIgraph_rng_buffer_action_t;
+
+  mxIgraph_rng_buffer_action_t action;
+  static char const* const actions[MXIGRAPH_RNG_BUFFER_N] = {
+    [MXIGRAPH_RNG_BUFFER_GET] = "get",
+    [MXIGRAPH_RNG_BUFFER_SET] = "set",
+  };
+
+  action = mxIgraphSelectMethod(prhs[0], actions, MXIGRAPH_RNG_BUFFER_N);
+  MXIGRAPH_CHECK_METHOD(action, prhs[0]);
+
+  switch (action) {
+    case MXIGRAPH_RNG_BUFFER_GET:
+      break;
+    case MXIGRAPH_RNG_BUFFER_SET:
+      IGRAPH_CHECK(
+        mxIgraphSetRNGBufferSize((igraph_integer_t)mxGetScalar(prhs[1])));
+      break;
+    default:
+      IGRAPH_FATAL("Got an unexpected RNG buffer action.");
+  }
+
+  if (nlhs == 1) {
+    plhs[0] = mxCreateDoubleScalar(mxIgraphRNGBufferSize());
+  }
+
+  return IGRAPH_SUCCESS;
+}
@@ -57,117 +57,187 @@ typedef enum {
   MXIGRAPH_GAME_N
 } mxIgraph_game_t;
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_real_t radius;
+  igraph_bool_t torus;
+} mxIgraph_grg_opts_t;
+
+static mxIgraphOption_t grg_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_grg_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_grg_opts_t, radius, "radius", REAL),
+  MXIGRAPH_OPTION(mxIgraph_grg_opts_t, torus, "torus", BOOL),
+};
+
 static igraph_error_t mxIgraph_grg_i(mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_real_t radius = mxIgraphRealFromOptions(opts, "radius");
-  igraph_bool_t torus = mxIgraphBoolFromOptions(opts, "torus");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_grg_opts_t params;
+
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, grg_options_i, MXIGRAPH_N_OPTIONS(grg_options_i), &params));
 
-  IGRAPH_CHECK(igraph_grg_game(graph, n_nodes, radius, torus, NULL, NULL));
+  IGRAPH_CHECK(igraph_grg_game(
+    graph, params.n_nodes, params.radius, params.torus, NULL, NULL));
 
   return IGRAPH_SUCCESS;
 }
 
-#define BARABASI_BODY(algo)                                                   \
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");      \
-  igraph_real_t power = mxIgraphRealFromOptions(opts, "power");               \
-  igraph_integer_t m = 0;                                                     \
-  igraph_vector_int_t outseq;                                                 \
-  igraph_vector_int_t* outseq_ptr = NULL;                                     \
-  igraph_bool_t outpref = mxIgraphBoolFromOptions(opts, "outPreference");     \
-  igraph_real_t A = mxIgraphRealFromOptions(opts, "attractiveness");          \
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");       \
-  mxArray* start_argument = mxIgraphGetArgument(opts, "startFrom");           \
-  igraph_t start_from;                                                        \
-  igraph_t* start_from_ptr = NULL;                                            \
-  MXIGRAPH_CHECK_STATUS();                                                    \
-                                                                              \
-  if (mxIsScalar(mxIgraphGetArgument(opts, "nConnections"))) {                \
-    m = mxIgraphIntegerFromOptions(opts, "nConnections");                     \
-    MXIGRAPH_CHECK_STATUS();                                                  \
-  } else {                                                                    \
-    IGRAPH_CHECK(                                                             \
-      mxIgraphVectorIntFromOptions(opts, "nConnections", &outseq, false));    \
-    IGRAPH_FINALLY(igraph_vector_int_destroy, &outseq);                       \
-    outseq_ptr = &outseq;                                                     \
-  }                                                                           \
-                                                                              \
-  if (!mxIsEmpty(start_argument)) {                                           \
-    IGRAPH_CHECK(mxIgraphFromArray(start_argument, &start_from, NULL, opts)); \
-    IGRAPH_FINALLY(igraph_destroy, &start_from);                              \
-  }                                                                           \
-                                                                              \
-  IGRAPH_CHECK(igraph_barabasi_game(graph, n_nodes, power, m, outseq_ptr,     \
-    outpref, A, directed, (algo), start_from_ptr));                           \
-                                                                              \
-  if (start_from_ptr) {                                                       \
-    igraph_destroy(&start_from);                                              \
-    IGRAPH_FINALLY_CLEAN(1);                                                  \
-  }                                                                           \
-                                                                              \
-  if (outseq_ptr) {                                                           \
-    igraph_vector_int_destroy(&outseq);                                       \
-    IGRAPH_FINALLY_CLEAN(1);                                                  \
-  }                                                                           \
-                                                                              \
-  return IGRAPH_SUCCESS
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_real_t power;
+  igraph_bool_t outpref;
+  igraph_real_t attractiveness;
+  igraph_bool_t directed;
+  mxArray const* n_connections;
+  mxArray const* start_from;
+} mxIgraph_barabasi_opts_t;
+
+static mxIgraphOption_t barabasi_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_barabasi_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_opts_t, power, "power", REAL),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_opts_t, outpref, "outPreference", BOOL),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_opts_t, attractiveness, "attractiveness", REAL),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_opts_t, n_connections, "nConnections", ARRAY),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_opts_t, start_from, "startFrom", ARRAY),
+};
+
+static igraph_error_t barabasi_i(
+  mxArray const* opts, igraph_t* graph, igraph_barabasi_algorithm_t algo)
+{
+  mxIgraph_barabasi_opts_t params;
+  igraph_integer_t m = 0;
+  igraph_vector_int_t outseq;
+  igraph_vector_int_t* outseq_ptr = NULL;
+  igraph_t start_from;
+  igraph_t* start_from_ptr = NULL;
+
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, barabasi_options_i,
+    MXIGRAPH_N_OPTIONS(barabasi_options_i), &params));
+
+  if (mxIsScalar(params.n_connections)) {
+    m = mxGetScalar(params.n_connections);
+  } else {
+    IGRAPH_CHECK(
+      mxIgraphVectorIntFromArray(params.n_connections, &outseq, false));
+    IGRAPH_FINALLY(igraph_vector_int_destroy, &outseq);
+    outseq_ptr = &outseq;
+  }
+
+  if (!mxIsEmpty(params.start_from)) {
+    IGRAPH_CHECK(
+      mxIgraphFromArray(params.start_from, &start_from, NULL, opts));
+    IGRAPH_FINALLY(igraph_destroy, &start_from);
+    start_from_ptr = &start_from;
+  }
+
+  IGRAPH_CHECK(igraph_barabasi_game(graph, params.n_nodes, params.power, m,
+    outseq_ptr, params.outpref, params.attractiveness, params.directed, algo,
+    start_from_ptr));
+
+  if (start_from_ptr) {
+    igraph_destroy(&start_from);
+    IGRAPH_FINALLY_CLEAN(1);
+  }
+
+  if (outseq_ptr) {
+    igraph_vector_int_destroy(&outseq);
+    IGRAPH_FINALLY_CLEAN(1);
+  }
+
+  return IGRAPH_SUCCESS;
+}
 
 static igraph_error_t mxIgraph_barabasi_bag_i(
   mxArray const* opts, igraph_t* graph)
 {
-  BARABASI_BODY(IGRAPH_BARABASI_BAG);
+  return barabasi_i(opts, graph, IGRAPH_BARABASI_BAG);
 }
 
 static igraph_error_t mxIgraph_barabasi_psumtree_i(
   mxArray const* opts, igraph_t* graph)
 {
-  BARABASI_BODY(IGRAPH_BARABASI_PSUMTREE);
+  return barabasi_i(opts, graph, IGRAPH_BARABASI_PSUMTREE);
 }
 
 static igraph_error_t mxIgraph_barabasi_psumtree_multiple_i(
   mxArray const* opts, igraph_t* graph)
 {
-  BARABASI_BODY(IGRAPH_BARABASI_PSUMTREE_MULTIPLE);
+  return barabasi_i(opts, graph, IGRAPH_BARABASI_PSUMTREE_MULTIPLE);
 }
 
+typedef struct {
+  igraph_bool_t use_edges;
+  igraph_integer_t n_nodes;
+  igraph_integer_t n_edges;
+  igraph_real_t probability;
+  igraph_bool_t directed;
+  igraph_bool_t loops;
+} mxIgraph_erdos_renyi_opts_t;
+
+// Only one of nEdges and probability is set, depending on useEdges.
+static mxIgraphOption_t erdos_renyi_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_erdos_renyi_opts_t, use_edges, "useEdges", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_erdos_renyi_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION_DEFAULT(
+    mxIgraph_erdos_renyi_opts_t, n_edges, "nEdges", INTEGER, 0),
+  MXIGRAPH_OPTION_DEFAULT(
+    mxIgraph_erdos_renyi_opts_t, probability, "probability", REAL, 0),
+  MXIGRAPH_OPTION(mxIgraph_erdos_renyi_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_erdos_renyi_opts_t, loops, "loops", BOOL),
+};
+
 static igraph_error_t mxIgraph_erdos_renyi_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_bool_t edge_method = mxIgraphBoolFromOptions(opts, "useEdges");
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
-  igraph_bool_t loops = mxIgraphBoolFromOptions(opts, "loops");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_erdos_renyi_opts_t params;
 
-  if (edge_method) {
-    igraph_integer_t n_edges = mxIgraphIntegerFromOptions(opts, "nEdges");
-    MXIGRAPH_CHECK_STATUS();
-    IGRAPH_CHECK(
-      igraph_erdos_renyi_game_gnm(graph, n_nodes, n_edges, directed, loops));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, erdos_renyi_options_i,
+    MXIGRAPH_N_OPTIONS(erdos_renyi_options_i), &params));
+
+  if (params.use_edges) {
+    IGRAPH_CHECK(igraph_erdos_renyi_game_gnm(graph, params.n_nodes,
+      params.n_edges, params.directed, params.loops));
   } else {
-    igraph_real_t probability = mxIgraphRealFromOptions(opts, "probability");
-    MXIGRAPH_CHECK_STATUS();
-    IGRAPH_CHECK(igraph_erdos_renyi_game_gnp(
-      graph, n_nodes, probability, directed, loops));
+    IGRAPH_CHECK(igraph_erdos_renyi_game_gnp(graph, params.n_nodes,
+      params.probability, params.directed, params.loops));
   }
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t dim;
+  igraph_integer_t size;
+  igraph_integer_t n_neighbors;
+  igraph_real_t probability;
+  igraph_bool_t loops;
+  igraph_bool_t multiple;
+} mxIgraph_watts_strogatz_opts_t;
+
+static mxIgraphOption_t watts_strogatz_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_watts_strogatz_opts_t, dim, "dim", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_watts_strogatz_opts_t, size, "size", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_watts_strogatz_opts_t, n_neighbors, "radius", INTEGER),
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_watts_strogatz_opts_t, probability,
+    "probability", REAL, 0, 1),
+  MXIGRAPH_OPTION(mxIgraph_watts_strogatz_opts_t, loops, "loops", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_watts_strogatz_opts_t, multiple, "multiple", BOOL),
+};
+
 static igraph_error_t mxIgraph_watts_strogatz_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t dim = mxIgraphIntegerFromOptions(opts, "dim");
-  igraph_integer_t size = mxIgraphIntegerFromOptions(opts, "size");
-  igraph_integer_t n_neighbors = mxIgraphIntegerFromOptions(opts, "radius");
-  igraph_real_t probability = mxIgraphRealFromOptions(opts, "probability");
-  igraph_bool_t loops = mxIgraphBoolFromOptions(opts, "loops");
-  igraph_bool_t multiple = mxIgraphBoolFromOptions(opts, "multiple");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_watts_strogatz_opts_t params;
 
-  IGRAPH_CHECK(igraph_watts_strogatz_game(
-    graph, dim, size, n_neighbors, probability, loops, multiple));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, watts_strogatz_options_i,
+    MXIGRAPH_N_OPTIONS(watts_strogatz_options_i), &params));
+
+  IGRAPH_CHECK(igraph_watts_strogatz_game(graph, params.dim, params.size,
+    params.n_neighbors, params.probability, params.loops, params.multiple));
 
   return IGRAPH_SUCCESS;
 }
@@ -222,17 +292,30 @@ static igraph_error_t mxIgraph_degseq_vl_i(
   DEGSEQ_BODY(IGRAPH_DEGSEQ_VL);
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_integer_t degree;
+  igraph_bool_t directed;
+  igraph_bool_t multiple;
+} mxIgraph_k_regular_opts_t;
+
+static mxIgraphOption_t k_regular_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_k_regular_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_k_regular_opts_t, degree, "degree", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_k_regular_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_k_regular_opts_t, multiple, "multiple", BOOL),
+};
+
 static igraph_error_t mxIgraph_k_regular_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_integer_t degree = mxIgraphIntegerFromOptions(opts, "degree");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
-  igraph_bool_t multiple = mxIgraphBoolFromOptions(opts, "multiple");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_k_regular_opts_t params;
 
-  IGRAPH_CHECK(
-    igraph_k_regular_game(graph, n_nodes, degree, directed, multiple));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, k_regular_options_i,
+    MXIGRAPH_N_OPTIONS(k_regular_options_i), &params));
+
+  IGRAPH_CHECK(igraph_k_regular_game(graph, params.n_nodes, params.degree,
+    params.directed, params.multiple));
 
   return IGRAPH_SUCCESS;
 }
@@ -269,52 +352,106 @@ static igraph_error_t mxIgraph_static_fitness_i(
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_integer_t n_edges;
+  igraph_real_t exponent_out;
+  igraph_real_t exponent_in;
+  igraph_bool_t loops;
+  igraph_bool_t multiple;
+  igraph_bool_t finite_size_correction;
+} mxIgraph_static_power_law_opts_t;
+
+static mxIgraphOption_t static_power_law_options_i[] = {
+  MXIGRAPH_OPTION(
+    mxIgraph_static_power_law_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_static_power_law_opts_t, n_edges, "nEdges", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_static_power_law_opts_t, exponent_out, "outExponent", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_static_power_law_opts_t, exponent_in, "inExponent", REAL),
+  MXIGRAPH_OPTION(mxIgraph_static_power_law_opts_t, loops, "loops", BOOL),
+  MXIGRAPH_OPTION(
+    mxIgraph_static_power_law_opts_t, multiple, "multiple", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_static_power_law_opts_t, finite_size_correction,
+    "finiteSizeCorrection", BOOL),
+};
+
 static igraph_error_t mxIgraph_static_power_law_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_integer_t n_edges = mxIgraphIntegerFromOptions(opts, "nEdges");
-  igraph_real_t exponent_out = mxIgraphRealFromOptions(opts, "outExponent");
-  igraph_real_t exponent_in = mxIgraphRealFromOptions(opts, "inExponent");
-  igraph_bool_t loops = mxIgraphBoolFromOptions(opts, "loops");
-  igraph_bool_t multiple = mxIgraphBoolFromOptions(opts, "multiple");
-  igraph_bool_t finite_size_correction =
-    mxIgraphBoolFromOptions(opts, "finiteSizeCorrection");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_static_power_law_opts_t params;
+
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, static_power_law_options_i,
+    MXIGRAPH_N_OPTIONS(static_power_law_options_i), &params));
 
-  IGRAPH_CHECK(igraph_static_power_law_game(graph, n_nodes, n_edges,
-    exponent_out, exponent_in, loops, multiple, finite_size_correction));
+  IGRAPH_CHECK(igraph_static_power_law_game(graph, params.n_nodes,
+    params.n_edges, params.exponent_out, params.exponent_in, params.loops,
+    params.multiple, params.finite_size_correction));
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_real_t fw_prob;
+  igraph_real_t bw_factor;
+  igraph_integer_t n_ambassadors;
+  igraph_bool_t directed;
+} mxIgraph_forest_fire_opts_t;
+
+static mxIgraphOption_t forest_fire_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_forest_fire_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_forest_fire_opts_t, fw_prob, "forwardProbability", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_forest_fire_opts_t, bw_factor, "backwardFactor", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_forest_fire_opts_t, n_ambassadors, "nAmbassadors", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_forest_fire_opts_t, directed, "isdirected", BOOL),
+};
+
 static igraph_error_t mxIgraph_forest_fire_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_real_t fw_prob = mxIgraphRealFromOptions(opts, "forwardProbability");
-  igraph_real_t bw_factor = mxIgraphRealFromOptions(opts, "backwardFactor");
-  igraph_integer_t ambs = mxIgraphIntegerFromOptions(opts, "nAmbassadors");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_forest_fire_opts_t params;
+
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, forest_fire_options_i,
+    MXIGRAPH_N_OPTIONS(forest_fire_options_i), &params));
 
-  IGRAPH_CHECK(igraph_forest_fire_game(
-    graph, n_nodes, fw_prob, bw_factor, ambs, directed));
+  IGRAPH_CHECK(igraph_forest_fire_game(graph, params.n_nodes, params.fw_prob,
+    params.bw_factor, params.n_ambassadors, params.directed));
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_integer_t n_edges;
+  igraph_bool_t directed;
+  igraph_bool_t citation;
+} mxIgraph_growing_random_opts_t;
+
+static mxIgraphOption_t growing_random_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_growing_random_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_growing_random_opts_t, n_edges, "edgesPerStep", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_growing_random_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_growing_random_opts_t, citation, "citation", BOOL),
+};
+
 static igraph_error_t mxIgraph_growing_random_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_integer_t n_edges = mxIgraphIntegerFromOptions(opts, "edgesPerStep");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
-  igraph_bool_t citation = mxIgraphBoolFromOptions(opts, "citation");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_growing_random_opts_t params;
 
-  IGRAPH_CHECK(
-    igraph_growing_random_game(graph, n_nodes, n_edges, directed, citation));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, growing_random_options_i,
+    MXIGRAPH_N_OPTIONS(growing_random_options_i), &params));
+
+  IGRAPH_CHECK(igraph_growing_random_game(graph, params.n_nodes,
+    params.n_edges, params.directed, params.citation));
 
   return IGRAPH_SUCCESS;
 }
@@ -455,32 +592,53 @@ static igraph_error_t mxIgraph_asymmetric_preference_i(
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_real_t power;
+  igraph_integer_t time_window;
+  igraph_integer_t edges_per_step;
+  igraph_bool_t outpref;
+  igraph_real_t zero_appeal;
+  igraph_bool_t directed;
+  mxArray const* outseq;
+} mxIgraph_recent_degree_opts_t;
+
+static mxIgraphOption_t recent_degree_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_recent_degree_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_recent_degree_opts_t, power, "degreeExp", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_opts_t, time_window, "timeWindow", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_opts_t, edges_per_step, "edgesPerStep", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_opts_t, outpref, "outPreference", BOOL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_opts_t, zero_appeal, "zeroAppeal", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_recent_degree_opts_t, outseq, "outSeq", ARRAY),
+};
+
 static igraph_error_t mxIgraph_recent_degree_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_real_t power = mxIgraphRealFromOptions(opts, "degreeExp");
-  igraph_integer_t time_window =
-    mxIgraphIntegerFromOptions(opts, "timeWindow");
-  igraph_integer_t edges_per_time_step =
-    mxIgraphIntegerFromOptions(opts, "edgesPerStep");
-  igraph_bool_t outpref = mxIgraphBoolFromOptions(opts, "outPreference");
-  igraph_real_t zero_appeal = mxIgraphRealFromOptions(opts, "zeroAppeal");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
+  mxIgraph_recent_degree_opts_t params;
   igraph_vector_int_t outseq;
   igraph_vector_int_t* outseq_ptr = NULL;
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromOptions(opts, "outSeq", &outseq, false));
-  IGRAPH_FINALLY(igraph_vector_int_destroy, &outseq);
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, recent_degree_options_i,
+    MXIGRAPH_N_OPTIONS(recent_degree_options_i), &params));
 
-  MXIGRAPH_CHECK_STATUS();
+  IGRAPH_CHECK(mxIgraphVectorIntFromArray(params.outseq, &outseq, false));
+  IGRAPH_FINALLY(igraph_vector_int_destroy, &outseq);
 
-  if (!mxIgraphIsEmpty(mxIgraphGetArgument(opts, "outSeq"))) {
+  if (!mxIgraphIsEmpty(params.outseq)) {
     outseq_ptr = &outseq;
   }
 
-  IGRAPH_CHECK(igraph_recent_degree_game(graph, n_nodes, power, time_window,
-    edges_per_time_step, outseq_ptr, outpref, zero_appeal, directed));
+  IGRAPH_CHECK(igraph_recent_degree_game(graph, params.n_nodes, params.power,
+    params.time_window, params.edges_per_step, outseq_ptr, params.outpref,
+    params.zero_appeal, params.directed));
 
   igraph_vector_int_destroy(&outseq);
   IGRAPH_FINALLY_CLEAN(1);
@@ -488,61 +646,119 @@ static igraph_error_t mxIgraph_recent_degree_i(
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_integer_t edges_per_step;
+  igraph_bool_t outpref;
+  igraph_real_t pa_exp;
+  igraph_real_t aging_exp;
+  igraph_integer_t aging_bins;
+  igraph_real_t zero_deg_appeal;
+  igraph_real_t zero_age_appeal;
+  igraph_real_t deg_coef;
+  igraph_real_t age_coef;
+  igraph_bool_t directed;
+  mxArray const* outseq;
+} mxIgraph_barabasi_aging_opts_t;
+
+static mxIgraphOption_t barabasi_aging_options_i[] = {
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_aging_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_aging_opts_t, edges_per_step, "edgesPerStep", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_aging_opts_t, outpref, "outPreference", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_aging_opts_t, pa_exp, "degreeExp", REAL),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_aging_opts_t, aging_exp, "ageExp", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_aging_opts_t, aging_bins, "agingBins", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_aging_opts_t, zero_deg_appeal,
+    "zeroDegreeAppeal", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_aging_opts_t, zero_age_appeal, "zeroAgeAppeal", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_aging_opts_t, deg_coef, "degreeCoef", REAL),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_aging_opts_t, age_coef, "ageCoef", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_barabasi_aging_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION(mxIgraph_barabasi_aging_opts_t, outseq, "outSeq", ARRAY),
+};
+
 static igraph_error_t mxIgraph_barabasi_aging_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_integer_t edges_per_time_step =
-    mxIgraphIntegerFromOptions(opts, "edgesPerStep");
-  igraph_bool_t outpref = mxIgraphBoolFromOptions(opts, "outPreference");
-  igraph_real_t pa_exp = mxIgraphRealFromOptions(opts, "degreeExp");
-  igraph_real_t aging_exp = mxIgraphRealFromOptions(opts, "ageExp");
-  igraph_integer_t aging_bins = mxIgraphIntegerFromOptions(opts, "agingBins");
-  igraph_real_t zero_deg_appeal =
-    mxIgraphRealFromOptions(opts, "zeroDegreeAppeal");
-  igraph_real_t zero_age_appeal =
-    mxIgraphRealFromOptions(opts, "zeroAgeAppeal");
-  igraph_real_t deg_coef = mxIgraphRealFromOptions(opts, "degreeCoef");
-  igraph_real_t age_coef = mxIgraphRealFromOptions(opts, "ageCoef");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
+  mxIgraph_barabasi_aging_opts_t params;
   igraph_vector_int_t outseq;
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromOptions(opts, "outSeq", &outseq, false));
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, barabasi_aging_options_i,
+    MXIGRAPH_N_OPTIONS(barabasi_aging_options_i), &params));
+
+  IGRAPH_CHECK(mxIgraphVectorIntFromArray(params.outseq, &outseq, false));
   IGRAPH_FINALLY(igraph_vector_int_destroy, &outseq);
-  MXIGRAPH_CHECK_STATUS();
 
-  IGRAPH_CHECK(igraph_barabasi_aging_game(graph, n_nodes, edges_per_time_step,
-    &outseq, outpref, pa_exp, aging_exp, aging_bins, zero_deg_appeal,
-    zero_age_appeal, deg_coef, age_coef, directed));
+  IGRAPH_CHECK(igraph_barabasi_aging_game(graph, params.n_nodes,
+    params.edges_per_step, &outseq, params.outpref, params.pa_exp,
+    params.aging_exp, params.aging_bins, params.zero_deg_appeal,
+    params.zero_age_appeal, params.deg_coef, params.age_coef,
+    params.directed));
   igraph_vector_int_destroy(&outseq);
   IGRAPH_FINALLY_CLEAN(1);
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_integer_t edges_per_step;
+  igraph_bool_t outpref;
+  igraph_real_t pa_exp;
+  igraph_real_t aging_exp;
+  igraph_integer_t aging_bins;
+  igraph_integer_t time_window;
+  igraph_real_t zero_appeal;
+  igraph_bool_t directed;
+  mxArray const* outseq;
+} mxIgraph_recent_degree_aging_opts_t;
+
+static mxIgraphOption_t recent_degree_aging_options_i[] = {
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_recent_degree_aging_opts_t, edges_per_step,
+    "edgesPerStep", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, outpref, "outPreference", BOOL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, pa_exp, "degreeExp", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, aging_exp, "ageExp", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, aging_bins, "agingBins", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, time_window, "timeWindow", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, zero_appeal, "zeroAppeal", REAL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION(
+    mxIgraph_recent_degree_aging_opts_t, outseq, "outSeq", ARRAY),
+};
+
 static igraph_error_t mxIgraph_recent_degree_aging_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_integer_t n_edges = mxIgraphIntegerFromOptions(opts, "edgesPerStep");
-  igraph_bool_t outpref = mxIgraphBoolFromOptions(opts, "outPreference");
-  igraph_real_t pa_exp = mxIgraphRealFromOptions(opts, "degreeExp");
-  igraph_real_t aging_exp = mxIgraphRealFromOptions(opts, "ageExp");
-  igraph_integer_t aging_bins = mxIgraphIntegerFromOptions(opts, "agingBins");
-  igraph_integer_t time_window =
-    mxIgraphIntegerFromOptions(opts, "timeWindow");
-  igraph_real_t zero_appeal = mxIgraphRealFromOptions(opts, "zeroAppeal");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
+  mxIgraph_recent_degree_aging_opts_t params;
   igraph_vector_int_t outseq;
 
-  IGRAPH_CHECK(mxIgraphVectorIntFromOptions(opts, "outSeq", &outseq, false));
-  IGRAPH_FINALLY(igraph_vector_int_destroy, &outseq);
+  IGRAPH_CHECK(mxIgraphParseOptions(opts, recent_degree_aging_options_i,
+    MXIGRAPH_N_OPTIONS(recent_degree_aging_options_i), &params));
 
-  MXIGRAPH_CHECK_STATUS();
+  IGRAPH_CHECK(mxIgraphVectorIntFromArray(params.outseq, &outseq, false));
+  IGRAPH_FINALLY(igraph_vector_int_destroy, &outseq);
 
-  IGRAPH_CHECK(igraph_recent_degree_aging_game(graph, n_nodes, n_edges,
-    &outseq, outpref, pa_exp, aging_exp, aging_bins, time_window, zero_appeal,
-    directed));
+  IGRAPH_CHECK(igraph_recent_degree_aging_game(graph, params.n_nodes,
+    params.edges_per_step, &outseq, params.outpref, params.pa_exp,
+    params.aging_exp, params.aging_bins, params.time_window,
+    params.zero_appeal, params.directed));
 
   igraph_vector_int_destroy(&outseq);
   IGRAPH_FINALLY_CLEAN(1);
@@ -701,37 +917,61 @@ static igraph_error_t mxIgraph_dot_product_i(
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_nodes;
+  igraph_bool_t directed;
+  igraph_integer_t method;
+} mxIgraph_tree_opts_t;
+
+static char const* const tree_methods_i[] = {
+  [IGRAPH_RANDOM_TREE_PRUFER] = "prufer", [IGRAPH_RANDOM_TREE_LERW] = "lerw"
+};
+
+static mxIgraphOption_t tree_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_tree_opts_t, n_nodes, "nNodes", INTEGER),
+  MXIGRAPH_OPTION(mxIgraph_tree_opts_t, directed, "isdirected", BOOL),
+  MXIGRAPH_OPTION_CHOICES(
+    mxIgraph_tree_opts_t, method, "method", tree_methods_i),
+};
+
 static igraph_error_t mxIgraph_tree_i(mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_nodes = mxIgraphIntegerFromOptions(opts, "nNodes");
-  igraph_bool_t directed = mxIgraphBoolFromOptions(opts, "isdirected");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_tree_opts_t params;
 
-  igraph_integer_t const n_methods = 2;
-  char const* methods[2] = {
-    [IGRAPH_RANDOM_TREE_PRUFER] = "prufer", [IGRAPH_RANDOM_TREE_LERW] = "lerw"
-  };
-  igraph_random_tree_t method = mxIgraphSelectMethod(
-    mxIgraphGetArgument(opts, "method"), methods, n_methods);
-  MXIGRAPH_CHECK_METHOD(method, mxIgraphGetArgument(opts, "method"));
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, tree_options_i, MXIGRAPH_N_OPTIONS(tree_options_i), &params));
 
-  IGRAPH_CHECK(igraph_tree_game(graph, n_nodes, directed, method));
+  IGRAPH_CHECK(igraph_tree_game(graph, params.n_nodes, params.directed,
+    (igraph_random_tree_t)params.method));
 
   return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+  igraph_integer_t n_islands;
+  igraph_integer_t island_size;
+  igraph_real_t p_in;
+  igraph_integer_t n_inter;
+} mxIgraph_islands_opts_t;
+
+static mxIgraphOption_t islands_options_i[] = {
+  MXIGRAPH_OPTION(mxIgraph_islands_opts_t, n_islands, "nIslands", INTEGER),
+  MXIGRAPH_OPTION(
+    mxIgraph_islands_opts_t, island_size, "islandSize", INTEGER),
+  MXIGRAPH_OPTION_BOUNDED(mxIgraph_islands_opts_t, p_in, "pIn", REAL, 0, 1),
+  MXIGRAPH_OPTION(mxIgraph_islands_opts_t, n_inter, "nInterEdges", INTEGER),
+};
+
 static igraph_error_t mxIgraph_simple_interconnected_islands_i(
   mxArray const* opts, igraph_t* graph)
 {
-  igraph_integer_t n_islands = mxIgraphIntegerFromOptions(opts, "nIslands");
-  igraph_integer_t islands_size =
-    mxIgraphIntegerFromOptions(opts, "islandSize");
-  igraph_real_t p_in = mxIgraphRealFromOptions(opts, "pIn");
-  igraph_integer_t n_inter = mxIgraphIntegerFromOptions(opts, "nInterEdges");
-  MXIGRAPH_CHECK_STATUS();
+  mxIgraph_islands_opts_t params;
+
+  IGRAPH_CHECK(mxIgraphParseOptions(
+    opts, islands_options_i, MXIGRAPH_N_OPTIONS(islands_options_i), &params));
 
-  IGRAPH_CHECK(igraph_simple_interconnected_islands_game(
-    graph, n_islands, islands_size, p_in, n_inter));
+  IGRAPH_CHECK(igraph_simple_interconnected_islands_game(graph,
+    params.n_islands, params.island_size, params.p_in, params.n_inter));
 
   return IGRAPH_SUCCESS;
 }
@@ -749,7 +989,7 @@ igraph_error_t mexIgraphRandGame(
   typedef igraph_error_t (*game_method_t)(mxArray const* prhs, igraph_t* g);
   game_method_t game_method;
 
-  char const* games[MXIGRAPH_GAME_N] = {
+  static char const* const games[MXIGRAPH_GAME_N] = {
     [MXIGRAPH_GAME_GRG] = "grg",
     [MXIGRAPH_GAME_BARABASI_BAG] = "barabasibag",
     [MXIGRAPH_GAME_BARABASI_PSUMTREE] = "barabasipsumtree",
@@ -838,6 +1078,7 @@ igraph_error_t mexIgraphRandGame(
 
   plhs[0] = mxIgraphToArray(&graph, NULL, graph_options);
   igraph_destroy(&graph);
+  MXIGRAPH_CHECK_STATUS();
 
   return IGRAPH_SUCCESS;
 }
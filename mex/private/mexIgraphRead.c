@@ -104,6 +104,7 @@ igraph_error_t mexIgraphRead(
   igraph_vector_destroy(&weights);
   igraph_destroy(&graph);
   IGRAPH_FINALLY_CLEAN(3);
+  MXIGRAPH_CHECK_STATUS();
 
   return IGRAPH_SUCCESS;
 }
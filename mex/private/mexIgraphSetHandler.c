@@ -36,7 +36,7 @@ igraph_error_t mexIgraphSetHandler(
   mxIgraph_handler_t type;
   igraph_bool_t verbose = mxGetScalar(prhs[1]);
 
-  char const* handlers[MXIGRAPH_HANDLER_N] = {
+  static char const* const handlers[MXIGRAPH_HANDLER_N] = {
     [MXIGRAPH_HANDLER_WARNING] = "warning",
     [MXIGRAPH_HANDLER_PROGRESS] = "progress",
     [MXIGRAPH_HANDLER_STATUS] = "status",
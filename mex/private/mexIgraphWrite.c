@@ -33,8 +33,9 @@ igraph_error_t mexIgraphWrite(
   igraph_vector_t weights;
   char* filename = mxArrayToString(prhs[0]);
   mxIgraphFileFormat_t format = mxIgraphSelectFileFormat(prhs[2]);
-  igraph_bool_t is_weighted =
-    mxIgraphBoolFromOptions(graph_options, "isweighted");
+  mxIgraphFlag_t const weighted_flag =
+    mxIgraphFlagFromOptions(graph_options, "isweighted");
+  igraph_bool_t is_weighted;
   MXIGRAPH_CHECK_STATUS();
 
   FILE* fptr;
@@ -44,16 +45,22 @@ igraph_error_t mexIgraphWrite(
   }
   IGRAPH_FINALLY(fclose, fptr);
 
-  if (is_weighted) {
+  if (weighted_flag) {
     igraph_set_attribute_table(&igraph_cattribute_table);
   }
 
   IGRAPH_CHECK(mxIgraphFromArray(
-    prhs[1], &graph, is_weighted ? &weights : NULL, graph_options));
+    prhs[1], &graph, weighted_flag ? &weights : NULL, graph_options));
   IGRAPH_FINALLY(igraph_destroy, &graph);
 
-  if (is_weighted) {
-    SETEANV(&graph, "weight", &weights);
+  /* An inferred weight flag comes back as an empty weight vector if the
+  graph turned out to be unweighted. */
+  is_weighted = (weighted_flag == MXIGRAPH_FLAG_TRUE) ||
+                (weighted_flag && (igraph_vector_size(&weights) > 0));
+  if (weighted_flag) {
+    if (is_weighted) {
+      SETEANV(&graph, "weight", &weights);
+    }
     igraph_vector_destroy(&weights);
   }
 
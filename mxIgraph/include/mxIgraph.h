@@ -20,6 +20,7 @@
 #define MEX_IGRAPH_H
 
 #include <mex.h>
+#include <stddef.h>
 #if defined(__GNUC__)
 # undef printf
 # define printf(...) __attribute__((format(mexPrintf, ...)))
@@ -41,6 +42,15 @@
 typedef enum {
   MXIGRAPH_DTYPE_LOGICAL = 0,
   MXIGRAPH_DTYPE_DOUBLE,
+  MXIGRAPH_DTYPE_SINGLE,
+  MXIGRAPH_DTYPE_INT8,
+  MXIGRAPH_DTYPE_INT16,
+  MXIGRAPH_DTYPE_INT32,
+  MXIGRAPH_DTYPE_INT64,
+  MXIGRAPH_DTYPE_UINT8,
+  MXIGRAPH_DTYPE_UINT16,
+  MXIGRAPH_DTYPE_UINT32,
+  MXIGRAPH_DTYPE_UINT64,
   MXIGRAPH_DTYPE_N
 } mxIgraphDType_t;
 
@@ -48,9 +58,19 @@ typedef enum {
   MXIGRAPH_REPR_GRAPH = 0,
   MXIGRAPH_REPR_FULL,
   MXIGRAPH_REPR_SPARSE,
+  MXIGRAPH_REPR_EDGELIST,
+  MXIGRAPH_REPR_AUTO,
   MXIGRAPH_REPR_N
 } mxIgraphRepr_t;
 
+/* Graph flags that can be left for the conversion layer to work out from the
+ graph itself. */
+typedef enum {
+  MXIGRAPH_FLAG_FALSE = 0,
+  MXIGRAPH_FLAG_TRUE,
+  MXIGRAPH_FLAG_INFER
+} mxIgraphFlag_t;
+
 typedef enum {
   MXIGRAPH_FORMAT_EDGELIST = 0,
   MXIGRAPH_FORMAT_NCOL,
@@ -68,6 +88,26 @@ typedef enum {
 
 enum { MXIGRAPH_IDX_KEEP = 0, MXIGRAPH_IDX_SHIFT };
 
+/* Structural properties of an adjacency matrix, see `mxIgraphProfile`. */
+typedef struct {
+  igraph_bool_t is_square;
+  igraph_bool_t is_triu;
+  igraph_bool_t is_tril;
+  igraph_bool_t is_symmetric;
+  igraph_bool_t is_weighted;
+  igraph_integer_t nnz;
+  igraph_integer_t n_loops;
+  igraph_real_t min_weight;
+  igraph_real_t max_weight;
+} mxIgraphProfile_t;
+
+typedef struct {
+  igraph_integer_t hits;
+  igraph_integer_t misses;
+  igraph_integer_t size;
+  igraph_integer_t capacity;
+} mxIgraphCacheStats_t;
+
 // mxHandler
 igraph_error_handler_t mxIgraphErrorHandlerMex;
 igraph_warning_handler_t mxIgraphWarningHandlerMex;
@@ -107,6 +147,62 @@ char* mxIgraphGetErrorMsg(void);
 
 // mxRandom
 EXTERNC void mxIgraphSetRNG(void);
+EXTERNC void mxIgraphRNGBufferInvalidate(void);
+EXTERNC igraph_integer_t mxIgraphRNGBufferSize(void);
+EXTERNC igraph_error_t mxIgraphSetRNGBufferSize(igraph_integer_t const size);
+
+// mxParallel
+typedef igraph_bool_t mxIgraphTask_t(
+  igraph_integer_t task, igraph_integer_t thread, void* data);
+
+EXTERNC igraph_integer_t mxIgraphThreadCount(void);
+EXTERNC void mxIgraphSetThreadCount(igraph_integer_t const n_threads);
+EXTERNC igraph_bool_t mxIgraphParallelFor(
+  igraph_integer_t const n_tasks, mxIgraphTask_t* fn, void* data);
+EXTERNC igraph_bool_t mxIgraphParallelForThreads(
+  igraph_integer_t const n_tasks, igraph_integer_t const max_threads,
+  mxIgraphTask_t* fn, void* data);
+
+// mxMemory
+igraph_real_t mxIgraphMemoryBudget(void);
+void mxIgraphSetMemoryBudget(igraph_real_t const bytes);
+igraph_real_t mxIgraphEstimateBytes(igraph_integer_t const n_nodes,
+  igraph_integer_t const n_edges, igraph_bool_t const is_directed,
+  mxIgraphRepr_t const repr, mxIgraphDType_t const dtype,
+  igraph_bool_t const is_weighted, igraph_bool_t const symmetric);
+
+// mxBatch
+typedef igraph_error_t mxIgraphBatchTask_t(
+  igraph_integer_t task, igraph_integer_t thread, void* data);
+
+igraph_error_t mxIgraphBatchRun(igraph_integer_t const n_tasks,
+  mxIgraphBatchTask_t* fn, void* data, igraph_integer_t* failed);
+char const* mxIgraphBatchError(void);
+
+// mxLookup
+#define MXIGRAPH_NAME_MAX 64
+#define MXIGRAPH_LOOKUP_BITS 7
+#define MXIGRAPH_LOOKUP_SLOTS (1 << MXIGRAPH_LOOKUP_BITS)
+
+typedef struct {
+  char const* const* names;
+  igraph_integer_t n_names;
+  uint32_t salt;
+  uint32_t hashes[MXIGRAPH_LOOKUP_SLOTS];
+  igraph_integer_t index[MXIGRAPH_LOOKUP_SLOTS];
+} mxIgraphLookup_t;
+
+uint32_t mxIgraphHashName(char const* name);
+igraph_error_t mxIgraphLookupInit(mxIgraphLookup_t* lookup,
+  char const* const names[], igraph_integer_t const n_names);
+igraph_integer_t mxIgraphLookupHash(
+  mxIgraphLookup_t const* lookup, uint32_t const hash);
+igraph_integer_t mxIgraphLookupName(
+  mxIgraphLookup_t const* lookup, char const* name);
+
+// mxStream
+igraph_error_t mxIgraphRNGStreamInit(
+  igraph_rng_t* rng, igraph_uint_t const seed, igraph_uint_t const stream);
 
 // mxPredicate
 igraph_bool_t mxIgraphIsSquare(mxArray const* p);
@@ -114,10 +210,17 @@ igraph_bool_t mxIgraphIsVector(mxArray const* p);
 igraph_bool_t mxIgraphIsEmpty(mxArray const* p);
 igraph_bool_t mxIgraphIsWeighted(mxArray const* p);
 igraph_bool_t mxIgraphIsGraph(mxArray const* p);
+igraph_bool_t mxIgraphIsEdgeList(mxArray const* p);
 igraph_bool_t mxIgraphIsDirected(mxArray const* p);
 igraph_bool_t mxIgraphIsTriU(mxArray const* p);
 igraph_bool_t mxIgraphIsTriL(mxArray const* p);
 igraph_bool_t mxIgraphIsSymmetric(mxArray const* p);
+igraph_integer_t mxIgraphParallelSymmetryThreshold(void);
+void mxIgraphSetParallelSymmetryThreshold(igraph_integer_t const nnz);
+void mxIgraphProfile(mxArray const* p, mxIgraphProfile_t* profile);
+igraph_bool_t mxIgraphProfileIsDirected(mxIgraphProfile_t const* profile);
+igraph_integer_t mxIgraphProfileECount(
+  mxIgraphProfile_t const* profile, igraph_bool_t const is_directed);
 
 // mxGraph
 igraph_integer_t mxIgraphVCount(mxArray const* p);
@@ -128,6 +231,15 @@ igraph_error_t mxIgraphFromArray(mxArray const* p, igraph_t* graph,
 mxArray* mxIgraphToArray(igraph_t const* graph, igraph_vector_t const* weights,
   mxArray const* graphOpts);
 
+// mxCache
+igraph_error_t mxIgraphFromArrayCached(mxArray const* p,
+  igraph_t const** graph, igraph_vector_t const** weights,
+  mxArray const* graph_options);
+void mxIgraphCacheRelease(void);
+void mxIgraphCacheClear(void);
+void mxIgraphCacheSetCapacity(igraph_integer_t const capacity);
+void mxIgraphCacheStats(mxIgraphCacheStats_t* stats);
+
 // mxStructures
 igraph_error_t mxIgraphVectorFromArray(
   mxArray const* p, igraph_vector_t* vec, igraph_bool_t const shift_start);
@@ -177,8 +289,8 @@ void mxIgraphPrintGraph(igraph_t const* graph, igraph_vector_t const* weights);
     }                                                                         \
   } while (0)
 
-igraph_integer_t mxIgraphSelectMethod(
-  mxArray const* p, char const* methods[], igraph_integer_t const n_methods);
+igraph_integer_t mxIgraphSelectMethod(mxArray const* p,
+  char const* const methods[], igraph_integer_t const n_methods);
 mxIgraphFileFormat_t mxIgraphSelectFileFormat(mxArray const* p);
 
 mxArray* mxIgraphGetArgument(
@@ -194,8 +306,10 @@ igraph_real_t mxIgraphRealFromOptions(
   mxArray const* arg_struct, char const fieldname[1]);
 igraph_bool_t mxIgraphBoolFromOptions(
   mxArray const* arg_struct, char const fieldname[1]);
-char* mxIgraphStringFromOptions(
+mxIgraphFlag_t mxIgraphFlagFromOptions(
   mxArray const* arg_struct, char const fieldname[1]);
+char* mxIgraphStringFromOptions(mxArray const* arg_struct,
+  char const fieldname[1], char* buf, size_t const buf_len);
 
 igraph_error_t mxIgraphVectorFromOptions(mxArray const* arg_struct,
   char const fieldname[1], igraph_vector_t* vec,
@@ -217,4 +331,75 @@ igraph_error_t mxIgraphMatrixBoolFromOptions(mxArray const* arg_struct,
   char const fieldname[1], igraph_matrix_bool_t* mat,
   igraph_bool_t const shift_start);
 
+/* Option schemas.
+
+   A schema is an array of options describing where each field of a MATLAB
+   options struct goes in a C struct. Fields are stored at `offset` as:
+
+   INTEGER, CHOICE: igraph_integer_t
+   INDEX: igraph_integer_t, shifted from 1-based to 0-based
+   REAL: igraph_real_t
+   BOOL: igraph_bool_t
+   MODE: igraph_neimode_t
+   STRING: char[MXIGRAPH_NAME_MAX]
+   ARRAY: mxArray const*, borrowed from the options struct
+
+   Schemas should be declared static and not const since parsing remembers
+   where each field was found to skip the name lookup on later calls. */
+typedef enum {
+  MXIGRAPH_OPTION_INTEGER = 0,
+  MXIGRAPH_OPTION_INDEX,
+  MXIGRAPH_OPTION_REAL,
+  MXIGRAPH_OPTION_BOOL,
+  MXIGRAPH_OPTION_MODE,
+  MXIGRAPH_OPTION_CHOICE,
+  MXIGRAPH_OPTION_STRING,
+  MXIGRAPH_OPTION_ARRAY,
+  MXIGRAPH_OPTION_N
+} mxIgraphOptionType_t;
+
+typedef struct {
+  char const* name;
+  mxIgraphOptionType_t type;
+  size_t offset;
+  // Use default_value when the field is missing or empty instead of failing.
+  igraph_bool_t optional;
+  igraph_real_t default_value;
+  // Reject numeric values outside of [min, max].
+  igraph_bool_t bounded;
+  igraph_real_t min;
+  igraph_real_t max;
+  // Names for CHOICE options, the stored value is the index of the match.
+  char const* const* choices;
+  igraph_integer_t n_choices;
+  // One more than the field number the option was last found at.
+  int field_hint;
+} mxIgraphOption_t;
+
+/* Schema entries. option_type is the type without the MXIGRAPH_OPTION_
+   prefix, e.g. MXIGRAPH_OPTION(opts_t, n_iter, "nIterations", INTEGER). */
+#define MXIGRAPH_OPTION(st, member, field, option_type)                       \
+  { .name = (field), .type = MXIGRAPH_OPTION_##option_type,                   \
+    .offset = offsetof(st, member) }
+
+#define MXIGRAPH_OPTION_DEFAULT(st, member, field, option_type, value)        \
+  { .name = (field), .type = MXIGRAPH_OPTION_##option_type,                   \
+    .offset = offsetof(st, member), .optional = true,                         \
+    .default_value = (value) }
+
+#define MXIGRAPH_OPTION_BOUNDED(st, member, field, option_type, lower, upper) \
+  { .name = (field), .type = MXIGRAPH_OPTION_##option_type,                   \
+    .offset = offsetof(st, member), .bounded = true, .min = (lower),          \
+    .max = (upper) }
+
+#define MXIGRAPH_OPTION_CHOICES(st, member, field, names)                     \
+  { .name = (field), .type = MXIGRAPH_OPTION_CHOICE,                          \
+    .offset = offsetof(st, member), .choices = (names),                       \
+    .n_choices = sizeof(names) / sizeof((names)[0]) }
+
+#define MXIGRAPH_N_OPTIONS(options) (sizeof(options) / sizeof((options)[0]))
+
+igraph_error_t mxIgraphParseOptions(mxArray const* arg_struct,
+  mxIgraphOption_t options[], igraph_integer_t const n_options, void* res);
+
 #endif
@@ -16,31 +16,113 @@
  * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <math.h>
 #include <mxIgraph.h>
 #include <string.h>
 
+/* Lookup tables for the method names passed to mxIgraphSelectMethod, keyed
+   on the address of the names. Each table is built the first time it is
+   used and kept for the life of the MEX file, the same as the dispatcher's
+   function table. Only touched on MATLAB's thread since selecting a method
+   reads an mxArray. */
+#define METHOD_TABLES_MAX 64
+
+typedef struct {
+  char const* const* methods;
+  igraph_bool_t built;
+  mxIgraphLookup_t lookup;
+} method_table_t;
+
+static method_table_t method_tables[METHOD_TABLES_MAX];
+static igraph_integer_t n_method_tables = 0;
+
+/* Failing to build a table is not an error for the caller, who can still
+   scan the names, so it must not reach the MATLAB error handler. Unlike
+   igraph_error_handler_ignore this leaves the finally stack alone since it
+   may hold the caller's objects. */
+static void lookup_error_handler_i(char const* reason, char const* file,
+  int line, igraph_error_t igraph_errno)
+{
+  IGRAPH_UNUSED(reason);
+  IGRAPH_UNUSED(file);
+  IGRAPH_UNUSED(line);
+  IGRAPH_UNUSED(igraph_errno);
+}
+
+/* Returns NULL if the table could not be built, in which case the caller
+   has to scan the names. Tables that failed are remembered so the build is
+   only attempted once. */
+static mxIgraphLookup_t const* method_lookup_i(
+  char const* const methods[], igraph_integer_t const n_methods)
+{
+  method_table_t* table;
+  igraph_error_handler_t* handler;
+
+  for (igraph_integer_t i = 0; i < n_method_tables; i++) {
+    if (method_tables[i].methods == methods) {
+      return method_tables[i].built ? &method_tables[i].lookup : NULL;
+    }
+  }
+
+  if (n_method_tables == METHOD_TABLES_MAX) {
+    return NULL;
+  }
+
+  table = method_tables + n_method_tables;
+  handler = igraph_set_error_handler(lookup_error_handler_i);
+  table->built = mxIgraphLookupInit(&table->lookup, methods, n_methods) ==
+                 IGRAPH_SUCCESS;
+  igraph_set_error_handler(handler);
+
+  table->methods = methods;
+  n_method_tables++;
+
+  return table->built ? &table->lookup : NULL;
+}
+
 /* Generic string selector.
    Find which of a predefined set of strings an input value matches.
    Returns the index, which should correspond to an enum that can be used in a
    switch statement.
 
-   If no match found, returns -1. */
-igraph_integer_t mxIgraphSelectMethod(
-  mxArray const* p, char const* methods[], igraph_integer_t const n_methods)
+   If no match found, returns -1.
+
+   methods must have static storage since its lookup table is cached by
+   address. NULL entries can never match.
+
+   The name is copied to the stack rather than allocated, since this runs at
+   least once on every call. Names too long for the buffer can not match any
+   method. */
+igraph_integer_t mxIgraphSelectMethod(mxArray const* p,
+  char const* const methods[], igraph_integer_t const n_methods)
 {
+  char name[MXIGRAPH_NAME_MAX];
+  mxIgraphLookup_t const* lookup;
+  igraph_integer_t res = -1;
+
   if (!mxIsChar(p)) {
     mxIgraphSetError(IGRAPH_EINVAL);
     mxIgraphSetErrorMsg("Method name must be specified as a string.");
     return -1;
   }
 
-  char* name = mxArrayToString(p);
-  for (igraph_integer_t i = 0; i < n_methods; i++) {
-    if (methods[i] && strcmp(name, methods[i]) == 0) {
-      return i;
+  if (mxGetString(p, name, sizeof(name)) == 0) {
+    if ((lookup = method_lookup_i(methods, n_methods))) {
+      res = mxIgraphLookupName(lookup, name);
+    } else {
+      for (igraph_integer_t i = 0; i < n_methods; i++) {
+        if (methods[i] && strcmp(name, methods[i]) == 0) {
+          res = i;
+          break;
+        }
+      }
     }
   }
 
+  if (res != -1) {
+    return res;
+  }
+
   mxIgraphSetError(IGRAPH_EINVAL);
   mxIgraphSetErrorMsg("Recieved unexpected method name \"%s\".", name);
   return -1;
@@ -50,7 +132,7 @@ igraph_integer_t mxIgraphSelectMethod(
 mxIgraphFileFormat_t mxIgraphSelectFileFormat(mxArray const* p)
 {
   mxIgraphFileFormat_t res;
-  char const* file_formats[MXIGRAPH_FORMAT_N] = {
+  static char const* const file_formats[MXIGRAPH_FORMAT_N] = {
     [MXIGRAPH_FORMAT_EDGELIST] = "edgelist",
     [MXIGRAPH_FORMAT_NCOL] = "ncol",
     [MXIGRAPH_FORMAT_LGL] = "lgl",
@@ -71,9 +153,12 @@ mxIgraphFileFormat_t mxIgraphSelectFileFormat(mxArray const* p)
 mxIgraphRepr_t mxIgraphReprFromOptions(mxArray const* p)
 {
   mxIgraphRepr_t res;
-  char const* reps[MXIGRAPH_REPR_N] = { [MXIGRAPH_REPR_GRAPH] = "graph",
+  static char const* const reps[MXIGRAPH_REPR_N] = {
+    [MXIGRAPH_REPR_GRAPH] = "graph",
     [MXIGRAPH_REPR_FULL] = "full",
-    [MXIGRAPH_REPR_SPARSE] = "sparse" };
+    [MXIGRAPH_REPR_SPARSE] = "sparse",
+    [MXIGRAPH_REPR_EDGELIST] = "edgelist",
+    [MXIGRAPH_REPR_AUTO] = "auto" };
 
   return mxIgraphSelectMethod(mxGetField(p, 0, "repr"), reps, MXIGRAPH_REPR_N);
 }
@@ -82,8 +167,18 @@ mxIgraphRepr_t mxIgraphReprFromOptions(mxArray const* p)
 mxIgraphDType_t mxIgraphDTypeFromOptions(mxArray const* p)
 {
   mxIgraphDType_t res;
-  char const* dtypes[MXIGRAPH_DTYPE_N] = {
-    [MXIGRAPH_DTYPE_LOGICAL] = "logical", [MXIGRAPH_DTYPE_DOUBLE] = "double"
+  static char const* const dtypes[MXIGRAPH_DTYPE_N] = {
+    [MXIGRAPH_DTYPE_LOGICAL] = "logical",
+    [MXIGRAPH_DTYPE_DOUBLE] = "double",
+    [MXIGRAPH_DTYPE_SINGLE] = "single",
+    [MXIGRAPH_DTYPE_INT8] = "int8",
+    [MXIGRAPH_DTYPE_INT16] = "int16",
+    [MXIGRAPH_DTYPE_INT32] = "int32",
+    [MXIGRAPH_DTYPE_INT64] = "int64",
+    [MXIGRAPH_DTYPE_UINT8] = "uint8",
+    [MXIGRAPH_DTYPE_UINT16] = "uint16",
+    [MXIGRAPH_DTYPE_UINT32] = "uint32",
+    [MXIGRAPH_DTYPE_UINT64] = "uint64",
   };
 
   return mxIgraphSelectMethod(
@@ -96,7 +191,7 @@ igraph_neimode_t mxIgraphModeFromOptions(mxArray const* p)
   igraph_neimode_t res;
   igraph_integer_t n_modes = 3;
   // Mode enum starts at 1 not 0.
-  char const* modes[3] = {
+  static char const* const modes[3] = {
     [IGRAPH_OUT - 1] = "out", [IGRAPH_IN - 1] = "in", [IGRAPH_ALL - 1] = "all"
   };
 
@@ -143,11 +238,63 @@ igraph_bool_t mxIgraphBoolFromOptions(
   return arg ? mxGetScalar(arg) : 0;
 }
 
-char* mxIgraphStringFromOptions(
+/* Read a flag that is either a logical scalar or "infer".
+
+ Inferred flags are resolved by the conversion layer while it builds the
+ graph. A missing field is false, same as mxIgraphBoolFromOptions. MATLAB
+ string objects are converted to char arrays before being compared. */
+mxIgraphFlag_t mxIgraphFlagFromOptions(
   mxArray const* arg_struct, char const fieldname[1])
 {
   mxArray* arg = mxIgraphGetArgument(arg_struct, fieldname);
-  return arg ? mxArrayToString(arg) : "";
+  mxArray* chr = NULL;
+  char buf[sizeof("infer")] = "";
+
+  if (!arg) {
+    return MXIGRAPH_FLAG_FALSE;
+  }
+
+  if (mxIsClass(arg, "string")) {
+    mexCallMATLAB(1, &chr, 1, &arg, "char");
+    arg = chr;
+  }
+
+  if (!mxIsChar(arg)) {
+    return mxGetScalar(arg) ? MXIGRAPH_FLAG_TRUE : MXIGRAPH_FLAG_FALSE;
+  }
+
+  igraph_bool_t const is_infer = (mxGetString(arg, buf, sizeof(buf)) == 0) &&
+                                 (strcmp(buf, "infer") == 0);
+  if (chr) {
+    mxDestroyArray(chr);
+  }
+
+  if (!is_infer) {
+    mxIgraphSetError(IGRAPH_EINVAL);
+    mxIgraphSetErrorMsg(
+      "Option \"%s\" must be a logical scalar or \"infer\".", fieldname);
+  }
+
+  return MXIGRAPH_FLAG_INFER;
+}
+
+/* Copy a string option into buf. On failure the error status is set and buf
+   is left empty. */
+char* mxIgraphStringFromOptions(mxArray const* arg_struct,
+  char const fieldname[1], char* buf, size_t const buf_len)
+{
+  mxArray* arg = mxIgraphGetArgument(arg_struct, fieldname);
+
+  buf[0] = '\0';
+  if (arg && (!mxIsChar(arg) || mxGetString(arg, buf, buf_len) != 0)) {
+    buf[0] = '\0';
+    mxIgraphSetError(IGRAPH_EINVAL);
+    mxIgraphSetErrorMsg(
+      "Option \"%s\" must be a string of fewer than %d characters.",
+      fieldname, (int)buf_len);
+  }
+
+  return buf;
 }
 
 igraph_error_t mxIgraphVectorFromOptions(mxArray const* arg_struct,
@@ -197,3 +344,176 @@ igraph_error_t mxIgraphMatrixBoolFromOptions(mxArray const* arg_struct,
   return mxIgraphMatrixBoolFromArray(
     mxIgraphGetArgument(arg_struct, fieldname), mat, shift_start);
 }
+
+/* Find an option's field, trying the field number it was last seen at before
+   looking it up by name. Options structs passed by a given wrapper always
+   have the same layout, so after the first call this is a single string
+   comparison instead of a search over the field names. */
+static mxArray const* option_field_i(
+  mxArray const* arg_struct, mxIgraphOption_t* option)
+{
+  int const hint = option->field_hint - 1;
+
+  if ((hint < 0) || (hint >= mxGetNumberOfFields(arg_struct)) ||
+      (strcmp(mxGetFieldNameByNumber(arg_struct, hint), option->name) != 0)) {
+    int const number = mxGetFieldNumber(arg_struct, option->name);
+    if (number == -1) {
+      return NULL;
+    }
+    option->field_hint = number + 1;
+  }
+
+  return mxGetFieldByNumber(arg_struct, 0, option->field_hint - 1);
+}
+
+static igraph_error_t option_scalar_i(mxArray const* arg,
+  mxIgraphOption_t const* option, igraph_real_t* value)
+{
+  if (!(mxIsNumeric(arg) || mxIsLogical(arg)) || mxIsComplex(arg) ||
+      (mxGetNumberOfElements(arg) != 1)) {
+    IGRAPH_ERRORF("Option \"%s\" must be a real scalar.", IGRAPH_EINVAL,
+      option->name);
+  }
+
+  *value = mxGetScalar(arg);
+
+  if ((option->type == MXIGRAPH_OPTION_INTEGER) ||
+      (option->type == MXIGRAPH_OPTION_INDEX)) {
+    if (!isfinite(*value) || (*value != floor(*value))) {
+      IGRAPH_ERRORF("Option \"%s\" must be an integer.", IGRAPH_EINVAL,
+        option->name);
+    }
+  }
+
+  if (option->bounded && ((*value < option->min) || (*value > option->max))) {
+    IGRAPH_ERRORF("Option \"%s\" must be in [%g, %g], got %g.",
+      IGRAPH_EINVAL, option->name, option->min, option->max, *value);
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t option_choice_i(mxArray const* arg,
+  mxIgraphOption_t const* option, char const* const choices[],
+  igraph_integer_t const n_choices, igraph_integer_t* index)
+{
+  char name[MXIGRAPH_NAME_MAX];
+
+  if (mxIsChar(arg) && (mxGetString(arg, name, sizeof(name)) == 0)) {
+    for (igraph_integer_t i = 0; i < n_choices; i++) {
+      if (choices[i] && strcmp(name, choices[i]) == 0) {
+        *index = i;
+        return IGRAPH_SUCCESS;
+      }
+    }
+  }
+
+  IGRAPH_ERRORF("Option \"%s\" is not one of the accepted values.",
+    IGRAPH_EINVAL, option->name);
+}
+
+static igraph_error_t option_default_i(
+  mxIgraphOption_t const* option, char* dest)
+{
+  if (!option->optional) {
+    IGRAPH_ERRORF("Missing required option \"%s\".", IGRAPH_EINVAL,
+      option->name);
+  }
+
+  switch (option->type) {
+    case MXIGRAPH_OPTION_INTEGER:
+    case MXIGRAPH_OPTION_INDEX:
+    case MXIGRAPH_OPTION_CHOICE:
+      *(igraph_integer_t*)dest = option->default_value;
+      break;
+    case MXIGRAPH_OPTION_REAL:
+      *(igraph_real_t*)dest = option->default_value;
+      break;
+    case MXIGRAPH_OPTION_BOOL:
+      *(igraph_bool_t*)dest = option->default_value != 0;
+      break;
+    case MXIGRAPH_OPTION_MODE:
+      *(igraph_neimode_t*)dest = option->default_value;
+      break;
+    case MXIGRAPH_OPTION_STRING:
+      dest[0] = '\0';
+      break;
+    case MXIGRAPH_OPTION_ARRAY:
+      *(mxArray const**)dest = NULL;
+      break;
+    default:
+      IGRAPH_FATAL("Got an unexpected option type.");
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Fill the C struct res from the options struct arg_struct as described by
+   the schema options. All fields are read in one pass without allocating, so
+   this replaces a series of *FromOptions calls. */
+igraph_error_t mxIgraphParseOptions(mxArray const* arg_struct,
+  mxIgraphOption_t options[], igraph_integer_t const n_options, void* res)
+{
+  static char const* const modes[] = {
+    [IGRAPH_OUT - 1] = "out", [IGRAPH_IN - 1] = "in", [IGRAPH_ALL - 1] = "all"
+  };
+
+  if (!mxIsStruct(arg_struct) || mxIsEmpty(arg_struct)) {
+    IGRAPH_ERROR("Options must be passed as a struct.", IGRAPH_EINVAL);
+  }
+
+  for (igraph_integer_t i = 0; i < n_options; i++) {
+    mxIgraphOption_t* option = options + i;
+    mxArray const* arg = option_field_i(arg_struct, option);
+    char* dest = (char*)res + option->offset;
+    igraph_real_t value;
+    igraph_integer_t index;
+
+    if (!arg || (mxIsEmpty(arg) && option->type != MXIGRAPH_OPTION_ARRAY)) {
+      IGRAPH_CHECK(option_default_i(option, dest));
+      continue;
+    }
+
+    switch (option->type) {
+      case MXIGRAPH_OPTION_INTEGER:
+        IGRAPH_CHECK(option_scalar_i(arg, option, &value));
+        *(igraph_integer_t*)dest = value;
+        break;
+      case MXIGRAPH_OPTION_INDEX:
+        IGRAPH_CHECK(option_scalar_i(arg, option, &value));
+        *(igraph_integer_t*)dest = value - 1;
+        break;
+      case MXIGRAPH_OPTION_REAL:
+        IGRAPH_CHECK(option_scalar_i(arg, option, &value));
+        *(igraph_real_t*)dest = value;
+        break;
+      case MXIGRAPH_OPTION_BOOL:
+        IGRAPH_CHECK(option_scalar_i(arg, option, &value));
+        *(igraph_bool_t*)dest = value != 0;
+        break;
+      case MXIGRAPH_OPTION_MODE:
+        IGRAPH_CHECK(option_choice_i(arg, option, modes, 3, &index));
+        *(igraph_neimode_t*)dest = index + 1;
+        break;
+      case MXIGRAPH_OPTION_CHOICE:
+        IGRAPH_CHECK(option_choice_i(
+          arg, option, option->choices, option->n_choices, &index));
+        *(igraph_integer_t*)dest = index;
+        break;
+      case MXIGRAPH_OPTION_STRING:
+        if (!mxIsChar(arg) || (mxGetString(arg, dest, MXIGRAPH_NAME_MAX))) {
+          IGRAPH_ERRORF(
+            "Option \"%s\" must be a string of fewer than %d characters.",
+            IGRAPH_EINVAL, option->name, MXIGRAPH_NAME_MAX);
+        }
+        break;
+      case MXIGRAPH_OPTION_ARRAY:
+        *(mxArray const**)dest = arg;
+        break;
+      default:
+        IGRAPH_FATAL("Got an unexpected option type.");
+    }
+  }
+
+  return IGRAPH_SUCCESS;
+}
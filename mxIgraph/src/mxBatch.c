@@ -0,0 +1,241 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Run an igraph function over many graphs at once.
+
+ Batches are split into a prepare and a run phase. Everything that touches
+ the MATLAB API (converting graphs, reading options and creating results)
+ happens on the calling thread in the prepare phase or after the run, so the
+ task function handed to `mxIgraphBatchRun` only calls igraph.
+
+ igraph keeps its error handlers, finally stack and default RNG in thread
+ local storage when built with IGRAPH_ENABLE_TLS. Each task replaces the
+ handlers with ones that do not call back into MATLAB and runs with its own
+ RNG stream (see mxStream.c). All streams share a seed taken from a single
+ draw of the default RNG and are told apart by the task's index, so results
+ only depend on the default RNG's seed and not on how many threads ran or
+ how tasks were scheduled.
+ Without thread local storage igraph is not safe to call from several
+ threads and the tasks are run one after the other on the calling thread.
+
+ Task errors are returned rather than raised. The handlers record the first
+ error and warning message of each task so they can be reported on the
+ calling thread once the batch is done. */
+
+#include <mxIgraph.h>
+#include <stdio.h>
+
+#if IGRAPH_THREAD_SAFE
+#  define MXIGRAPH_THREAD_LOCAL _Thread_local
+#else
+#  define MXIGRAPH_THREAD_LOCAL
+#endif
+
+#define MXIGRAPH_BATCH_MSG_MAX 256
+
+typedef struct {
+  char error[MXIGRAPH_BATCH_MSG_MAX];
+  char warning[MXIGRAPH_BATCH_MSG_MAX];
+  igraph_bool_t warned;
+} mxIgraph_batch_log_t;
+
+typedef struct {
+  mxIgraphBatchTask_t* fn;
+  void* data;
+  igraph_uint_t seed;
+  igraph_error_t* errors;
+  mxIgraph_batch_log_t* logs;
+} mxIgraph_batch_t;
+
+/* Log of the task running on this thread. */
+static MXIGRAPH_THREAD_LOCAL mxIgraph_batch_log_t* task_log = NULL;
+
+/* Error message of the failed task from the last batch. Only touched on the
+ calling thread. */
+static char batch_error[MXIGRAPH_BATCH_MSG_MAX] = "";
+
+/* igraph calls the error handler again with an empty reason at every
+ IGRAPH_CHECK the error passes through, only the first reason is kept. */
+static void batch_error_handler_i(char const* reason, char const* file,
+  int line, igraph_error_t igraph_errno)
+{
+  if (task_log && (task_log->error[0] == '\0') && reason &&
+      (reason[0] != '\0')) {
+    snprintf(task_log->error, sizeof(task_log->error), "%s", reason);
+  }
+
+  igraph_error_handler_ignore(reason, file, line, igraph_errno);
+}
+
+static void batch_warning_handler_i(
+  char const* reason, char const* file, int line)
+{
+  IGRAPH_UNUSED(file);
+  IGRAPH_UNUSED(line);
+
+  if (task_log && !task_log->warned) {
+    snprintf(task_log->warning, sizeof(task_log->warning), "%s", reason);
+    task_log->warned = true;
+  }
+}
+
+/* Raise the first task warning on the calling thread, where the warning
+ handler can pass it on to MATLAB. Tasks tend to warn for the same reason so
+ only the first message is shown along with how many tasks warned. */
+static void batch_report_warnings_i(
+  mxIgraph_batch_log_t const* logs, igraph_integer_t const n_tasks)
+{
+  igraph_integer_t first = -1;
+  igraph_integer_t n_warned = 0;
+
+  for (igraph_integer_t i = 0; i < n_tasks; i++) {
+    if (logs[i].warned) {
+      first = first < 0 ? i : first;
+      n_warned++;
+    }
+  }
+
+  if (n_warned == 0) {
+    return;
+  }
+
+  IGRAPH_WARNINGF("%s (%" IGRAPH_PRId " of %" IGRAPH_PRId
+                  " tasks warned, first was task %" IGRAPH_PRId ")",
+    logs[first].warning, n_warned, n_tasks, first + 1);
+}
+
+static igraph_bool_t batch_task_i(igraph_integer_t const task,
+  igraph_integer_t const thread, void* data)
+{
+  mxIgraph_batch_t* batch = data;
+  igraph_rng_t rng;
+  igraph_rng_t* default_rng = igraph_rng_default();
+  igraph_error_handler_t* error_handler =
+    igraph_set_error_handler(batch_error_handler_i);
+  igraph_warning_handler_t* warning_handler =
+    igraph_set_warning_handler(batch_warning_handler_i);
+  igraph_progress_handler_t* progress_handler =
+    igraph_set_progress_handler(NULL);
+  igraph_status_handler_t* status_handler = igraph_set_status_handler(NULL);
+  igraph_interruption_handler_t* interruption_handler =
+    igraph_set_interruption_handler(NULL);
+  igraph_error_t rs;
+
+  task_log = batch->logs + task;
+  rs = mxIgraphRNGStreamInit(&rng, batch->seed, task);
+
+  if (rs == IGRAPH_SUCCESS) {
+    igraph_rng_set_default(&rng);
+    rs = batch->fn(task, thread, batch->data);
+    igraph_rng_set_default(default_rng);
+    igraph_rng_destroy(&rng);
+  }
+
+  igraph_set_error_handler(error_handler);
+  igraph_set_warning_handler(warning_handler);
+  igraph_set_progress_handler(progress_handler);
+  igraph_set_status_handler(status_handler);
+  igraph_set_interruption_handler(interruption_handler);
+  task_log = NULL;
+
+  batch->errors[task] = rs;
+
+  return rs == IGRAPH_SUCCESS;
+}
+
+/* Run fn on tasks 0..n_tasks - 1, in parallel when igraph is thread safe.
+
+ Like mxIgraphParallelFor, fn is also passed the index of the thread it is
+ running on, which is less than both mxIgraphThreadCount() and n_tasks.
+
+ Returns IGRAPH_SUCCESS if every task succeeded. Otherwise returns the error
+ of the lowest numbered failing task and stores its index in failed, its
+ message is available from mxIgraphBatchError until the next batch. Once a
+ task fails no new tasks are started.
+
+ Warnings raised by the tasks are passed to the warning handler after the
+ batch finishes, whether or not it succeeded.
+
+ The finally stack must be empty when this is called. The task error
+ handler frees the stack, which would destroy the caller's data while other
+ tasks are still using it. Callers should clean their entries off the stack
+ before the run and put them back, or destroy them, afterwards. */
+igraph_error_t mxIgraphBatchRun(igraph_integer_t const n_tasks,
+  mxIgraphBatchTask_t* fn, void* data, igraph_integer_t* failed)
+{
+  mxIgraph_batch_t batch = { .fn = fn, .data = data };
+  igraph_rng_t* rng = igraph_rng_default();
+  igraph_error_t rs = IGRAPH_SUCCESS;
+
+  *failed = -1;
+  batch_error[0] = '\0';
+  if (n_tasks == 0) {
+    return IGRAPH_SUCCESS;
+  }
+
+  /* Drawn on the calling thread since the default RNG may be MATLAB's, which
+     is not thread safe. */
+  batch.seed = ((igraph_uint_t)igraph_rng_get_integer(rng, 0, 0xFFFFFFFF)
+                 << 32) |
+               (igraph_uint_t)igraph_rng_get_integer(rng, 0, 0xFFFFFFFF);
+
+  batch.errors = IGRAPH_CALLOC(n_tasks, igraph_error_t);
+  batch.logs = IGRAPH_CALLOC(n_tasks, mxIgraph_batch_log_t);
+  if (!batch.errors || !batch.logs) {
+    IGRAPH_FREE(batch.errors);
+    IGRAPH_FREE(batch.logs);
+    return IGRAPH_ENOMEM;
+  }
+
+  for (igraph_integer_t i = 0; i < n_tasks; i++) {
+    batch.errors[i] = IGRAPH_SUCCESS;
+  }
+
+#if IGRAPH_THREAD_SAFE
+  mxIgraphParallelFor(n_tasks, batch_task_i, &batch);
+#else
+  for (igraph_integer_t i = 0; i < n_tasks; i++) {
+    if (!batch_task_i(i, 0, &batch)) {
+      break;
+    }
+  }
+#endif
+
+  for (igraph_integer_t i = 0; i < n_tasks; i++) {
+    if (batch.errors[i] != IGRAPH_SUCCESS) {
+      rs = batch.errors[i];
+      *failed = i;
+      snprintf(batch_error, sizeof(batch_error), "%s", batch.logs[i].error);
+      break;
+    }
+  }
+
+  batch_report_warnings_i(batch.logs, n_tasks);
+
+  IGRAPH_FREE(batch.errors);
+  IGRAPH_FREE(batch.logs);
+
+  return rs;
+}
+
+/* Message of the task that made the last call to mxIgraphBatchRun fail.
+ Empty if the batch succeeded or the task's error had no message. */
+char const* mxIgraphBatchError(void)
+{
+  return batch_error;
+}
@@ -0,0 +1,364 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Cache of converted graphs.
+
+ Converting a MATLAB adjacency matrix to an igraph graph is often more
+ expensive than the algorithm run on it, and analysis loops tend to call
+ several functions on the same matrix. The cache keeps the most recently used
+ conversions alive between mex calls so repeated calls on the same input can
+ skip the conversion.
+
+ Entries are keyed on the identity of the input (data pointers, class and
+ dimensions) along with the graph options that affect conversion. MATLAB may
+ modify an array in place without changing its data pointer, so a hash of the
+ array's content is part of the key as well. Hashing is a single linear read
+ of the data and is much cheaper than a conversion.
+
+ Graphs are handed out as borrowed pointers. Any entry handed out during the
+ current mex call is pinned so it can not be evicted while the caller is
+ using it, `mxIgraphCacheRelease` unpins them and should be called once the
+ mex function is done with its graphs.
+
+ Graph and digraph objects are not cached since they have no data pointer to
+ key on and getting their edges requires calling back into MATLAB anyway.
+ Edge list structures are already in igraph's layout so converting them
+ costs no more than hashing them would. */
+
+#include <mxIgraph.h>
+#include <string.h>
+
+#define MXIGRAPH_CACHE_DEFAULT_CAPACITY 4
+
+typedef struct {
+  mxClassID class_id;
+  igraph_bool_t is_sparse;
+  mwSize m;
+  mwSize n;
+  mwSize nnz;
+  void const* data;
+  mwIndex const* ir;
+  mwIndex const* jc;
+  uint64_t fingerprint;
+  mxIgraphFlag_t is_directed;
+  mxIgraphFlag_t is_weighted;
+} mxIgraph_cache_key_t;
+
+typedef struct {
+  mxIgraph_cache_key_t key;
+  igraph_t graph;
+  igraph_vector_t weights;
+  igraph_integer_t last_used;
+  igraph_bool_t pinned;
+} mxIgraph_cache_entry_t;
+
+static mxIgraph_cache_entry_t** cache_entries = NULL;
+static igraph_integer_t cache_size = 0;
+static igraph_integer_t cache_allocated = 0;
+static igraph_integer_t cache_capacity = MXIGRAPH_CACHE_DEFAULT_CAPACITY;
+static igraph_integer_t cache_clock = 0;
+static igraph_integer_t cache_hits = 0;
+static igraph_integer_t cache_misses = 0;
+static igraph_bool_t cache_exit_registered = false;
+
+static inline uint64_t hash_mix_i(uint64_t h, uint64_t word)
+{
+  h ^= word * 0x9E3779B97F4A7C15ULL;
+  h = (h << 31) | (h >> 33);
+  return h * 0xC2B2AE3D27D4EB4FULL;
+}
+
+/* Hash a block of memory a word at a time. */
+static uint64_t hash_bytes_i(uint64_t h, void const* data, size_t const len)
+{
+  unsigned char const* bytes = data;
+  size_t const n_words = len / sizeof(uint64_t);
+  uint64_t word;
+
+  for (size_t i = 0; i < n_words; i++) {
+    memcpy(&word, bytes + (i * sizeof(word)), sizeof(word));
+    h = hash_mix_i(h, word);
+  }
+
+  if (len % sizeof(word)) {
+    word = 0;
+    memcpy(&word, bytes + (n_words * sizeof(word)), len % sizeof(word));
+    h = hash_mix_i(h, word);
+  }
+
+  return hash_mix_i(h, len);
+}
+
+static uint64_t fingerprint_i(mxArray const* p)
+{
+  uint64_t h = 0xCBF29CE484222325ULL;
+  size_t const elem_size = mxGetElementSize(p);
+
+  if (mxIsSparse(p)) {
+    mwSize const n = mxGetN(p);
+    mwIndex const* jc = mxGetJc(p);
+    mwSize const nnz = jc[n];
+    h = hash_bytes_i(h, jc, (n + 1) * sizeof(*jc));
+    h = hash_bytes_i(h, mxGetIr(p), nnz * sizeof(mwIndex));
+    h = hash_bytes_i(h, mxGetData(p), nnz * elem_size);
+  } else {
+    h = hash_bytes_i(h, mxGetData(p), mxGetNumberOfElements(p) * elem_size);
+  }
+
+  return h;
+}
+
+static void make_key_i(mxArray const* p, mxIgraphFlag_t const is_directed,
+  mxIgraphFlag_t const is_weighted, mxIgraph_cache_key_t* key)
+{
+  memset(key, 0, sizeof(*key));
+
+  key->class_id = mxGetClassID(p);
+  key->is_sparse = mxIsSparse(p);
+  key->m = mxGetM(p);
+  key->n = mxGetN(p);
+  key->data = mxGetData(p);
+  if (key->is_sparse) {
+    key->ir = mxGetIr(p);
+    key->jc = mxGetJc(p);
+    key->nnz = key->jc[key->n];
+  } else {
+    key->nnz = mxGetNumberOfElements(p);
+  }
+  key->fingerprint = fingerprint_i(p);
+  key->is_directed = is_directed;
+  key->is_weighted = is_weighted;
+}
+
+static igraph_bool_t key_equal_i(
+  mxIgraph_cache_key_t const* a, mxIgraph_cache_key_t const* b)
+{
+  return (a->class_id == b->class_id) && (a->is_sparse == b->is_sparse) &&
+         (a->m == b->m) && (a->n == b->n) && (a->nnz == b->nnz) &&
+         (a->data == b->data) && (a->ir == b->ir) && (a->jc == b->jc) &&
+         (a->fingerprint == b->fingerprint) &&
+         (a->is_directed == b->is_directed) &&
+         (a->is_weighted == b->is_weighted);
+}
+
+static void entry_destroy_i(mxIgraph_cache_entry_t* entry)
+{
+  igraph_destroy(&entry->graph);
+  igraph_vector_destroy(&entry->weights);
+  igraph_free(entry);
+}
+
+static void remove_entry_i(igraph_integer_t const idx)
+{
+  entry_destroy_i(cache_entries[idx]);
+  cache_entries[idx] = cache_entries[cache_size - 1];
+  cache_size--;
+}
+
+/* Evict least recently used entries that are not pinned until there are at
+   most `limit` entries. */
+static void trim_i(igraph_integer_t const limit)
+{
+  while (cache_size > limit) {
+    igraph_integer_t oldest = -1;
+    for (igraph_integer_t i = 0; i < cache_size; i++) {
+      if (cache_entries[i]->pinned) {
+        continue;
+      }
+
+      if ((oldest == -1) ||
+          (cache_entries[i]->last_used < cache_entries[oldest]->last_used)) {
+        oldest = i;
+      }
+    }
+
+    if (oldest == -1) {
+      return;
+    }
+
+    remove_entry_i(oldest);
+  }
+}
+
+static void cache_at_exit_i(void)
+{
+  for (igraph_integer_t i = 0; i < cache_size; i++) {
+    entry_destroy_i(cache_entries[i]);
+  }
+
+  igraph_free(cache_entries);
+  cache_entries = NULL;
+  cache_size = 0;
+  cache_allocated = 0;
+}
+
+static igraph_error_t insert_entry_i(mxIgraph_cache_entry_t* entry)
+{
+  if (!cache_exit_registered) {
+    mexAtExit(cache_at_exit_i);
+    cache_exit_registered = true;
+  }
+
+  /* Make room before adding so the cache does not grow passed capacity
+     unless every entry is in use by the current call. */
+  trim_i(cache_capacity > 0 ? cache_capacity - 1 : 0);
+
+  if (cache_size == cache_allocated) {
+    igraph_integer_t const new_size =
+      cache_allocated > 0 ? 2 * cache_allocated : 4;
+    mxIgraph_cache_entry_t** tmp = IGRAPH_REALLOC(
+      cache_entries, (size_t)new_size, mxIgraph_cache_entry_t*);
+    if (!tmp) {
+      IGRAPH_ERROR("Failed to grow graph cache.", IGRAPH_ENOMEM);
+    }
+    cache_entries = tmp;
+    cache_allocated = new_size;
+  }
+
+  cache_entries[cache_size] = entry;
+  cache_size++;
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Get a graph for the adjacency matrix or graph object p, reusing a cached
+   conversion if one exists.
+
+   Unlike `mxIgraphFromArray`, the graph and weights are owned by the cache
+   and must not be modified or destroyed by the caller. They stay valid until
+   the next call to `mxIgraphCacheRelease`. Functions that modify their graph
+   in place should use `mxIgraphFromArray` to get their own copy.
+
+   An unweighted graph gets an empty weight vector, so weights should be
+   passed to igraph functions through `MXIGRAPH_WEIGHTS`.
+
+   Entries are keyed on the flags as given, so a graph converted with
+   inferred flags is only reused by calls that also ask for inference. */
+igraph_error_t mxIgraphFromArrayCached(mxArray const* p,
+  igraph_t const** graph, igraph_vector_t const** weights,
+  mxArray const* graph_options)
+{
+  mxIgraphFlag_t const is_directed =
+    mxIgraphFlagFromOptions(graph_options, "isdirected");
+  mxIgraphFlag_t const is_weighted =
+    mxGetField(graph_options, 0, "isweighted")
+      ? mxIgraphFlagFromOptions(graph_options, "isweighted")
+      : MXIGRAPH_FLAG_FALSE;
+  MXIGRAPH_CHECK_STATUS();
+
+  mxIgraph_cache_key_t key;
+  mxIgraph_cache_entry_t* entry;
+  igraph_bool_t const cacheable =
+    !(mxIgraphIsGraph(p) || mxIgraphIsEdgeList(p));
+
+  if (cacheable) {
+    make_key_i(p, is_directed, is_weighted, &key);
+    for (igraph_integer_t i = 0; i < cache_size; i++) {
+      if (key_equal_i(&key, &cache_entries[i]->key)) {
+        entry = cache_entries[i];
+        entry->last_used = ++cache_clock;
+        entry->pinned = true;
+        cache_hits++;
+
+        *graph = &entry->graph;
+        *weights = &entry->weights;
+        return IGRAPH_SUCCESS;
+      }
+    }
+
+    cache_misses++;
+  }
+
+  entry = IGRAPH_CALLOC(1, mxIgraph_cache_entry_t);
+  if (!entry) {
+    IGRAPH_ERROR("Failed to allocate graph cache entry.", IGRAPH_ENOMEM);
+  }
+  IGRAPH_FINALLY(igraph_free, entry);
+
+  IGRAPH_CHECK(
+    mxIgraphFromArray(p, &entry->graph, &entry->weights, graph_options));
+  IGRAPH_FINALLY(igraph_destroy, &entry->graph);
+  IGRAPH_FINALLY(igraph_vector_destroy, &entry->weights);
+
+  if (cacheable) {
+    entry->key = key;
+  } else {
+    /* Give uncacheable graphs a key that can never match so they are freed
+       on release like any other entry but never returned by a lookup. */
+    memset(&entry->key, 0, sizeof(entry->key));
+    entry->key.class_id = mxUNKNOWN_CLASS;
+  }
+  entry->last_used = cacheable ? ++cache_clock : -1;
+  entry->pinned = true;
+
+  IGRAPH_CHECK(insert_entry_i(entry));
+  IGRAPH_FINALLY_CLEAN(3);
+
+  *graph = &entry->graph;
+  *weights = &entry->weights;
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Release all graphs handed out by `mxIgraphFromArrayCached`.
+
+ After this, previously returned graphs can be evicted at any time so they
+ should no longer be used. Uncacheable graphs are freed immediately and the
+ cache is trimmed back to its capacity. */
+void mxIgraphCacheRelease(void)
+{
+  for (igraph_integer_t i = cache_size - 1; i >= 0; i--) {
+    if (cache_entries[i]->key.class_id == mxUNKNOWN_CLASS) {
+      remove_entry_i(i);
+    } else {
+      cache_entries[i]->pinned = false;
+    }
+  }
+
+  trim_i(cache_capacity);
+}
+
+/* Free all cached graphs and reset the hit and miss counters. */
+void mxIgraphCacheClear(void)
+{
+  for (igraph_integer_t i = cache_size - 1; i >= 0; i--) {
+    if (!cache_entries[i]->pinned) {
+      remove_entry_i(i);
+    }
+  }
+
+  cache_hits = 0;
+  cache_misses = 0;
+}
+
+/* Set the maximum number of graphs to keep between calls.
+
+ A capacity of 0 disables caching. */
+void mxIgraphCacheSetCapacity(igraph_integer_t const capacity)
+{
+  cache_capacity = capacity < 0 ? 0 : capacity;
+  trim_i(cache_capacity);
+}
+
+void mxIgraphCacheStats(mxIgraphCacheStats_t* stats)
+{
+  stats->hits = cache_hits;
+  stats->misses = cache_misses;
+  stats->size = cache_size;
+  stats->capacity = cache_capacity;
+}
@@ -0,0 +1,580 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mxDense.h"
+#include "mxNumeric.h"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                             \
+  (defined(__GNUC__) || defined(__clang__))
+# define MXIGRAPH_X86_DISPATCH 1
+# include <immintrin.h>
+#else
+# define MXIGRAPH_X86_DISPATCH 0
+#endif
+
+/* Side length of the tiles used to compare a matrix against its transpose.
+   A tile of doubles is 8KiB so a tile and its buffered mirror fit in L1. */
+#define MXIGRAPH_DENSE_TILE 32
+
+/* Logical and integer matrices are equal, or zero, exactly when their bytes
+   are so they share the byte kernels. Only floating point needs its own
+   comparisons, for NaNs and signed zeros. */
+typedef struct {
+  igraph_bool_t (*equal_double)(double const*, double const*, size_t);
+  igraph_bool_t (*any_nonzero_double)(double const*, size_t);
+  igraph_bool_t (*any_nonbinary_double)(double const*, size_t);
+  igraph_bool_t (*equal_single)(float const*, float const*, size_t);
+  igraph_bool_t (*any_nonzero_single)(float const*, size_t);
+  igraph_bool_t (*any_nonbinary_single)(float const*, size_t);
+  igraph_bool_t (*equal_bytes)(uint8_t const*, uint8_t const*, size_t);
+  igraph_bool_t (*any_nonzero_bytes)(uint8_t const*, size_t);
+} dense_kernels_t;
+
+/* Scalar kernels. Comparisons use != so NaNs are never equal to anything,
+   matching the element by element checks. */
+
+#define FLOAT_SCALAR_KERNELS(name, type)                                      \
+  static igraph_bool_t equal_##name##_scalar_i(                               \
+    type const* a, type const* b, size_t const len)                           \
+  {                                                                           \
+    for (size_t i = 0; i < len; i++) {                                        \
+      if (a[i] != b[i]) {                                                     \
+        return false;                                                         \
+      }                                                                       \
+    }                                                                         \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  static igraph_bool_t any_nonzero_##name##_scalar_i(                         \
+    type const* a, size_t const len)                                          \
+  {                                                                           \
+    for (size_t i = 0; i < len; i++) {                                        \
+      if (a[i] != 0) {                                                        \
+        return true;                                                          \
+      }                                                                       \
+    }                                                                         \
+                                                                              \
+    return false;                                                             \
+  }                                                                           \
+                                                                              \
+  static igraph_bool_t any_nonbinary_##name##_scalar_i(                       \
+    type const* a, size_t const len)                                          \
+  {                                                                           \
+    for (size_t i = 0; i < len; i++) {                                        \
+      if ((a[i] != 0) && (a[i] != 1)) {                                       \
+        return true;                                                          \
+      }                                                                       \
+    }                                                                         \
+                                                                              \
+    return false;                                                             \
+  }
+
+FLOAT_SCALAR_KERNELS(double, double)
+FLOAT_SCALAR_KERNELS(single, float)
+
+#undef FLOAT_SCALAR_KERNELS
+
+static igraph_bool_t equal_bytes_scalar_i(
+  uint8_t const* a, uint8_t const* b, size_t const len)
+{
+  return memcmp(a, b, len) == 0;
+}
+
+static igraph_bool_t any_nonzero_bytes_scalar_i(
+  uint8_t const* a, size_t const len)
+{
+  for (size_t i = 0; i < len; i++) {
+    if (a[i]) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#if MXIGRAPH_X86_DISPATCH
+
+/* AVX2 kernels, two vectors per iteration. Remainders go to the scalar
+   kernels. */
+
+__attribute__((target("avx2"))) static igraph_bool_t equal_double_avx2_i(
+  double const* a, double const* b, size_t const len)
+{
+  size_t i = 0;
+  for (; (i + 8) <= len; i += 8) {
+    __m256d const neq0 = _mm256_cmp_pd(
+      _mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_NEQ_UQ);
+    __m256d const neq1 = _mm256_cmp_pd(
+      _mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), _CMP_NEQ_UQ);
+    if (_mm256_movemask_pd(_mm256_or_pd(neq0, neq1))) {
+      return false;
+    }
+  }
+
+  return equal_double_scalar_i(a + i, b + i, len - i);
+}
+
+__attribute__((target("avx2"))) static igraph_bool_t
+any_nonzero_double_avx2_i(double const* a, size_t const len)
+{
+  __m256d const zero = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; (i + 8) <= len; i += 8) {
+    __m256d const nz0 = _mm256_cmp_pd(_mm256_loadu_pd(a + i), zero,
+      _CMP_NEQ_UQ);
+    __m256d const nz1 = _mm256_cmp_pd(_mm256_loadu_pd(a + i + 4), zero,
+      _CMP_NEQ_UQ);
+    if (_mm256_movemask_pd(_mm256_or_pd(nz0, nz1))) {
+      return true;
+    }
+  }
+
+  return any_nonzero_double_scalar_i(a + i, len - i);
+}
+
+__attribute__((target("avx2"))) static igraph_bool_t
+any_nonbinary_double_avx2_i(double const* a, size_t const len)
+{
+  __m256d const zero = _mm256_setzero_pd();
+  __m256d const one = _mm256_set1_pd(1);
+  size_t i = 0;
+  for (; (i + 4) <= len; i += 4) {
+    __m256d const x = _mm256_loadu_pd(a + i);
+    __m256d const nonbinary = _mm256_and_pd(
+      _mm256_cmp_pd(x, zero, _CMP_NEQ_UQ), _mm256_cmp_pd(x, one, _CMP_NEQ_UQ));
+    if (_mm256_movemask_pd(nonbinary)) {
+      return true;
+    }
+  }
+
+  return any_nonbinary_double_scalar_i(a + i, len - i);
+}
+
+__attribute__((target("avx2"))) static igraph_bool_t equal_single_avx2_i(
+  float const* a, float const* b, size_t const len)
+{
+  size_t i = 0;
+  for (; (i + 16) <= len; i += 16) {
+    __m256 const neq0 = _mm256_cmp_ps(
+      _mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_NEQ_UQ);
+    __m256 const neq1 = _mm256_cmp_ps(
+      _mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), _CMP_NEQ_UQ);
+    if (_mm256_movemask_ps(_mm256_or_ps(neq0, neq1))) {
+      return false;
+    }
+  }
+
+  return equal_single_scalar_i(a + i, b + i, len - i);
+}
+
+__attribute__((target("avx2"))) static igraph_bool_t
+any_nonzero_single_avx2_i(float const* a, size_t const len)
+{
+  __m256 const zero = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; (i + 16) <= len; i += 16) {
+    __m256 const nz0 = _mm256_cmp_ps(_mm256_loadu_ps(a + i), zero,
+      _CMP_NEQ_UQ);
+    __m256 const nz1 = _mm256_cmp_ps(_mm256_loadu_ps(a + i + 8), zero,
+      _CMP_NEQ_UQ);
+    if (_mm256_movemask_ps(_mm256_or_ps(nz0, nz1))) {
+      return true;
+    }
+  }
+
+  return any_nonzero_single_scalar_i(a + i, len - i);
+}
+
+__attribute__((target("avx2"))) static igraph_bool_t
+any_nonbinary_single_avx2_i(float const* a, size_t const len)
+{
+  __m256 const zero = _mm256_setzero_ps();
+  __m256 const one = _mm256_set1_ps(1);
+  size_t i = 0;
+  for (; (i + 8) <= len; i += 8) {
+    __m256 const x = _mm256_loadu_ps(a + i);
+    __m256 const nonbinary = _mm256_and_ps(
+      _mm256_cmp_ps(x, zero, _CMP_NEQ_UQ), _mm256_cmp_ps(x, one, _CMP_NEQ_UQ));
+    if (_mm256_movemask_ps(nonbinary)) {
+      return true;
+    }
+  }
+
+  return any_nonbinary_single_scalar_i(a + i, len - i);
+}
+
+__attribute__((target("avx2"))) static igraph_bool_t equal_bytes_avx2_i(
+  uint8_t const* a, uint8_t const* b, size_t const len)
+{
+  size_t i = 0;
+  for (; (i + 32) <= len; i += 32) {
+    __m256i const eq =
+      _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(a + i)),
+        _mm256_loadu_si256((__m256i const*)(b + i)));
+    if (_mm256_movemask_epi8(eq) != -1) {
+      return false;
+    }
+  }
+
+  return equal_bytes_scalar_i(a + i, b + i, len - i);
+}
+
+__attribute__((target("avx2"))) static igraph_bool_t
+any_nonzero_bytes_avx2_i(uint8_t const* a, size_t const len)
+{
+  size_t i = 0;
+  for (; (i + 64) <= len; i += 64) {
+    __m256i const x = _mm256_or_si256(
+      _mm256_loadu_si256((__m256i const*)(a + i)),
+      _mm256_loadu_si256((__m256i const*)(a + i + 32)));
+    if (!_mm256_testz_si256(x, x)) {
+      return true;
+    }
+  }
+
+  return any_nonzero_bytes_scalar_i(a + i, len - i);
+}
+
+/* AVX-512 kernels. Only the floating point kernels, the byte compares would
+   need AVX-512BW and are already bandwidth bound with AVX2. */
+
+__attribute__((target("avx512f"))) static igraph_bool_t
+equal_double_avx512_i(double const* a, double const* b, size_t const len)
+{
+  size_t i = 0;
+  for (; (i + 16) <= len; i += 16) {
+    __mmask8 const neq0 = _mm512_cmp_pd_mask(
+      _mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), _CMP_NEQ_UQ);
+    __mmask8 const neq1 = _mm512_cmp_pd_mask(
+      _mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), _CMP_NEQ_UQ);
+    if (neq0 | neq1) {
+      return false;
+    }
+  }
+
+  return equal_double_scalar_i(a + i, b + i, len - i);
+}
+
+__attribute__((target("avx512f"))) static igraph_bool_t
+any_nonzero_double_avx512_i(double const* a, size_t const len)
+{
+  __m512d const zero = _mm512_setzero_pd();
+  size_t i = 0;
+  for (; (i + 16) <= len; i += 16) {
+    __mmask8 const nz0 = _mm512_cmp_pd_mask(_mm512_loadu_pd(a + i), zero,
+      _CMP_NEQ_UQ);
+    __mmask8 const nz1 = _mm512_cmp_pd_mask(_mm512_loadu_pd(a + i + 8), zero,
+      _CMP_NEQ_UQ);
+    if (nz0 | nz1) {
+      return true;
+    }
+  }
+
+  return any_nonzero_double_scalar_i(a + i, len - i);
+}
+
+__attribute__((target("avx512f"))) static igraph_bool_t
+any_nonbinary_double_avx512_i(double const* a, size_t const len)
+{
+  __m512d const zero = _mm512_setzero_pd();
+  __m512d const one = _mm512_set1_pd(1);
+  size_t i = 0;
+  for (; (i + 8) <= len; i += 8) {
+    __m512d const x = _mm512_loadu_pd(a + i);
+    __mmask8 const nonzero = _mm512_cmp_pd_mask(x, zero, _CMP_NEQ_UQ);
+    if (_mm512_mask_cmp_pd_mask(nonzero, x, one, _CMP_NEQ_UQ)) {
+      return true;
+    }
+  }
+
+  return any_nonbinary_double_scalar_i(a + i, len - i);
+}
+
+__attribute__((target("avx512f"))) static igraph_bool_t
+equal_single_avx512_i(float const* a, float const* b, size_t const len)
+{
+  size_t i = 0;
+  for (; (i + 32) <= len; i += 32) {
+    __mmask16 const neq0 = _mm512_cmp_ps_mask(
+      _mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), _CMP_NEQ_UQ);
+    __mmask16 const neq1 = _mm512_cmp_ps_mask(
+      _mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), _CMP_NEQ_UQ);
+    if (neq0 | neq1) {
+      return false;
+    }
+  }
+
+  return equal_single_scalar_i(a + i, b + i, len - i);
+}
+
+__attribute__((target("avx512f"))) static igraph_bool_t
+any_nonzero_single_avx512_i(float const* a, size_t const len)
+{
+  __m512 const zero = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; (i + 32) <= len; i += 32) {
+    __mmask16 const nz0 = _mm512_cmp_ps_mask(_mm512_loadu_ps(a + i), zero,
+      _CMP_NEQ_UQ);
+    __mmask16 const nz1 = _mm512_cmp_ps_mask(_mm512_loadu_ps(a + i + 16),
+      zero, _CMP_NEQ_UQ);
+    if (nz0 | nz1) {
+      return true;
+    }
+  }
+
+  return any_nonzero_single_scalar_i(a + i, len - i);
+}
+
+__attribute__((target("avx512f"))) static igraph_bool_t
+any_nonbinary_single_avx512_i(float const* a, size_t const len)
+{
+  __m512 const zero = _mm512_setzero_ps();
+  __m512 const one = _mm512_set1_ps(1);
+  size_t i = 0;
+  for (; (i + 16) <= len; i += 16) {
+    __m512 const x = _mm512_loadu_ps(a + i);
+    __mmask16 const nonzero = _mm512_cmp_ps_mask(x, zero, _CMP_NEQ_UQ);
+    if (_mm512_mask_cmp_ps_mask(nonzero, x, one, _CMP_NEQ_UQ)) {
+      return true;
+    }
+  }
+
+  return any_nonbinary_single_scalar_i(a + i, len - i);
+}
+
+#endif
+
+/* Pick the kernels for the running CPU the first time they are needed.
+
+   Only called from the MATLAB thread. */
+static dense_kernels_t const* dense_kernels_i(void)
+{
+  static dense_kernels_t kernels = {
+    .equal_double = equal_double_scalar_i,
+    .any_nonzero_double = any_nonzero_double_scalar_i,
+    .any_nonbinary_double = any_nonbinary_double_scalar_i,
+    .equal_single = equal_single_scalar_i,
+    .any_nonzero_single = any_nonzero_single_scalar_i,
+    .any_nonbinary_single = any_nonbinary_single_scalar_i,
+    .equal_bytes = equal_bytes_scalar_i,
+    .any_nonzero_bytes = any_nonzero_bytes_scalar_i,
+  };
+  static igraph_bool_t initialized = false;
+
+  if (initialized) {
+    return &kernels;
+  }
+
+#if MXIGRAPH_X86_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    kernels.equal_double = equal_double_avx2_i;
+    kernels.any_nonzero_double = any_nonzero_double_avx2_i;
+    kernels.any_nonbinary_double = any_nonbinary_double_avx2_i;
+    kernels.equal_single = equal_single_avx2_i;
+    kernels.any_nonzero_single = any_nonzero_single_avx2_i;
+    kernels.any_nonbinary_single = any_nonbinary_single_avx2_i;
+    kernels.equal_bytes = equal_bytes_avx2_i;
+    kernels.any_nonzero_bytes = any_nonzero_bytes_avx2_i;
+  }
+
+  if (__builtin_cpu_supports("avx512f")) {
+    kernels.equal_double = equal_double_avx512_i;
+    kernels.any_nonzero_double = any_nonzero_double_avx512_i;
+    kernels.any_nonbinary_double = any_nonbinary_double_avx512_i;
+    kernels.equal_single = equal_single_avx512_i;
+    kernels.any_nonzero_single = any_nonzero_single_avx512_i;
+    kernels.any_nonbinary_single = any_nonbinary_single_avx512_i;
+  }
+#endif
+
+  initialized = true;
+  return &kernels;
+}
+
+/* Kernel selection by element type, integers and logicals compare their
+   bytes. */
+#define EQUAL_DOUBLE(kernels, a, b, len) (kernels)->equal_double(a, b, len)
+#define EQUAL_SINGLE(kernels, a, b, len) (kernels)->equal_single(a, b, len)
+#define EQUAL_BYTES(kernels, a, b, len)                                       \
+  (kernels)->equal_bytes(                                                     \
+    (uint8_t const*)(a), (uint8_t const*)(b), (len) * sizeof(*(a)))
+
+static mwSize min_i(mwSize const a, mwSize const b) { return a < b ? a : b; }
+
+/* Compare the matrix against its transpose one pair of tiles at a time.
+
+   For the tile covering rows ib.. and columns jb.. (ib >= jb), the mirror
+   tile covering rows jb.. and columns ib.. is copied into a buffer
+   transposed. The copy reads short contiguous runs of columns and the
+   comparison is between contiguous columns of the tile and the buffer. Both
+   tiles stay in cache for the duration so each element of the matrix is
+   read from memory once. Tiles on the diagonal are compared against
+   themselves which does some redundant work but keeps the loop simple. */
+#define IS_SYMMETRIC_FUNC(name, type, equal)                                  \
+  static igraph_bool_t name(                                                  \
+    type const* adj, mwSize const n, dense_kernels_t const* kernels)          \
+  {                                                                           \
+    type buffer[MXIGRAPH_DENSE_TILE * MXIGRAPH_DENSE_TILE];                   \
+                                                                              \
+    for (mwIndex jb = 0; jb < n; jb += MXIGRAPH_DENSE_TILE) {                 \
+      mwSize const jn = min_i(MXIGRAPH_DENSE_TILE, n - jb);                   \
+      for (mwIndex ib = jb; ib < n; ib += MXIGRAPH_DENSE_TILE) {              \
+        mwSize const in = min_i(MXIGRAPH_DENSE_TILE, n - ib);                 \
+                                                                              \
+        for (mwIndex i = 0; i < in; i++) {                                    \
+          type const* mirror = adj + jb + ((ib + i) * n);                     \
+          for (mwIndex j = 0; j < jn; j++) {                                  \
+            buffer[i + (j * MXIGRAPH_DENSE_TILE)] = mirror[j];                \
+          }                                                                   \
+        }                                                                     \
+                                                                              \
+        for (mwIndex j = 0; j < jn; j++) {                                    \
+          if (!equal(kernels, adj + ib + ((jb + j) * n),                      \
+                buffer + (j * MXIGRAPH_DENSE_TILE), in)) {                    \
+            return false;                                                     \
+          }                                                                   \
+        }                                                                     \
+      }                                                                       \
+    }                                                                         \
+                                                                              \
+    return true;                                                              \
+  }
+
+IS_SYMMETRIC_FUNC(is_symmetric_double_i, mxDouble, EQUAL_DOUBLE)
+IS_SYMMETRIC_FUNC(is_symmetric_single_i, mxSingle, EQUAL_SINGLE)
+IS_SYMMETRIC_FUNC(is_symmetric_8_i, uint8_t, EQUAL_BYTES)
+IS_SYMMETRIC_FUNC(is_symmetric_16_i, uint16_t, EQUAL_BYTES)
+IS_SYMMETRIC_FUNC(is_symmetric_32_i, uint32_t, EQUAL_BYTES)
+IS_SYMMETRIC_FUNC(is_symmetric_64_i, uint64_t, EQUAL_BYTES)
+
+#undef IS_SYMMETRIC_FUNC
+#undef EQUAL_DOUBLE
+#undef EQUAL_SINGLE
+#undef EQUAL_BYTES
+
+/* Test if a full square matrix equals its transpose. */
+igraph_bool_t mxIgraph_dense_is_symmetric(mxArray const* p)
+{
+  dense_kernels_t const* kernels = dense_kernels_i();
+  mwSize const n = mxGetM(p);
+  void const* adj = mxGetData(p);
+
+  if (mxIsDouble(p)) {
+    return is_symmetric_double_i(adj, n, kernels);
+  }
+
+  if (mxIsSingle(p)) {
+    return is_symmetric_single_i(adj, n, kernels);
+  }
+
+  switch (mxGetElementSize(p)) {
+    case 1:
+      return is_symmetric_8_i(adj, n, kernels);
+    case 2:
+      return is_symmetric_16_i(adj, n, kernels);
+    case 4:
+      return is_symmetric_32_i(adj, n, kernels);
+    default:
+      return is_symmetric_64_i(adj, n, kernels);
+  }
+}
+
+/* Test if any of the len elements of p starting at offset are nonzero. */
+static igraph_bool_t any_nonzero_i(mxArray const* p, mwIndex const offset,
+  mwSize const len, dense_kernels_t const* kernels)
+{
+  if (mxIsDouble(p)) {
+    return kernels->any_nonzero_double(mxGetDoubles(p) + offset, len);
+  }
+
+  if (mxIsSingle(p)) {
+    return kernels->any_nonzero_single(mxGetSingles(p) + offset, len);
+  }
+
+  size_t const width = mxGetElementSize(p);
+  return kernels->any_nonzero_bytes(
+    (uint8_t const*)mxGetData(p) + (offset * width), len * width);
+}
+
+/* Test if the part of each column above (upper = true) or below the
+   diagonal is all zeros. Both parts are contiguous in column major order. */
+static igraph_bool_t is_zero_triangle_i(
+  mxArray const* p, igraph_bool_t const upper)
+{
+  dense_kernels_t const* kernels = dense_kernels_i();
+  mwSize const m = mxGetM(p);
+  mwSize const n = mxGetN(p);
+
+  for (mwIndex j = 0; j < n; j++) {
+    mwIndex const start = upper ? 0 : min_i(j + 1, m);
+    mwIndex const stop = upper ? min_i(j, m) : m;
+
+    if (any_nonzero_i(p, start + (j * m), stop - start, kernels)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* Upper triangular, everything below the diagonal is zero. */
+igraph_bool_t mxIgraph_dense_is_triu(mxArray const* p)
+{
+  return is_zero_triangle_i(p, false);
+}
+
+/* Lower triangular, everything above the diagonal is zero. */
+igraph_bool_t mxIgraph_dense_is_tril(mxArray const* p)
+{
+  return is_zero_triangle_i(p, true);
+}
+
+/* Integer matrices get a scalar loop for each width instead of kernels, the
+   test needs the element values so can not be done on the bytes. */
+#define ANY_NONBINARY_CASE(class_id, type, getter)                            \
+  case class_id: {                                                            \
+    type const* adj = getter(p);                                              \
+    for (size_t i = 0; i < len; i++) {                                        \
+      if ((adj[i] != 0) && (adj[i] != 1)) {                                   \
+        return true;                                                          \
+      }                                                                       \
+    }                                                                         \
+    return false;                                                             \
+  }
+
+/* Test if a full matrix has values other than 0 or 1. */
+igraph_bool_t mxIgraph_dense_is_weighted(mxArray const* p)
+{
+  dense_kernels_t const* kernels = dense_kernels_i();
+  size_t const len = mxGetNumberOfElements(p);
+
+  switch (mxGetClassID(p)) {
+    case mxDOUBLE_CLASS:
+      return kernels->any_nonbinary_double(mxGetDoubles(p), len);
+    case mxSINGLE_CLASS:
+      return kernels->any_nonbinary_single(mxGetSingles(p), len);
+    MXIGRAPH_INTEGER_CLASSES(ANY_NONBINARY_CASE)
+    default:
+      return false;
+  }
+}
+
+#undef ANY_NONBINARY_CASE
@@ -0,0 +1,36 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Kernels for scanning full (dense) adjacency matrices.
+
+   Matrices are column major so anything that walks a column is contiguous
+   while comparing against the transpose is strided. These kernels keep the
+   inner loops contiguous, tiling the transpose through a small buffer where
+   needed, and use vector instructions when the CPU supports them. */
+
+#ifndef MXDENSE_H
+#define MXDENSE_H
+
+#include <mxIgraph.h>
+
+igraph_bool_t mxIgraph_dense_is_symmetric(mxArray const* p);
+igraph_bool_t mxIgraph_dense_is_triu(mxArray const* p);
+igraph_bool_t mxIgraph_dense_is_tril(mxArray const* p);
+igraph_bool_t mxIgraph_dense_is_weighted(mxArray const* p);
+
+#endif
@@ -17,9 +17,14 @@
  */
 
 #include "mxIterators.h"
+#include "mxNumeric.h"
 
 #include <mxIgraph.h>
 
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
 /* Return the number of nodes in the adjacency matrix pointed to by p. */
 igraph_integer_t mxIgraphVCount(mxArray const* p)
 {
@@ -33,165 +38,422 @@ igraph_integer_t mxIgraphVCount(mxArray const* p)
 igraph_integer_t mxIgraphECount(
   mxArray const* p, igraph_bool_t const is_directed)
 {
-  mxIgraph_eit eit;
-  mxIgraph_eit_create(p, &eit, is_directed);
-
-  igraph_integer_t n_edges = 0;
-  while (!MXIGRAPH_EIT_END(eit)) {
-    n_edges++;
-    MXIGRAPH_EIT_NEXT(eit);
-  }
+  mxIgraphProfile_t profile;
+  mxIgraphProfile(p, &profile);
 
-  return n_edges;
-}
-
-/* Convert a mxArray containing a (di)graph class to a structure.
-   and use structures to create MATLAB graph types.
-
- MATLAB's support for modifying classes created with MATLAB's classdef is
- limited and makes copies of everything. Properties that are available in
- MATLAB are not always available to mex, specifically tables (which the graph
- type uses) seem to have pretend properties that appear to be properties in
- MATLAB but don't actually exist when requesting properties in mex. As such
- it's easy and more performant (less coping data) to convert to an easy to work
- with structure based type.
-
- This also makes it much easier to create a MATLAB graph type. */
-static inline mxArray const* mxGraph2struct_i(mxArray const* p)
-{
-  mxArray *ret, *in;
-  in = (mxArray*)p;
-
-  mexCallMATLAB(1, &ret, 1, &in, "igutils.graph2struct");
-
-  return ret;
+  return mxIgraphProfileECount(&profile, is_directed);
 }
 
+/* Only the end nodes and the weight variable are requested from MATLAB so
+ the graph's tables, and any other variables in them, are never copied. */
 static igraph_error_t get_graph_i(mxArray const* p, igraph_t* graph,
   igraph_vector_t* weights, igraph_bool_t const is_weighted,
   igraph_bool_t const is_directed, char const* weight_att)
 {
-  mxArray const* mxGraph = mxGraph2struct_i(p);
+  mxArray* in[2] = { (mxArray*)p, NULL };
+  mxArray* out[4] = { NULL };
+  int const n_in = is_weighted ? 2 : 1;
+  int const n_out = is_weighted ? 4 : 3;
 
-  mxArray const* nodeTable = mxGetField(mxGraph, 0, "Nodes");
-  mxArray const* edgeTable = mxGetField(mxGraph, 0, "Edges");
-  igraph_integer_t const n_nodes = mxIgraphIntegerFromOptions(nodeTable, "n");
-  igraph_integer_t const n_edges = mxIgraphIntegerFromOptions(edgeTable, "n");
-  MXIGRAPH_CHECK_STATUS();
+  if (is_weighted) {
+    in[1] = mxCreateString(weight_att);
+  }
+  mexCallMATLAB(n_out, out, n_in, in, "igutils.graph2edges");
+  if (is_weighted) {
+    mxDestroyArray(in[1]);
+  }
 
-  double* mxEdges = mxGetDoubles(mxGetField(edgeTable, 0, "EndNodes"));
-  double* mxWeights;
+  igraph_integer_t const n_edges = mxGetNumberOfElements(out[0]);
+  igraph_integer_t const n_nodes = mxGetScalar(out[2]);
+  double const* sources = mxGetDoubles(out[0]);
+  double const* targets = mxGetDoubles(out[1]);
+  double const* mxWeights = is_weighted ? mxGetDoubles(out[3]) : NULL;
   igraph_vector_int_t edges;
 
-  IGRAPH_CHECK(igraph_empty(graph, n_nodes, is_directed));
-  IGRAPH_FINALLY(igraph_destroy, graph);
   IGRAPH_CHECK(igraph_vector_int_init(&edges, 2 * n_edges));
   IGRAPH_FINALLY(igraph_vector_int_destroy, &edges);
 
   if (is_weighted) {
     IGRAPH_CHECK(igraph_vector_init(weights, n_edges));
-    mxWeights = mxGetDoubles(mxGetField(edgeTable, 0, weight_att));
   } else if (weights) {
     IGRAPH_CHECK(igraph_vector_init(weights, 0));
   }
   IGRAPH_FINALLY(igraph_vector_destroy, weights);
 
   for (igraph_integer_t i = 0; i < n_edges; i++) {
-    VECTOR(edges)[2 * i] = mxEdges[i] - 1;
-    VECTOR(edges)[(2 * i) + 1] = mxEdges[i + n_edges] - 1;
+    VECTOR(edges)[2 * i] = sources[i] - 1;
+    VECTOR(edges)[(2 * i) + 1] = targets[i] - 1;
     if (is_weighted) {
       VECTOR(*weights)[i] = mxWeights[i];
     }
   }
 
-  IGRAPH_CHECK(igraph_add_edges(graph, &edges, NULL));
+  for (int i = 0; i < n_out; i++) {
+    mxDestroyArray(out[i]);
+  }
+
+  IGRAPH_CHECK(igraph_create(graph, &edges, n_nodes, is_directed));
   igraph_vector_int_destroy(&edges);
-  IGRAPH_FINALLY_CLEAN(3);
+  IGRAPH_FINALLY_CLEAN(2);
 
   return IGRAPH_SUCCESS;
 }
 
+/* Build the graph from an adjacency matrix in a single pass.
+
+ The profile gives the number of edges so the vectors can be sized up front.
+ The edge collector needs room for one spare edge, the vectors are shrunk
+ back to the number of edges afterwards without reallocating.
+
+ Inferred flags are resolved from the same profile, so the matrix is only
+ scanned once whether or not the caller set them. Inferred weights are
+ dropped if the caller did not ask for a weight vector. */
 static igraph_error_t get_adj_i(mxArray const* p, igraph_t* graph,
-  igraph_vector_t* weights, igraph_bool_t const is_weighted,
-  igraph_bool_t const is_directed)
+  igraph_vector_t* weights, mxIgraphFlag_t const weighted_flag,
+  mxIgraphFlag_t const directed_flag)
 {
-  if (!mxIgraphIsSquare(p)) {
+  mxIgraphProfile_t profile;
+  mxIgraphProfile(p, &profile);
+
+  if (!profile.is_square) {
     return IGRAPH_NONSQUARE;
   }
 
-  igraph_integer_t n_nodes = mxIgraphVCount(p);
-  igraph_integer_t n_edges = mxIgraphECount(p, is_directed);
+  igraph_bool_t const is_directed = directed_flag == MXIGRAPH_FLAG_INFER
+                                      ? mxIgraphProfileIsDirected(&profile)
+                                      : directed_flag;
+  igraph_bool_t const is_weighted = weighted_flag == MXIGRAPH_FLAG_INFER
+                                      ? profile.is_weighted && weights
+                                      : weighted_flag;
+  igraph_integer_t const n_nodes = mxIgraphVCount(p);
+  igraph_integer_t const n_edges =
+    mxIgraphProfileECount(&profile, is_directed);
   igraph_vector_int_t edges;
-  mxIgraph_eit eit;
 
-  mxIgraph_eit_create(p, &eit, is_directed);
-  IGRAPH_CHECK(igraph_empty(graph, n_nodes, is_directed));
-  IGRAPH_FINALLY(igraph_destroy, graph);
-  IGRAPH_CHECK(igraph_vector_int_init(&edges, 2 * n_edges));
+  IGRAPH_CHECK(igraph_vector_int_init(&edges, 2 * (n_edges + 1)));
   IGRAPH_FINALLY(igraph_vector_int_destroy, &edges);
 
   if (is_weighted) {
-    IGRAPH_CHECK(igraph_vector_init(weights, n_edges));
+    IGRAPH_CHECK(igraph_vector_init(weights, n_edges + 1));
   } else if (weights) {
     IGRAPH_CHECK(igraph_vector_init(weights, 0));
   }
   IGRAPH_FINALLY(igraph_vector_destroy, weights);
 
-  igraph_integer_t edge_idx = 0;
-  while (!MXIGRAPH_EIT_END(eit)) {
-    VECTOR(edges)[edge_idx] = MXIGRAPH_EIT_GET_ROW(eit);
-    VECTOR(edges)[edge_idx + 1] = MXIGRAPH_EIT_GET_COL(eit);
-    if (is_weighted) {
-      VECTOR(*weights)
-      [edge_idx / 2] = (igraph_real_t)(MXIGRAPH_EIT_GET_WEIGHT(eit));
+  mxIgraph_collect_edges(p, &profile, is_directed, VECTOR(edges),
+    is_weighted ? VECTOR(*weights) : NULL);
+
+  IGRAPH_CHECK(igraph_vector_int_resize(&edges, 2 * n_edges));
+  if (is_weighted) {
+    IGRAPH_CHECK(igraph_vector_resize(weights, n_edges));
+  }
+
+  IGRAPH_CHECK(igraph_create(graph, &edges, n_nodes, is_directed));
+  igraph_vector_int_destroy(&edges);
+  IGRAPH_FINALLY_CLEAN(2);
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Copy a column-major m x 2 end node array of the given class into igraph's
+ interleaved edge vector, converting from MATLAB's 1-based node IDs.
+
+ The end nodes are validated in a first pass before any are converted. Both
+ loops are branch free, invalid values (non-integers, NaNs, anything less
+ than 1) are collected into a single flag and the largest node ID is kept
+ with a running max, so the compiler is free to vectorize them. Returns
+ false if any end node was invalid. */
+#define EDGELIST_COPY_FUNC(class_id, type, getter)                            \
+  static igraph_bool_t edgelist_copy_##type##_i(void const* data,             \
+    igraph_integer_t const n_edges, igraph_integer_t* edges,                  \
+    igraph_integer_t* max_node)                                               \
+  {                                                                           \
+    type const* src = data;                                                   \
+    double const limit = (double)IGRAPH_INTEGER_MAX;                          \
+    igraph_bool_t invalid = false;                                            \
+    double hi = 0;                                                            \
+                                                                              \
+    for (igraph_integer_t i = 0; i < 2 * n_edges; i++) {                      \
+      double const x = (double)src[i];                                        \
+      invalid |= !(x >= 1) | !(x < limit) | (x != trunc(x));                  \
+      hi = x > hi ? x : hi;                                                   \
+    }                                                                         \
+                                                                              \
+    if (invalid) {                                                            \
+      return false;                                                           \
+    }                                                                         \
+                                                                              \
+    for (igraph_integer_t i = 0; i < n_edges; i++) {                          \
+      edges[2 * i] = (igraph_integer_t)src[i] - 1;                            \
+      edges[(2 * i) + 1] = (igraph_integer_t)src[i + n_edges] - 1;            \
+    }                                                                         \
+                                                                              \
+    *max_node = (igraph_integer_t)hi;                                         \
+    return true;                                                              \
+  }
+
+MXIGRAPH_NUMERIC_CLASSES(EDGELIST_COPY_FUNC)
+
+#undef EDGELIST_COPY_FUNC
+
+/* Copy a weight vector of any numeric class to igraph's real vector. */
+static void edgelist_copy_weights_i(
+  mxArray const* p, igraph_integer_t const n_edges, igraph_real_t* weights)
+{
+#define COPY_WEIGHTS_CASE(class_id, type, getter)                             \
+  case class_id: {                                                            \
+    type const* src = getter(p);                                              \
+    for (igraph_integer_t i = 0; i < n_edges; i++) {                          \
+      weights[i] = src[i];                                                    \
+    }                                                                         \
+    break;                                                                    \
+  }
+
+  switch (mxGetClassID(p)) {
+    MXIGRAPH_NUMERIC_CLASSES(COPY_WEIGHTS_CASE)
+    default:
+      IGRAPH_FATAL("Received unexpected data type.");
+  }
+
+#undef COPY_WEIGHTS_CASE
+}
+
+/* Edge lists keep their structure in these fields, so they can not also be
+ used to name the weight field. */
+static igraph_bool_t is_edgelist_field_i(char const* name)
+{
+  return (strcmp(name, "EndNodes") == 0) || (strcmp(name, "NumNodes") == 0);
+}
+
+/* Resolve an inferred weight flag for a graph object or edge list the way
+ igraph.isweighted does: they are weighted if they have any edge attribute,
+ or edge list field other than the end nodes and node count. The named
+ attribute is used if there is one, otherwise "Weight" if present and then
+ the first attribute, as in igutils.setGraphInProps. weight_att is emptied
+ if there are no attributes. */
+static igraph_error_t infer_weight_att_i(
+  mxArray const* p, char* weight_att, size_t const size)
+{
+  mxArray* in[1] = { (mxArray*)p };
+  mxArray* attrs = NULL;
+  char name[MXIGRAPH_NAME_MAX];
+  char first[MXIGRAPH_NAME_MAX] = "";
+  igraph_bool_t found = false;
+  igraph_bool_t has_default = false;
+  igraph_integer_t n_attrs;
+
+  if (mxIgraphIsGraph(p)) {
+    mexCallMATLAB(1, &attrs, 1, in, "igutils.listEdgeAttrs");
+    n_attrs = mxGetNumberOfElements(attrs);
+  } else {
+    n_attrs = mxGetNumberOfFields(p);
+  }
+
+  for (igraph_integer_t i = 0; i < n_attrs; i++) {
+    if (attrs) {
+      mxGetString(mxGetCell(attrs, i), name, sizeof(name));
+    } else {
+      snprintf(name, sizeof(name), "%s", mxGetFieldNameByNumber(p, i));
+      if (is_edgelist_field_i(name)) {
+        continue;
+      }
+    }
+
+    if (first[0] == '\0') {
+      memcpy(first, name, sizeof(first));
+    }
+    found |= strcmp(name, weight_att) == 0;
+    has_default |= strcmp(name, "Weight") == 0;
+  }
+
+  if (attrs) {
+    mxDestroyArray(attrs);
+  }
+
+  if (first[0] == '\0') {
+    weight_att[0] = '\0';
+    return IGRAPH_SUCCESS;
+  }
+
+  if (weight_att[0] != '\0') {
+    if (!found) {
+      IGRAPH_ERRORF("Graph has no edge attribute \"%s\" to use as weights.",
+        IGRAPH_EINVAL, weight_att);
+    }
+    return IGRAPH_SUCCESS;
+  }
+
+  snprintf(weight_att, size, "%s", has_default ? "Weight" : first);
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Build the graph from an edge list structure.
+
+ The end nodes are copied straight into the edge vector and the weight
+ column straight into the weight vector, no adjacency matrix is formed. If
+ the structure has no "NumNodes" field, the largest end node is used as the
+ number of nodes. */
+static igraph_error_t get_edgelist_i(mxArray const* p, igraph_t* graph,
+  igraph_vector_t* weights, igraph_bool_t const is_weighted,
+  igraph_bool_t const is_directed, char const* weight_att)
+{
+  mxArray const* end_nodes = mxGetField(p, 0, "EndNodes");
+  mxArray const* mx_n_nodes = mxGetField(p, 0, "NumNodes");
+  mxArray const* mx_weights =
+    is_weighted ? mxGetField(p, 0, weight_att) : NULL;
+  igraph_bool_t (*copy)(void const*, igraph_integer_t const,
+    igraph_integer_t*, igraph_integer_t*);
+
+  if (mxIsComplex(end_nodes) || (mxGetNumberOfDimensions(end_nodes) != 2) ||
+      (mxGetN(end_nodes) != 2)) {
+    IGRAPH_ERROR("Edge list end nodes must be a real m x 2 array.",
+      IGRAPH_EINVAL);
+  }
+
+#define SELECT_COPY_CASE(class_id, type, getter)                              \
+  case class_id:                                                              \
+    copy = edgelist_copy_##type##_i;                                          \
+    break;
+
+  switch (mxGetClassID(end_nodes)) {
+    MXIGRAPH_NUMERIC_CLASSES(SELECT_COPY_CASE)
+    default:
+      IGRAPH_ERROR("Edge list end nodes must be numeric.", IGRAPH_EINVAL);
+  }
+
+#undef SELECT_COPY_CASE
+
+  igraph_integer_t const n_edges = mxGetM(end_nodes);
+  igraph_integer_t n_nodes;
+  igraph_integer_t max_node;
+  igraph_vector_int_t edges;
+
+  if (is_weighted && is_edgelist_field_i(weight_att)) {
+    IGRAPH_ERRORF("Edge list weight field can not be named \"%s\".",
+      IGRAPH_EINVAL, weight_att);
+  }
+
+  if (mx_n_nodes) {
+    double const x = (mxIsNumeric(mx_n_nodes) && !mxIsComplex(mx_n_nodes) &&
+                       (mxGetNumberOfElements(mx_n_nodes) == 1))
+                       ? mxGetScalar(mx_n_nodes)
+                       : NAN;
+    if (!(x >= 0) || !(x < (double)IGRAPH_INTEGER_MAX) || (x != trunc(x))) {
+      IGRAPH_ERROR("Edge list NumNodes must be a non-negative integer.",
+        IGRAPH_EINVAL);
     }
-    edge_idx += 2;
-    MXIGRAPH_EIT_NEXT(eit);
   }
 
-  IGRAPH_CHECK(igraph_add_edges(graph, &edges, NULL));
+  if (is_weighted &&
+      (!mx_weights || !mxIsNumeric(mx_weights) || mxIsComplex(mx_weights) ||
+       mxIsSparse(mx_weights) ||
+       ((igraph_integer_t)mxGetNumberOfElements(mx_weights) != n_edges))) {
+    IGRAPH_ERRORF("Edge list weight field \"%s\" must be a real numeric "
+                  "vector with one element per edge.",
+      IGRAPH_EINVAL, weight_att);
+  }
+
+  IGRAPH_CHECK(igraph_vector_int_init(&edges, 2 * n_edges));
+  IGRAPH_FINALLY(igraph_vector_int_destroy, &edges);
+
+  if (!copy(mxGetData(end_nodes), n_edges, VECTOR(edges), &max_node)) {
+    IGRAPH_ERROR("Edge list end nodes must be positive integers.",
+      IGRAPH_EINVVID);
+  }
+
+  n_nodes = mx_n_nodes ? (igraph_integer_t)mxGetScalar(mx_n_nodes) : max_node;
+  if (max_node > n_nodes) {
+    IGRAPH_ERRORF("Edge list refers to node %" IGRAPH_PRId
+                  " but only has %" IGRAPH_PRId " nodes.",
+      IGRAPH_EINVVID, max_node, n_nodes);
+  }
+
+  if (is_weighted) {
+    IGRAPH_CHECK(igraph_vector_init(weights, n_edges));
+    edgelist_copy_weights_i(mx_weights, n_edges, VECTOR(*weights));
+  } else if (weights) {
+    IGRAPH_CHECK(igraph_vector_init(weights, 0));
+  }
+  IGRAPH_FINALLY(igraph_vector_destroy, weights);
+
+  IGRAPH_CHECK(igraph_create(graph, &edges, n_nodes, is_directed));
   igraph_vector_int_destroy(&edges);
-  IGRAPH_FINALLY_CLEAN(3);
+  IGRAPH_FINALLY_CLEAN(2);
 
   return IGRAPH_SUCCESS;
 }
 
-/* Copy a MATLAB adjacency matrix (sparse or full) to an igraph graph type.
+/* Copy a MATLAB graph (graph object, edge list, sparse or full adjacency
+   matrix) to an igraph graph type.
 
    Creates a graph and it's weights. For unweighted graphs, a weight of 1 is
    given to each edge unless the caller passes NULL to the weight argument.
 
    Both the graph and weight vector should be uninitialized but it's the
-   callers responsibility to destroy them when done. */
+   callers responsibility to destroy them when done.
+
+   Either "isdirected" or "isweighted" may be "infer", in which case the
+   "weight" option is optional. Graph objects are directed if they are
+   digraphs, edge lists are always directed. Both are weighted when they have
+   an edge attribute, matching igraph.isweighted. Adjacency matrices are
+   worked out while their edges are collected. Inferred weights are dropped
+   if the caller did not ask for a weight vector. The resolved flags can be
+   recovered from the graph and the weight vector's length. */
 igraph_error_t mxIgraphFromArray(mxArray const* p, igraph_t* graph,
   igraph_vector_t* weights, mxArray const* graph_options)
 {
-  igraph_bool_t const is_directed =
-    mxIgraphBoolFromOptions(graph_options, "isdirected");
+  mxIgraphFlag_t is_directed =
+    mxIgraphFlagFromOptions(graph_options, "isdirected");
   MXIGRAPH_CHECK_STATUS();
 
-  igraph_bool_t is_weighted;
-  char* weight_att;
+  mxIgraphFlag_t is_weighted;
+  char weight_att[MXIGRAPH_NAME_MAX] = "";
 
   if (mxGetField(graph_options, 0, "isweighted")) {
-    is_weighted = mxIgraphBoolFromOptions(graph_options, "isweighted");
-    weight_att =
-      is_weighted ? mxIgraphStringFromOptions(graph_options, "weight") : "";
+    is_weighted = mxIgraphFlagFromOptions(graph_options, "isweighted");
+    if ((is_weighted == MXIGRAPH_FLAG_TRUE) ||
+        ((is_weighted == MXIGRAPH_FLAG_INFER) &&
+          mxGetField(graph_options, 0, "weight"))) {
+      mxIgraphStringFromOptions(
+        graph_options, "weight", weight_att, sizeof(weight_att));
+    }
     MXIGRAPH_CHECK_STATUS();
   } else {
     /* Add defaults so we can get away with not setting weight related fields
     for methods where weights are never used. */
-    is_weighted = false;
-    weight_att = "";
+    is_weighted = MXIGRAPH_FLAG_FALSE;
   }
 
-  if (is_weighted && !weights) {
+  if ((is_weighted == MXIGRAPH_FLAG_TRUE) && !weights) {
     IGRAPH_FATAL("Weighted graph passed NULL for weight vector.");
   }
 
+  /* Nothing to infer weights for. */
+  if ((is_weighted == MXIGRAPH_FLAG_INFER) && !weights) {
+    is_weighted = MXIGRAPH_FLAG_FALSE;
+  }
+
   if (mxIgraphIsGraph(p)) {
+    if (is_directed == MXIGRAPH_FLAG_INFER) {
+      is_directed = mxIsClass(p, "digraph");
+    }
+    if (is_weighted == MXIGRAPH_FLAG_INFER) {
+      IGRAPH_CHECK(infer_weight_att_i(p, weight_att, sizeof(weight_att)));
+      is_weighted = weight_att[0] != '\0';
+    }
     IGRAPH_CHECK(
       get_graph_i(p, graph, weights, is_weighted, is_directed, weight_att));
+  } else if (mxIgraphIsEdgeList(p)) {
+    if (is_directed == MXIGRAPH_FLAG_INFER) {
+      is_directed = true;
+    }
+    if (is_weighted == MXIGRAPH_FLAG_INFER) {
+      IGRAPH_CHECK(infer_weight_att_i(p, weight_att, sizeof(weight_att)));
+      is_weighted = weight_att[0] != '\0';
+    }
+    IGRAPH_CHECK(get_edgelist_i(
+      p, graph, weights, is_weighted, is_directed, weight_att));
   } else {
     IGRAPH_CHECK(get_adj_i(p, graph, weights, is_weighted, is_directed));
   }
@@ -199,216 +461,475 @@ igraph_error_t mxIgraphFromArray(mxArray const* p, igraph_t* graph,
   return IGRAPH_SUCCESS;
 }
 
-static mxArray* create_adj_full_double_i(
-  igraph_t const* graph, igraph_vector_t const* weights)
+/* The MATLAB class used to return graphs of the given numeric data type. */
+static mxClassID dtype_class_i(mxIgraphDType_t const dtype)
 {
-  mwSize n_nodes = igraph_vcount(graph);
-  mxArray* p = mxCreateDoubleMatrix(n_nodes, n_nodes, mxREAL);
-  double* adj = mxGetDoubles(p);
-  igraph_eit_t eit;
-  igraph_integer_t eid;
-  mwIndex idx;
-  igraph_error_t rs;
+  mxClassID const classes[MXIGRAPH_DTYPE_N] = {
+    [MXIGRAPH_DTYPE_LOGICAL] = mxLOGICAL_CLASS,
+    [MXIGRAPH_DTYPE_DOUBLE] = mxDOUBLE_CLASS,
+    [MXIGRAPH_DTYPE_SINGLE] = mxSINGLE_CLASS,
+    [MXIGRAPH_DTYPE_INT8] = mxINT8_CLASS,
+    [MXIGRAPH_DTYPE_INT16] = mxINT16_CLASS,
+    [MXIGRAPH_DTYPE_INT32] = mxINT32_CLASS,
+    [MXIGRAPH_DTYPE_INT64] = mxINT64_CLASS,
+    [MXIGRAPH_DTYPE_UINT8] = mxUINT8_CLASS,
+    [MXIGRAPH_DTYPE_UINT16] = mxUINT16_CLASS,
+    [MXIGRAPH_DTYPE_UINT32] = mxUINT32_CLASS,
+    [MXIGRAPH_DTYPE_UINT64] = mxUINT64_CLASS,
+  };
+
+  return classes[dtype];
+}
 
-  rs = igraph_eit_create(graph, igraph_ess_all(IGRAPH_EDGEORDER_ID), &eit);
-  if (rs != IGRAPH_SUCCESS) {
-    mxIgraphSetError(rs);
-    mxIgraphSetErrorMsg("Failed to create edge iterator.");
-    return p;
-  }
+/* Write each edge's weight into a full matrix of the given numeric class,
+ summing parallel edges. If symmetric, edges of undirected graphs are written
+ to both triangles otherwise only to (from, to).
 
-  while (!IGRAPH_EIT_END(eit)) {
-    eid = IGRAPH_EIT_GET(eit);
-    idx = IGRAPH_FROM(graph, eid) + (n_nodes * IGRAPH_TO(graph, eid));
-    adj[idx] = weights ? VECTOR(*weights)[eid] : 1;
+ Sums are taken in double and converted back to the matrix's class after
+ each edge, so integer matrices round and saturate the way MATLAB's
+ arithmetic on them does. */
+static mxArray* create_adj_full_i(igraph_t const* graph,
+  igraph_vector_t const* weights, igraph_bool_t const symmetric,
+  mxClassID const class_id)
+{
+  mwSize const n_nodes = igraph_vcount(graph);
+  igraph_integer_t const n_edges = igraph_ecount(graph);
+  mxArray* p = mxCreateNumericMatrix(n_nodes, n_nodes, class_id, mxREAL);
+
+#define FILL_FULL_CASE(class_id, type, getter)                                \
+  case class_id: {                                                            \
+    type* adj = getter(p);                                                    \
+    for (igraph_integer_t eid = 0; eid < n_edges; eid++) {                    \
+      mwIndex const from = IGRAPH_FROM(graph, eid);                           \
+      mwIndex const to = IGRAPH_TO(graph, eid);                               \
+      double const w = weights ? VECTOR(*weights)[eid] : 1;                   \
+      mwIndex const idx = from + (n_nodes * to);                              \
+                                                                              \
+      adj[idx] = MXIGRAPH_CAST(type, adj[idx] + w);                           \
+      if (symmetric && (from != to)) {                                        \
+        mwIndex const mirror = to + (n_nodes * from);                         \
+        adj[mirror] = MXIGRAPH_CAST(type, adj[mirror] + w);                   \
+      }                                                                       \
+    }                                                                         \
+    break;                                                                    \
+  }
 
-    IGRAPH_EIT_NEXT(eit);
+  switch (class_id) {
+    MXIGRAPH_NUMERIC_CLASSES(FILL_FULL_CASE)
+    default:
+      IGRAPH_FATAL("Received unexpected data type.");
   }
-  igraph_eit_destroy(&eit);
+
+#undef FILL_FULL_CASE
 
   return p;
 }
 
-static mxArray* create_adj_full_logical_i(igraph_t const* graph)
+static mxArray* create_adj_full_logical_i(
+  igraph_t const* graph, igraph_bool_t const symmetric)
 {
-  mwSize n_nodes = igraph_vcount(graph);
+  mwSize const n_nodes = igraph_vcount(graph);
+  igraph_integer_t const n_edges = igraph_ecount(graph);
   mxArray* p = mxCreateLogicalMatrix(n_nodes, n_nodes);
   bool* adj = mxGetLogicals(p);
-  igraph_eit_t eit;
-  igraph_integer_t eid;
-  mwIndex idx;
-  igraph_error_t rs;
 
-  rs = igraph_eit_create(graph, igraph_ess_all(IGRAPH_EDGEORDER_ID), &eit);
-  if (rs != IGRAPH_SUCCESS) {
-    mxIgraphSetError(rs);
-    mxIgraphSetErrorMsg("Failed to create edge iterator.");
-    return p;
+  for (igraph_integer_t eid = 0; eid < n_edges; eid++) {
+    mwIndex const from = IGRAPH_FROM(graph, eid);
+    mwIndex const to = IGRAPH_TO(graph, eid);
+
+    adj[from + (n_nodes * to)] = true;
+    if (symmetric) {
+      adj[to + (n_nodes * from)] = true;
+    }
   }
 
-  while (!IGRAPH_EIT_END(eit)) {
-    eid = IGRAPH_EIT_GET(eit);
-    idx = IGRAPH_FROM(graph, eid) + (n_nodes * IGRAPH_TO(graph, eid));
-    adj[idx] = true;
+  return p;
+}
 
-    IGRAPH_EIT_NEXT(eit);
+/* Graphs with at least this many matrix entries have their sparse matrices
+   filled in parallel. */
+#define MXIGRAPH_PARALLEL_CSC_ENTRIES 4194304
+
+typedef enum {
+  CSC_COUNT_ROWS = 0,
+  CSC_SCATTER_ROWS,
+  CSC_COUNT_COLS,
+  CSC_SCATTER_COLS
+} csc_phase_t;
+
+/* Entries 0..n_edges - 1 are the edges (from, to). If the matrix is
+   symmetric, entries n_edges..2 * n_edges - 1 are the mirrored (to, from)
+   edges, skipping self-loops so they are only counted once. */
+typedef struct {
+  igraph_t const* graph;
+  igraph_vector_t const* weights;
+  igraph_integer_t n_edges;
+  igraph_integer_t n_entries;
+  igraph_integer_t n_kept;
+  mwSize n_nodes;
+  igraph_integer_t n_chunks;
+  csc_phase_t phase;
+  igraph_integer_t* order;
+  mwIndex* offsets;
+  mwIndex* ir;
+  double* values;
+  bool* logicals;
+} csc_builder_t;
+
+static igraph_bool_t csc_entry_i(csc_builder_t const* builder,
+  igraph_integer_t const k, mwIndex* row, mwIndex* col)
+{
+  if (k < builder->n_edges) {
+    *row = IGRAPH_FROM(builder->graph, k);
+    *col = IGRAPH_TO(builder->graph, k);
+    return true;
   }
 
-  igraph_eit_destroy(&eit);
+  igraph_integer_t const eid = k - builder->n_edges;
+  *row = IGRAPH_TO(builder->graph, eid);
+  *col = IGRAPH_FROM(builder->graph, eid);
 
-  return p;
+  return *row != *col;
 }
 
-static mxArray* create_adj_sparse_double_i(
-  igraph_t const* graph, igraph_vector_t const* weights)
+/* One chunk of a counting sort phase. Each chunk has its own row of offsets
+   so chunks can run in parallel and, since the offsets are laid out chunk
+   after chunk within each key, the sort stays stable.
+
+   Runs on worker threads so must not use the MATLAB API. */
+static igraph_bool_t csc_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
 {
-  mwSize n_edges = igraph_ecount(graph);
-  mwSize n_nodes = igraph_vcount(graph);
-  mxArray* p = mxCreateSparse(n_nodes, n_nodes, n_edges, mxREAL);
-  double* adj = mxGetDoubles(p);
-  mwIndex* jc = mxGetJc(p);
-  mwIndex* ir = mxGetIr(p);
-  igraph_eit_t eit;
-  igraph_integer_t eid;
-  igraph_error_t rs;
-
-  rs = igraph_eit_create(graph, igraph_ess_all(IGRAPH_EDGEORDER_TO), &eit);
-  if (rs != IGRAPH_SUCCESS) {
-    mxIgraphSetError(rs);
-    mxIgraphSetErrorMsg("Failed to create edge iterator.");
-    return p;
-  }
-
-  mwIndex count = 0;
-  mwIndex column = 0, prev_column = 0;
-  jc[prev_column] = count;
-  while (!IGRAPH_EIT_END(eit)) {
-    eid = IGRAPH_EIT_GET(eit);
-    column = IGRAPH_TO(graph, eid);
-    if (prev_column != column) {
-      for (mwIndex i = prev_column; i < column; i++) {
-        jc[i + 1] = count;
-      }
-      prev_column = column;
+  csc_builder_t* builder = data;
+  igraph_bool_t const by_row = builder->phase <= CSC_SCATTER_ROWS;
+  igraph_integer_t const len = by_row ? builder->n_entries : builder->n_kept;
+  igraph_integer_t const start = (len * task) / builder->n_chunks;
+  igraph_integer_t const stop = (len * (task + 1)) / builder->n_chunks;
+  mwIndex* offsets = builder->offsets + (task * builder->n_nodes);
+  mwIndex row, col;
+
+  for (igraph_integer_t i = start; i < stop; i++) {
+    igraph_integer_t const k = by_row ? i : builder->order[i];
+    if (!csc_entry_i(builder, k, &row, &col)) {
+      continue;
     }
 
-    ir[count] = IGRAPH_FROM(graph, eid);
-    adj[count] = (weights ? VECTOR(*weights)[eid] : 1);
+    switch (builder->phase) {
+      case CSC_COUNT_ROWS:
+        offsets[row]++;
+        break;
+      case CSC_SCATTER_ROWS:
+        builder->order[offsets[row]++] = k;
+        break;
+      case CSC_COUNT_COLS:
+        offsets[col]++;
+        break;
+      case CSC_SCATTER_COLS: {
+        mwIndex const pos = offsets[col]++;
+        builder->ir[pos] = row;
+        if (builder->values && builder->weights) {
+          builder->values[pos] =
+            VECTOR(*builder->weights)[k % builder->n_edges];
+        } else if (builder->values) {
+          builder->values[pos] = 1;
+        } else {
+          builder->logicals[pos] = true;
+        }
+      } break;
+    }
+  }
+
+  return true;
+}
+
+/* Turn the per chunk counts into each chunk's starting offset for every
+   key. Optionally records where each key starts in starts. Returns the total
+   count. */
+static mwIndex csc_scan_i(csc_builder_t* builder, mwIndex* starts)
+{
+  mwIndex running = 0;
+  for (mwIndex key = 0; key < builder->n_nodes; key++) {
+    if (starts) {
+      starts[key] = running;
+    }
 
-    IGRAPH_EIT_NEXT(eit);
-    count++;
+    for (igraph_integer_t c = 0; c < builder->n_chunks; c++) {
+      mwIndex* offset = builder->offsets + (c * builder->n_nodes) + key;
+      mwIndex const count = *offset;
+      *offset = running;
+      running += count;
+    }
   }
 
-  while (column < n_nodes) {
-    jc[column + 1] = count;
-    column++;
+  if (starts) {
+    starts[builder->n_nodes] = running;
   }
 
-  igraph_eit_destroy(&eit);
+  return running;
+}
 
-  return p;
+static void csc_run_phase_i(csc_builder_t* builder, csc_phase_t const phase)
+{
+  builder->phase = phase;
+  if (builder->n_chunks == 1) {
+    csc_task_i(0, 0, builder);
+  } else {
+    mxIgraphParallelFor(builder->n_chunks, csc_task_i, builder);
+  }
 }
 
-static mxArray* create_adj_sparse_logical_i(igraph_t const* graph)
+/* Sum entries with the same row in each column, which come from parallel
+   edges, and drop entries that end up zero. */
+static void csc_merge_duplicates_i(mwIndex* ir, mwIndex* jc, double* values,
+  bool* logicals, mwSize const n_nodes)
 {
-  mwSize n_edges = igraph_ecount(graph);
-  mwSize n_nodes = igraph_vcount(graph);
-  mxArray* p = mxCreateSparseLogicalMatrix(n_nodes, n_nodes, n_edges);
-  bool* adj = mxGetLogicals(p);
-  mwIndex* jc = mxGetJc(p);
-  mwIndex* ir = mxGetIr(p);
-  igraph_eit_t eit;
-  igraph_integer_t eid;
-  igraph_error_t rs;
-
-  rs = igraph_eit_create(graph, igraph_ess_all(IGRAPH_EDGEORDER_TO), &eit);
-  if (rs != IGRAPH_SUCCESS) {
-    mxIgraphSetError(rs);
-    mxIgraphSetErrorMsg("Failed to create edge iterator.");
-    return p;
-  }
-
-  mwIndex count = 0;
-  mwIndex column = 0, prev_column = 0;
-  jc[prev_column] = count;
-  while (!IGRAPH_EIT_END(eit)) {
-    eid = IGRAPH_EIT_GET(eit);
-    column = IGRAPH_TO(graph, eid);
-    if (prev_column != column) {
-      for (mwIndex i = prev_column; i < column; i++) {
-        jc[i + 1] = count;
+  mwIndex read = 0, write = 0;
+  for (mwIndex j = 0; j < n_nodes; j++) {
+    mwIndex const col_end = jc[j + 1];
+    mwIndex const col_start = write;
+    jc[j] = write;
+
+    for (; read < col_end; read++) {
+      if ((write > col_start) && (ir[write - 1] == ir[read])) {
+        if (values) {
+          values[write - 1] += values[read];
+        }
+        continue;
+      }
+
+      if (values && (write > col_start) && (values[write - 1] == 0)) {
+        write--;
+      }
+
+      ir[write] = ir[read];
+      if (values) {
+        values[write] = values[read];
+      } else {
+        logicals[write] = logicals[read];
       }
-      prev_column = column;
+      write++;
     }
 
-    ir[count] = IGRAPH_FROM(graph, eid);
-    adj[count] = true;
+    if (values && (write > col_start) && (values[write - 1] == 0)) {
+      write--;
+    }
+  }
+  jc[n_nodes] = write;
+}
 
-    IGRAPH_EIT_NEXT(eit);
-    count++;
+/* Build a sparse matrix with two counting sorts, first by row then by
+ column. Since the second sort is stable, rows end up ordered within each
+ column so parallel edges are next to each other and can be summed in a
+ single pass. Everything is O(n_nodes + n_edges).
+
+ For large graphs the counts and scatters are split into chunks which are
+ run in parallel. The number of chunks is limited so the per chunk offsets
+ are no larger than the matrix itself. */
+static mxArray* create_adj_sparse_i(igraph_t const* graph,
+  igraph_vector_t const* weights, igraph_bool_t const is_logical,
+  igraph_bool_t const symmetric)
+{
+  csc_builder_t builder = {
+    .graph = graph,
+    .weights = weights,
+    .n_edges = igraph_ecount(graph),
+    .n_nodes = igraph_vcount(graph),
+    .n_chunks = 1,
+  };
+  builder.n_entries = (symmetric ? 2 : 1) * builder.n_edges;
+
+  if ((builder.n_entries >= MXIGRAPH_PARALLEL_CSC_ENTRIES) &&
+      (builder.n_nodes > 0)) {
+    builder.n_chunks = mxIgraphThreadCount();
+    if ((mwIndex)builder.n_chunks > (builder.n_entries / builder.n_nodes)) {
+      builder.n_chunks = builder.n_entries / builder.n_nodes;
+    }
+
+    if (builder.n_chunks < 1) {
+      builder.n_chunks = 1;
+    }
   }
 
-  while (column < n_nodes) {
-    jc[column + 1] = count;
-    column++;
+  builder.offsets =
+    mxCalloc(builder.n_chunks * builder.n_nodes + 1, sizeof(mwIndex));
+
+  csc_run_phase_i(&builder, CSC_COUNT_ROWS);
+  builder.n_kept = csc_scan_i(&builder, NULL);
+  builder.order = mxMalloc((builder.n_kept + 1) * sizeof(igraph_integer_t));
+  csc_run_phase_i(&builder, CSC_SCATTER_ROWS);
+
+  memset(builder.offsets, 0,
+    (builder.n_chunks * builder.n_nodes + 1) * sizeof(mwIndex));
+  csc_run_phase_i(&builder, CSC_COUNT_COLS);
+
+  mwSize const nzmax = builder.n_kept > 0 ? builder.n_kept : 1;
+  mxArray* p;
+  if (is_logical) {
+    p = mxCreateSparseLogicalMatrix(builder.n_nodes, builder.n_nodes, nzmax);
+  } else {
+    p = mxCreateSparse(builder.n_nodes, builder.n_nodes, nzmax, mxREAL);
   }
 
-  igraph_eit_destroy(&eit);
+  mwIndex* jc = mxGetJc(p);
+  builder.ir = mxGetIr(p);
+  builder.values = is_logical ? NULL : mxGetDoubles(p);
+  builder.logicals = is_logical ? mxGetLogicals(p) : NULL;
+
+  csc_scan_i(&builder, jc);
+  csc_run_phase_i(&builder, CSC_SCATTER_COLS);
+  csc_merge_duplicates_i(
+    builder.ir, jc, builder.values, builder.logicals, builder.n_nodes);
+
+  mxFree(builder.order);
+  mxFree(builder.offsets);
 
   return p;
 }
 
+/* Pass the raw edge list to the graph constructors rather than building
+ node and edge tables to create the graph from. */
 static mxArray* create_graph_i(igraph_t const* graph,
   igraph_vector_t const* weights, char const* weight_att)
 {
   mxArray* ret;
-  mxArray* in[2];
+  mxArray* in[6];
   igraph_integer_t const n_edges = igraph_ecount(graph);
+  int const n_in = weights ? 6 : 4;
 
-  char const* top_fields[] = { "Nodes", "Edges" };
-  mwSize nfields = sizeof(top_fields) / sizeof(top_fields[0]);
-  in[0] = mxCreateStructMatrix(1, 1, nfields, top_fields);
-  in[1] = mxCreateLogicalScalar(igraph_is_directed(graph));
+  in[0] = mxCreateDoubleMatrix(n_edges, 1, mxREAL);
+  in[1] = mxCreateDoubleMatrix(n_edges, 1, mxREAL);
+  in[2] = mxCreateDoubleScalar(igraph_vcount(graph));
+  in[3] = mxCreateLogicalScalar(igraph_is_directed(graph));
 
-  mxArray *mxNodes, *mxEdges;
-  char const* node_fields[] = { "n" };
-  nfields = sizeof(node_fields) / sizeof(node_fields[0]);
-  mxNodes = mxCreateStructMatrix(1, 1, nfields, node_fields);
-  mxSetField(mxNodes, 0, "n", mxCreateDoubleScalar(igraph_vcount(graph)));
+  double* sources = mxGetDoubles(in[0]);
+  double* targets = mxGetDoubles(in[1]);
+  for (igraph_integer_t i = 0; i < n_edges; i++) {
+    sources[i] = IGRAPH_FROM(graph, i) + 1;
+    targets[i] = IGRAPH_TO(graph, i) + 1;
+  }
 
-  char const* edge_fields[weights ? 3 : 2];
-  edge_fields[0] = "n";
-  edge_fields[1] = "EndNodes";
   if (weights) {
-    edge_fields[2] = weight_att;
+    in[4] = mxCreateDoubleMatrix(n_edges, 1, mxREAL);
+    in[5] = mxCreateString(weight_att);
+
+    double* mxWeights = mxGetDoubles(in[4]);
+    for (igraph_integer_t i = 0; i < n_edges; i++) {
+      mxWeights[i] = VECTOR(*weights)[i];
+    }
   }
 
-  mxArray* edge_array = mxCreateDoubleMatrix(n_edges, 2, mxREAL);
-  double* mxEndNodes = mxGetDoubles(edge_array);
+  mexCallMATLAB(1, &ret, n_in, in, "igutils.edges2graph");
+
+  for (int i = 0; i < n_in; i++) {
+    mxDestroyArray(in[i]);
+  }
+
+  return ret;
+}
+
+/* Create an edge list structure with an m x 2 "EndNodes" field, a weight
+ field of the given class when weighted, and a "NumNodes" field so isolated
+ nodes at the end of the graph survive the round trip. */
+static mxArray* create_edgelist_i(igraph_t const* graph,
+  igraph_vector_t const* weights, char const* weight_att,
+  mxClassID const class_id)
+{
+  char const* fields[] = { "EndNodes", "NumNodes", weight_att };
+  int const n_fields = weights ? 3 : 2;
+  igraph_integer_t const n_edges = igraph_ecount(graph);
+  mxArray* p = mxCreateStructMatrix(1, 1, n_fields, fields);
+  mxArray* end_nodes = mxCreateDoubleMatrix(n_edges, 2, mxREAL);
+  double* sources = mxGetDoubles(end_nodes);
+  double* targets = sources + n_edges;
+
   for (igraph_integer_t i = 0; i < n_edges; i++) {
-    mxEndNodes[i] = IGRAPH_FROM(graph, i) + 1;
-    mxEndNodes[i + n_edges] = IGRAPH_TO(graph, i) + 1;
+    sources[i] = IGRAPH_FROM(graph, i) + 1;
+    targets[i] = IGRAPH_TO(graph, i) + 1;
   }
 
-  nfields = sizeof(edge_fields) / sizeof(edge_fields[0]);
-  mxEdges = mxCreateStructMatrix(1, 1, nfields, edge_fields);
-  mxSetField(mxEdges, 0, "n", mxCreateDoubleScalar(n_edges));
-  mxSetField(mxEdges, 0, "EndNodes", edge_array);
+  mxSetField(p, 0, "EndNodes", end_nodes);
+  mxSetField(p, 0, "NumNodes", mxCreateDoubleScalar(igraph_vcount(graph)));
 
   if (weights) {
-    mxArray* weight_array = mxCreateDoubleMatrix(n_edges, 1, mxREAL);
-    double* mxWeights = mxGetDoubles(weight_array);
-    for (igraph_integer_t i = 0; i < n_edges; i++) {
-      mxWeights[i] = VECTOR(*weights)[i];
+    mxArray* mx_weights =
+      mxCreateNumericMatrix(n_edges, 1, class_id, mxREAL);
+
+#define FILL_WEIGHTS_CASE(class_id, type, getter)                             \
+  case class_id: {                                                            \
+    type* dest = getter(mx_weights);                                          \
+    for (igraph_integer_t i = 0; i < n_edges; i++) {                          \
+      dest[i] = MXIGRAPH_CAST(type, VECTOR(*weights)[i]);                     \
+    }                                                                         \
+    break;                                                                    \
+  }
+
+    switch (class_id) {
+      MXIGRAPH_NUMERIC_CLASSES(FILL_WEIGHTS_CASE)
+      default:
+        IGRAPH_FATAL("Received unexpected data type.");
     }
-    mxSetField(mxEdges, 0, weight_att, weight_array);
+
+#undef FILL_WEIGHTS_CASE
+
+    mxSetField(p, 0, weight_att, mx_weights);
   }
 
-  mxSetField(in[0], 0, "Nodes", mxNodes);
-  mxSetField(in[0], 0, "Edges", mxEdges);
-  mexCallMATLAB(1, &ret, 2, in, "igutils.struct2graph");
+  return p;
+}
 
-  return ret;
+/* Pick whichever of a full or sparse adjacency matrix is smaller. Sparse
+ matrices can only hold double or logical values so other data types are
+ always returned full. */
+static mxIgraphRepr_t auto_repr_i(igraph_t const* graph,
+  mxIgraphDType_t const dtype, igraph_bool_t const is_weighted,
+  igraph_bool_t const symmetric)
+{
+  igraph_integer_t const n_nodes = igraph_vcount(graph);
+  igraph_integer_t const n_edges = igraph_ecount(graph);
+  igraph_bool_t const is_directed = igraph_is_directed(graph);
+
+  if ((dtype != MXIGRAPH_DTYPE_DOUBLE) && (dtype != MXIGRAPH_DTYPE_LOGICAL)) {
+    return MXIGRAPH_REPR_FULL;
+  }
+
+  igraph_real_t const full_bytes = mxIgraphEstimateBytes(n_nodes, n_edges,
+    is_directed, MXIGRAPH_REPR_FULL, dtype, is_weighted, symmetric);
+  igraph_real_t const sparse_bytes = mxIgraphEstimateBytes(n_nodes, n_edges,
+    is_directed, MXIGRAPH_REPR_SPARSE, dtype, is_weighted, symmetric);
+
+  return full_bytes <= sparse_bytes ? MXIGRAPH_REPR_FULL :
+                                      MXIGRAPH_REPR_SPARSE;
+}
+
+/* Check the output will fit in the memory budget before allocating any of
+ it. Sets the error state with the estimate when it does not. */
+static igraph_bool_t within_budget_i(igraph_t const* graph,
+  mxIgraphRepr_t const repr, mxIgraphDType_t const dtype,
+  igraph_bool_t const is_weighted, igraph_bool_t const symmetric)
+{
+  char const* names[MXIGRAPH_REPR_N] = {
+    [MXIGRAPH_REPR_GRAPH] = "graph object",
+    [MXIGRAPH_REPR_FULL] = "full matrix",
+    [MXIGRAPH_REPR_SPARSE] = "sparse matrix",
+    [MXIGRAPH_REPR_EDGELIST] = "edge list",
+  };
+  igraph_real_t const budget = mxIgraphMemoryBudget();
+  igraph_real_t const bytes = mxIgraphEstimateBytes(igraph_vcount(graph),
+    igraph_ecount(graph), igraph_is_directed(graph), repr, dtype,
+    is_weighted, symmetric);
+
+  if (bytes <= budget) {
+    return true;
+  }
+
+  mxIgraphSetError(IGRAPH_ENOMEM);
+  mxIgraphSetErrorMsg(
+    "Returning the graph as a %s would need about %.3g GB but the memory "
+    "budget is %.3g GB. Use a smaller representation or data type or raise "
+    "the budget with igraph.memoryBudget.",
+    names[repr], bytes / 1e9, budget / 1e9);
+
+  return false;
 }
 
 /* Create a matlab adjacency matrix using an igraph graph and weight vector.
@@ -420,31 +941,63 @@ mxArray* mxIgraphToArray(igraph_t const* graph, igraph_vector_t const* weights,
   mxArray* p = NULL;
   mxIgraphRepr_t repr = mxIgraphReprFromOptions(graphOpts);
   mxIgraphDType_t dtype = mxIgraphDTypeFromOptions(graphOpts);
-  char const* weight_attr =
-    mxGetField(graphOpts, 0, "weight") ?
-      mxIgraphStringFromOptions(graphOpts, "weight") :
-      "Weight";
+  char weight_attr[MXIGRAPH_NAME_MAX] = "Weight";
+
+  if (mxGetField(graphOpts, 0, "weight")) {
+    mxIgraphStringFromOptions(
+      graphOpts, "weight", weight_attr, sizeof(weight_attr));
+  }
 
   MXIGRAPH_CHECK_STATUS_RETURN(p);
 
   igraph_bool_t const is_weighted = !(
     !weights || igraph_vector_empty(weights) ||
     dtype == MXIGRAPH_DTYPE_LOGICAL);
+  igraph_bool_t const symmetric =
+    !igraph_is_directed(graph) && mxGetField(graphOpts, 0, "symmetric") &&
+    mxIgraphBoolFromOptions(graphOpts, "symmetric");
+
+  if (repr == MXIGRAPH_REPR_AUTO) {
+    repr = auto_repr_i(graph, dtype, is_weighted, symmetric);
+  }
+
+  if ((repr == MXIGRAPH_REPR_SPARSE) && (dtype != MXIGRAPH_DTYPE_DOUBLE) &&
+      (dtype != MXIGRAPH_DTYPE_LOGICAL)) {
+    mxIgraphSetError(IGRAPH_EINVAL);
+    mxIgraphSetErrorMsg("Sparse matrices can only be double or logical.");
+    return NULL;
+  }
+
+  if ((repr == MXIGRAPH_REPR_EDGELIST) && is_weighted &&
+      is_edgelist_field_i(weight_attr)) {
+    mxIgraphSetError(IGRAPH_EINVAL);
+    mxIgraphSetErrorMsg(
+      "Edge list weight field can not be named \"%s\".", weight_attr);
+    return NULL;
+  }
+
+  if (!within_budget_i(graph, repr, dtype, is_weighted, symmetric)) {
+    return NULL;
+  }
 
   if (repr == MXIGRAPH_REPR_GRAPH) {
     p = create_graph_i(graph, is_weighted ? weights : NULL, weight_attr);
+  } else if (repr == MXIGRAPH_REPR_EDGELIST) {
+    p = create_edgelist_i(graph, is_weighted ? weights : NULL, weight_attr,
+      dtype_class_i(dtype));
   } else if ((repr == MXIGRAPH_REPR_SPARSE) &&
              (dtype == MXIGRAPH_DTYPE_LOGICAL)) {
-    p = create_adj_sparse_logical_i(graph);
+    p = create_adj_sparse_i(graph, NULL, true, symmetric);
   } else if ((repr == MXIGRAPH_REPR_SPARSE) &&
              (dtype == MXIGRAPH_DTYPE_DOUBLE)) {
-    p = create_adj_sparse_double_i(graph, is_weighted ? weights : NULL);
+    p = create_adj_sparse_i(
+      graph, is_weighted ? weights : NULL, false, symmetric);
   } else if ((repr == MXIGRAPH_REPR_FULL) &&
              (dtype == MXIGRAPH_DTYPE_LOGICAL)) {
-    p = create_adj_full_logical_i(graph);
-  } else if ((repr == MXIGRAPH_REPR_FULL) &&
-             (dtype == MXIGRAPH_DTYPE_DOUBLE)) {
-    p = create_adj_full_double_i(graph, is_weighted ? weights : NULL);
+    p = create_adj_full_logical_i(graph, symmetric);
+  } else if (repr == MXIGRAPH_REPR_FULL) {
+    p = create_adj_full_i(graph, is_weighted ? weights : NULL, symmetric,
+      dtype_class_i(dtype));
   } else {
     IGRAPH_FATAL("Received unexpected data type or representation.");
   }
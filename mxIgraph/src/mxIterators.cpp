@@ -0,0 +1,189 @@
+/* Copyright 2024 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Collect the edges of an adjacency matrix.
+
+Each combination of storage, element type (logical or any real numeric
+class), triangle and whether weights are wanted gets its own instantiation
+of the collection loop so none of those are tested inside the loop and
+every element type is read in its native width. */
+
+#include "mxIterators.h"
+#include "mxNumeric.h"
+
+namespace {
+
+/* Which part of the matrix edges are read from. Upper includes the diagonal
+   and everything above it, lower the diagonal and everything below. */
+enum class Triangle { all, upper, lower };
+
+/* Because MATLAB stores matrices in column major order, the column is the
+   "outer" loop and the row the "inner" loop so memory is read in order.
+
+   Every element is written out as if it were an edge and the edge count is
+   only advanced for nonzero elements. This keeps the loop free of data
+   dependent branches but means the outputs need room for one more edge than
+   the matrix has. */
+template <typename T, Triangle triangle, bool weighted>
+igraph_integer_t collect_full_i(T const* adj, mwSize const n_nodes,
+  igraph_integer_t* edges, igraph_real_t* weights)
+{
+  igraph_integer_t n_edges = 0;
+  for (mwIndex j = 0; j < n_nodes; j++) {
+    mwIndex const start = triangle == Triangle::lower ? j : 0;
+    mwIndex const stop = triangle == Triangle::upper ? j + 1 : n_nodes;
+    T const* column = adj + (j * n_nodes);
+
+    for (mwIndex i = start; i < stop; i++) {
+      edges[2 * n_edges] = i;
+      edges[(2 * n_edges) + 1] = j;
+      if (weighted) {
+        weights[n_edges] = column[i];
+      }
+      n_edges += column[i] != 0;
+    }
+  }
+
+  return n_edges;
+}
+
+/* Explicitly stored zeros are rare in sparse matrices so unlike the full
+   case the branch is well predicted and it's not worth writing skipped
+   entries. */
+template <typename T, Triangle triangle, bool weighted>
+igraph_integer_t collect_sparse_i(T const* adj, mwIndex const* ir,
+  mwIndex const* jc, mwSize const n_nodes, igraph_integer_t* edges,
+  igraph_real_t* weights)
+{
+  igraph_integer_t n_edges = 0;
+  for (mwIndex j = 0; j < n_nodes; j++) {
+    for (mwIndex k = jc[j]; k < jc[j + 1]; k++) {
+      if ((triangle == Triangle::upper) && (ir[k] > j)) {
+        break;
+      }
+
+      if ((triangle == Triangle::lower) && (ir[k] < j)) {
+        continue;
+      }
+
+      if (adj[k] == 0) {
+        continue;
+      }
+
+      edges[2 * n_edges] = ir[k];
+      edges[(2 * n_edges) + 1] = j;
+      if (weighted) {
+        weights[n_edges] = adj[k];
+      }
+      n_edges++;
+    }
+  }
+
+  return n_edges;
+}
+
+template <typename T, Triangle triangle, bool weighted>
+igraph_integer_t collect_i(mxArray const* p, T const* adj,
+  igraph_integer_t* edges, igraph_real_t* weights)
+{
+  mwSize const n_nodes = mxGetN(p);
+
+  if (mxIsSparse(p)) {
+    return collect_sparse_i<T, triangle, weighted>(
+      adj, mxGetIr(p), mxGetJc(p), n_nodes, edges, weights);
+  }
+
+  return collect_full_i<T, triangle, weighted>(adj, n_nodes, edges, weights);
+}
+
+template <typename T, Triangle triangle>
+igraph_integer_t collect_i(mxArray const* p, T const* adj,
+  igraph_integer_t* edges, igraph_real_t* weights)
+{
+  if (weights) {
+    return collect_i<T, triangle, true>(p, adj, edges, weights);
+  }
+
+  return collect_i<T, triangle, false>(p, adj, edges, weights);
+}
+
+template <typename T>
+igraph_integer_t collect_i(mxArray const* p, T const* adj,
+  Triangle const triangle, igraph_integer_t* edges, igraph_real_t* weights)
+{
+  switch (triangle) {
+    case Triangle::upper:
+      return collect_i<T, Triangle::upper>(p, adj, edges, weights);
+    case Triangle::lower:
+      return collect_i<T, Triangle::lower>(p, adj, edges, weights);
+    default:
+      return collect_i<T, Triangle::all>(p, adj, edges, weights);
+  }
+}
+
+/* Only one triangle needs to be read for undirected graphs with symmetric
+   adjacency matrices. For triangular matrices restricting to the nonzero
+   triangle is free speed. */
+Triangle triangle_i(mxArray const* p, mxIgraphProfile_t const* profile,
+  igraph_bool_t const directed)
+{
+  igraph_bool_t const use_one_side = !directed && profile->is_symmetric;
+
+  if (mxIsSparse(p)) {
+    return use_one_side ? Triangle::upper : Triangle::all;
+  }
+
+  if (profile->is_triu) {
+    return Triangle::upper;
+  }
+
+  if (profile->is_tril || use_one_side) {
+    return Triangle::lower;
+  }
+
+  return Triangle::all;
+}
+
+} // namespace
+
+/* Write the edges of the adjacency matrix p to edges, as (row, column) pairs,
+ and the weights of each edge to weights, unless weights is NULL.
+
+ The profile should be the result of `mxIgraphProfile` on p, it's used to
+ decide which triangle of the matrix edges come from. edges must have room
+ for 2 * (mxIgraphProfileECount(profile, directed) + 1) elements and weights
+ one more than the number of edges. Returns the number of edges written. */
+igraph_integer_t mxIgraph_collect_edges(mxArray const* p,
+  mxIgraphProfile_t const* profile, igraph_bool_t const directed,
+  igraph_integer_t* edges, igraph_real_t* weights)
+{
+  Triangle const triangle = triangle_i(p, profile, directed);
+
+#define COLLECT_CASE(class_id, type, getter)                                  \
+  case class_id:                                                              \
+    return collect_i(p, getter(p), triangle, edges, weights);
+
+  switch (mxGetClassID(p)) {
+    COLLECT_CASE(mxLOGICAL_CLASS, mxLogical, mxGetLogicals)
+    MXIGRAPH_NUMERIC_CLASSES(COLLECT_CASE)
+    default:
+      IGRAPH_FATAL("Received unexpected data type.");
+  }
+
+#undef COLLECT_CASE
+}
@@ -0,0 +1,139 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Constant time lookup of names.
+
+ Names are identified by their 32 bit FNV-1a hash so callers can resolve a
+ name once and pass the hash on later calls instead of the string. Hashes
+ only depend on the name, so they stay valid when names are added, removed,
+ or reordered.
+
+ The table is a minimal-effort perfect hash: slots are picked with a
+ multiplicative hash of the name hash mixed with a salt, and salts are tried
+ until no two names share a slot. With the few dozen names used here and a
+ fixed number of slots a working salt is found after a handful of tries, so
+ a lookup is a single probe followed by a comparison. */
+
+#include <mxIgraph.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LOOKUP_MAX_SALTS 4096
+
+uint32_t mxIgraphHashName(char const* name)
+{
+  uint32_t hash = 2166136261u;
+
+  for (char const* c = name; *c; c++) {
+    hash ^= (unsigned char)*c;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+static igraph_integer_t lookup_slot_i(uint32_t const hash, uint32_t const salt)
+{
+  return (igraph_integer_t)(((hash ^ salt) * 0x9E3779B1u) >>
+                            (32 - MXIGRAPH_LOOKUP_BITS));
+}
+
+static igraph_bool_t lookup_try_salt_i(mxIgraphLookup_t* lookup)
+{
+  for (igraph_integer_t i = 0; i < MXIGRAPH_LOOKUP_SLOTS; i++) {
+    lookup->index[i] = -1;
+  }
+
+  for (igraph_integer_t i = 0; i < lookup->n_names; i++) {
+    if (!lookup->names[i]) {
+      continue;
+    }
+
+    uint32_t const hash = mxIgraphHashName(lookup->names[i]);
+    igraph_integer_t const slot = lookup_slot_i(hash, lookup->salt);
+    if (lookup->index[slot] != -1) {
+      return false;
+    }
+
+    lookup->hashes[slot] = hash;
+    lookup->index[slot] = i;
+  }
+
+  return true;
+}
+
+/* Build a lookup table for names. NULL entries are skipped and can never be
+   returned. The names are not copied so they must outlive the table. */
+igraph_error_t mxIgraphLookupInit(mxIgraphLookup_t* lookup,
+  char const* const names[], igraph_integer_t const n_names)
+{
+  if (n_names > MXIGRAPH_LOOKUP_SLOTS / 2) {
+    IGRAPH_ERRORF("Lookup tables can hold at most %d names, got %"
+                  IGRAPH_PRId ".", IGRAPH_EINVAL,
+      MXIGRAPH_LOOKUP_SLOTS / 2, n_names);
+  }
+
+  for (igraph_integer_t i = 0; i < n_names; i++) {
+    for (igraph_integer_t j = 0; j < i; j++) {
+      if (names[i] && names[j] &&
+          mxIgraphHashName(names[i]) == mxIgraphHashName(names[j])) {
+        IGRAPH_ERRORF("Names \"%s\" and \"%s\" have the same hash.",
+          IGRAPH_EINVAL, names[j], names[i]);
+      }
+    }
+  }
+
+  lookup->names = names;
+  lookup->n_names = n_names;
+  for (uint32_t salt = 0; salt < LOOKUP_MAX_SALTS; salt++) {
+    lookup->salt = salt;
+    if (lookup_try_salt_i(lookup)) {
+      return IGRAPH_SUCCESS;
+    }
+  }
+
+  IGRAPH_ERROR("Could not find a perfect hash for names.", IGRAPH_FAILURE);
+}
+
+/* Index of the name with the given hash or -1 if there is none. */
+igraph_integer_t mxIgraphLookupHash(
+  mxIgraphLookup_t const* lookup, uint32_t const hash)
+{
+  igraph_integer_t const slot = lookup_slot_i(hash, lookup->salt);
+
+  if ((lookup->index[slot] == -1) || (lookup->hashes[slot] != hash)) {
+    return -1;
+  }
+
+  return lookup->index[slot];
+}
+
+/* Index of name or -1 if it is not in the table. Since different strings
+   can share a hash, the name found is compared against the requested one. */
+igraph_integer_t mxIgraphLookupName(
+  mxIgraphLookup_t const* lookup, char const* name)
+{
+  igraph_integer_t const idx =
+    mxIgraphLookupHash(lookup, mxIgraphHashName(name));
+
+  if ((idx == -1) || (strcmp(lookup->names[idx], name) != 0)) {
+    return -1;
+  }
+
+  return idx;
+}
@@ -0,0 +1,128 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Memory budget for graphs returned to MATLAB.
+
+ Returning a large graph as a full matrix can ask MATLAB for far more memory
+ than the machine has, which either fails only after the graph has been
+ built or leaves MATLAB swapping. Before creating its output,
+ `mxIgraphToArray` estimates the bytes the requested representation needs
+ and refuses to build anything larger than the budget.
+
+ The budget defaults to half of the machine's physical memory. If the
+ physical memory can not be determined the budget is unlimited. */
+
+#include <mxIgraph.h>
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <unistd.h>
+#endif
+
+static igraph_real_t memory_budget = -1;
+
+static igraph_real_t physical_memory_i(void)
+{
+#ifdef _WIN32
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (GlobalMemoryStatusEx(&status)) {
+    return (igraph_real_t)status.ullTotalPhys;
+  }
+#elif defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+  long const pages = sysconf(_SC_PHYS_PAGES);
+  long const page_size = sysconf(_SC_PAGESIZE);
+  if ((pages > 0) && (page_size > 0)) {
+    return (igraph_real_t)pages * (igraph_real_t)page_size;
+  }
+#endif
+
+  return IGRAPH_INFINITY;
+}
+
+/* The current memory budget in bytes. */
+igraph_real_t mxIgraphMemoryBudget(void)
+{
+  if (memory_budget < 0) {
+    memory_budget = physical_memory_i() / 2;
+  }
+
+  return memory_budget;
+}
+
+/* Set the memory budget in bytes. A negative budget restores the default and
+ an infinite budget disables the check. */
+void mxIgraphSetMemoryBudget(igraph_real_t const bytes)
+{
+  memory_budget = bytes < 0 ? physical_memory_i() / 2 : bytes;
+}
+
+static igraph_real_t dtype_size_i(mxIgraphDType_t const dtype)
+{
+  size_t const sizes[MXIGRAPH_DTYPE_N] = {
+    [MXIGRAPH_DTYPE_LOGICAL] = sizeof(mxLogical),
+    [MXIGRAPH_DTYPE_DOUBLE] = sizeof(mxDouble),
+    [MXIGRAPH_DTYPE_SINGLE] = sizeof(mxSingle),
+    [MXIGRAPH_DTYPE_INT8] = sizeof(mxInt8),
+    [MXIGRAPH_DTYPE_INT16] = sizeof(mxInt16),
+    [MXIGRAPH_DTYPE_INT32] = sizeof(mxInt32),
+    [MXIGRAPH_DTYPE_INT64] = sizeof(mxInt64),
+    [MXIGRAPH_DTYPE_UINT8] = sizeof(mxUint8),
+    [MXIGRAPH_DTYPE_UINT16] = sizeof(mxUint16),
+    [MXIGRAPH_DTYPE_UINT32] = sizeof(mxUint32),
+    [MXIGRAPH_DTYPE_UINT64] = sizeof(mxUint64),
+  };
+
+  return (igraph_real_t)sizes[dtype];
+}
+
+/* Estimate the bytes needed to return a graph in the given representation.
+
+ Counts are kept in floating point since the size of a full matrix overflows
+ 64-bit integers long before the node count does. Sparse and graph estimates
+ assume no parallel edges get merged so they are upper bounds. Graph objects
+ are built from an edge list and store both an edge table and an internal
+ sparse adjacency matrix, so they need room for all three at once. */
+igraph_real_t mxIgraphEstimateBytes(igraph_integer_t const n_nodes,
+  igraph_integer_t const n_edges, igraph_bool_t const is_directed,
+  mxIgraphRepr_t const repr, mxIgraphDType_t const dtype,
+  igraph_bool_t const is_weighted, igraph_bool_t const symmetric)
+{
+  igraph_real_t const n = (igraph_real_t)n_nodes;
+  igraph_real_t const m = (igraph_real_t)n_edges;
+  igraph_real_t const index_size = sizeof(mwIndex);
+  igraph_real_t const nnz = !is_directed && symmetric ? 2 * m : m;
+
+  switch (repr) {
+    case MXIGRAPH_REPR_FULL:
+      return n * n * dtype_size_i(dtype);
+    case MXIGRAPH_REPR_SPARSE:
+      return ((n + 1) * index_size) +
+             (nnz * (index_size + dtype_size_i(dtype)));
+    case MXIGRAPH_REPR_EDGELIST:
+      return (2 * m * sizeof(mxDouble)) +
+             (is_weighted ? m * dtype_size_i(dtype) : 0);
+    case MXIGRAPH_REPR_GRAPH:
+      return (2 * (2 + (is_weighted ? 1 : 0)) * m * sizeof(mxDouble)) +
+             ((n + 1) * index_size) +
+             ((is_directed ? m : 2 * m) * (index_size + sizeof(mxDouble)));
+    default:
+      IGRAPH_FATAL("Received unexpected representation.");
+  }
+}
@@ -0,0 +1,93 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Helpers for writing code once for every MATLAB numeric class.
+
+   The class lists call X(class_id, type, getter) for each real numeric
+   class, normally to generate the cases of a switch over mxGetClassID, so
+   every class gets its own loop reading the data in its native width rather
+   than converting it to double first. */
+
+#ifndef MXNUMERIC_H
+#define MXNUMERIC_H
+
+#include <mxIgraph.h>
+
+#include <math.h>
+#include <stdint.h>
+
+#define MXIGRAPH_FLOAT_CLASSES(X)                                             \
+  X(mxDOUBLE_CLASS, mxDouble, mxGetDoubles)                                   \
+  X(mxSINGLE_CLASS, mxSingle, mxGetSingles)
+
+#define MXIGRAPH_INTEGER_CLASSES(X)                                           \
+  X(mxINT8_CLASS, mxInt8, mxGetInt8s)                                         \
+  X(mxINT16_CLASS, mxInt16, mxGetInt16s)                                      \
+  X(mxINT32_CLASS, mxInt32, mxGetInt32s)                                      \
+  X(mxINT64_CLASS, mxInt64, mxGetInt64s)                                      \
+  X(mxUINT8_CLASS, mxUint8, mxGetUint8s)                                      \
+  X(mxUINT16_CLASS, mxUint16, mxGetUint16s)                                   \
+  X(mxUINT32_CLASS, mxUint32, mxGetUint32s)                                   \
+  X(mxUINT64_CLASS, mxUint64, mxGetUint64s)
+
+#define MXIGRAPH_NUMERIC_CLASSES(X)                                           \
+  MXIGRAPH_FLOAT_CLASSES(X)                                                   \
+  MXIGRAPH_INTEGER_CLASSES(X)
+
+/* Convert a double to the named element type the way MATLAB's casts do.
+   Integers are rounded to the nearest value, saturate at the ends of their
+   range and NaN becomes 0. */
+#define MXIGRAPH_CAST(type, x) mxIgraph_cast_##type(x)
+
+#define MXIGRAPH_SATURATING_CAST(type, lo, hi)                                \
+  static inline type mxIgraph_cast_##type(double const x)                     \
+  {                                                                           \
+    double const r = round(x);                                                \
+    if (r != r) {                                                             \
+      return 0;                                                               \
+    }                                                                         \
+                                                                              \
+    if (r <= (double)(lo)) {                                                  \
+      return (lo);                                                            \
+    }                                                                         \
+                                                                              \
+    if (r >= (double)(hi)) {                                                  \
+      return (hi);                                                            \
+    }                                                                         \
+                                                                              \
+    return (type)r;                                                           \
+  }
+
+static inline mxDouble mxIgraph_cast_mxDouble(double const x) { return x; }
+static inline mxSingle mxIgraph_cast_mxSingle(double const x)
+{
+  return (mxSingle)x;
+}
+
+MXIGRAPH_SATURATING_CAST(mxInt8, INT8_MIN, INT8_MAX)
+MXIGRAPH_SATURATING_CAST(mxInt16, INT16_MIN, INT16_MAX)
+MXIGRAPH_SATURATING_CAST(mxInt32, INT32_MIN, INT32_MAX)
+MXIGRAPH_SATURATING_CAST(mxInt64, INT64_MIN, INT64_MAX)
+MXIGRAPH_SATURATING_CAST(mxUint8, 0, UINT8_MAX)
+MXIGRAPH_SATURATING_CAST(mxUint16, 0, UINT16_MAX)
+MXIGRAPH_SATURATING_CAST(mxUint32, 0, UINT32_MAX)
+MXIGRAPH_SATURATING_CAST(mxUint64, 0, UINT64_MAX)
+
+#undef MXIGRAPH_SATURATING_CAST
+
+#endif
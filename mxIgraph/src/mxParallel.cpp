@@ -0,0 +1,121 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Minimal thread pool for running independent tasks.
+
+Tasks run on worker threads so they must not call into the MATLAB API
+(including mxMalloc and friends) or the igraph error handlers. Anything that
+needs MATLAB should be done on the calling thread before or after
+mxIgraphParallelFor. Use mxIgraphBatchRun to run igraph functions that may
+raise errors on the pool. */
+
+#include <mxIgraph.h>
+
+#include <atomic>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+static igraph_integer_t mxIgraph_n_threads = 0;
+
+/* Number of threads used by mxIgraphParallelFor. Defaults to the number of
+ hardware threads. */
+igraph_integer_t mxIgraphThreadCount(void)
+{
+  if (mxIgraph_n_threads > 0) {
+    return mxIgraph_n_threads;
+  }
+
+  igraph_integer_t const n_hardware = std::thread::hardware_concurrency();
+  return n_hardware > 0 ? n_hardware : 1;
+}
+
+/* Set the number of threads to use. A value less than 1 resets to the
+ default. */
+void mxIgraphSetThreadCount(igraph_integer_t const n_threads)
+{
+  mxIgraph_n_threads = n_threads > 0 ? n_threads : 0;
+}
+
+/* Run fn on each of the tasks 0..n_tasks - 1.
+
+ Tasks are handed out dynamically so there should be more tasks than threads
+ if they are not all the same size. Along with the task index, fn gets the
+ index of the thread it is running on (in 0..mxIgraphThreadCount() - 1),
+ which can be used to index per thread workspaces.
+
+ If fn returns false no more tasks will be started, tasks already running
+ will still finish. Returns true if every task ran and returned true.
+
+ If threads can not be created the tasks are run on the calling thread. */
+igraph_bool_t mxIgraphParallelFor(
+  igraph_integer_t const n_tasks, mxIgraphTask_t* fn, void* data)
+{
+  return mxIgraphParallelForThreads(
+    n_tasks, mxIgraphThreadCount(), fn, data);
+}
+
+/* Like mxIgraphParallelFor but starts at most max_threads threads, so thread
+ indices are less than max_threads. For tasks whose per thread workspaces
+ are too large to give every thread one. */
+igraph_bool_t mxIgraphParallelForThreads(igraph_integer_t const n_tasks,
+  igraph_integer_t const max_threads, mxIgraphTask_t* fn, void* data)
+{
+  std::atomic<igraph_integer_t> next_task(0);
+  std::atomic<bool> keep_going(true);
+
+  auto worker = [&](igraph_integer_t const thread_id) {
+    while (keep_going.load(std::memory_order_relaxed)) {
+      igraph_integer_t const task = next_task.fetch_add(1);
+      if (task >= n_tasks) {
+        break;
+      }
+
+      if (!fn(task, thread_id, data)) {
+        keep_going.store(false, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  igraph_integer_t n_threads = max_threads;
+  if (n_threads > mxIgraphThreadCount()) {
+    n_threads = mxIgraphThreadCount();
+  }
+  if (n_threads > n_tasks) {
+    n_threads = n_tasks;
+  }
+
+  std::vector<std::thread> threads;
+  try {
+    threads.reserve(n_threads > 1 ? n_threads - 1 : 0);
+    for (igraph_integer_t i = 1; i < n_threads; i++) {
+      threads.emplace_back(worker, i);
+    }
+  } catch (std::system_error const&) {
+    // Fall through with however many threads were started.
+  } catch (std::bad_alloc const&) {
+  }
+
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return keep_going.load();
+}
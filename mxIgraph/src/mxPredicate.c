@@ -18,6 +18,9 @@
 
 #include <mxIgraph.h>
 
+#include "mxDense.h"
+#include "mxNumeric.h"
+
 igraph_bool_t mxIgraphIsSquare(mxArray const* p)
 {
   mwIndex m = mxGetM(p);
@@ -42,22 +45,17 @@ static igraph_bool_t is_weighted_sparse_i(mxArray const* p)
   return false;
 }
 
-static igraph_bool_t is_weighted_full_i(mxArray const* p)
+/* Any field other than the end nodes and node count is a weight column. */
+static igraph_bool_t edgelist_has_weights_i(mxArray const* p)
 {
-  mxDouble* adj = mxGetDoubles(p);
-  mwSize m = mxGetM(p);
-
-  mxDouble el;
-  for (mwIndex i = 0; i < m; i++) {
-    for (mwIndex j = 0; j < m; j++) {
-      el = adj[i + (j * m)];
-      if ((el != 0) && (el != 1)) {
-        return true;
-      }
-    }
+  int const n_fields = mxGetNumberOfFields(p);
+  int n_known = 1;
+
+  if (mxGetField(p, 0, "NumNodes")) {
+    n_known++;
   }
 
-  return false;
+  return n_fields > n_known;
 }
 
 /* Test if adjacency matrix p points to has values other than 0 or 1. */
@@ -68,6 +66,10 @@ igraph_bool_t mxIgraphIsWeighted(mxArray const* p)
     return true;
   }
 
+  if (mxIgraphIsEdgeList(p)) {
+    return edgelist_has_weights_i(p);
+  }
+
   if (mxIsLogical(p)) {
     return false;
   }
@@ -76,57 +78,7 @@ igraph_bool_t mxIgraphIsWeighted(mxArray const* p)
     return is_weighted_sparse_i(p);
   }
 
-  return is_weighted_full_i(p);
-}
-
-static mxDouble sparse_double_index_i(mxDouble const* column, mwIndex const i,
-  mwIndex const* row_indices, mwIndex const len)
-{
-  if (len == 0) {
-    return 0;
-  }
-
-  mwIndex rng[] = { 0, len - 1 };
-  mwIndex idx = (len - 1) / 2;
-  while ((rng[1] >= rng[0]) && (rng[1] < len)) { // Protect against underflow
-    if (row_indices[idx] == i) {
-      return column[idx];
-    }
-
-    if (row_indices[idx] < i) {
-      rng[0] = idx + 1;
-    } else {
-      rng[1] = idx - 1;
-    }
-    idx = (rng[0] + rng[1]) / 2;
-  }
-
-  return 0;
-}
-
-static bool sparse_logical_index_i(bool const* column, mwIndex const i,
-  mwIndex const* row_indices, mwIndex const len)
-{
-  if (len == 0) {
-    return 0;
-  }
-
-  mwIndex rng[] = { 0, len - 1 };
-  mwIndex idx = (len - 1) / 2;
-  while ((rng[1] >= rng[0]) && (rng[1] < len)) { // Protect against underflow
-    if (row_indices[idx] == i) {
-      return column[idx];
-    }
-
-    if (row_indices[idx] < i) {
-      rng[0] = idx + 1;
-    } else {
-      rng[1] = idx - 1;
-    }
-    idx = (rng[0] + rng[1]) / 2;
-  }
-
-  return 0;
+  return mxIgraph_dense_is_weighted(p);
 }
 
 static igraph_bool_t comp_lessthan(mwIndex a, mwIndex b) { return a < b; }
@@ -153,172 +105,429 @@ static igraph_bool_t is_tri_sparse(
   return true;
 }
 
-static mwIndex regular_index(mwIndex i, mwIndex j, mwIndex n_rows)
+igraph_bool_t mxIgraphIsTriU(mxArray const* p)
 {
-  return i + (j * n_rows);
+  if (mxIsSparse(p)) {
+    return is_tri_sparse(p, comp_greaterthan);
+  }
+
+  return mxIgraph_dense_is_triu(p);
 }
 
-static mwIndex transposed_index(mwIndex i, mwIndex j, mwIndex n_rows)
+igraph_bool_t mxIgraphIsTriL(mxArray const* p)
 {
-  return j + (i * n_rows);
+  if (mxIsSparse(p)) {
+    return is_tri_sparse(p, comp_lessthan);
+  }
+
+  return mxIgraph_dense_is_tril(p);
 }
 
-static igraph_bool_t is_tri_full_logical(
-  mxArray const* p, mwIndex index(mwIndex, mwIndex, mwIndex))
+/* Sparse matrices with at least this many stored entries are checked for
+   symmetry in parallel. */
+#define MXIGRAPH_PARALLEL_SYMMETRY_NNZ 4194304
+
+static igraph_integer_t parallel_symmetry_nnz = MXIGRAPH_PARALLEL_SYMMETRY_NNZ;
+
+/* Number of stored entries above which sparse symmetry is checked in
+   parallel. */
+igraph_integer_t mxIgraphParallelSymmetryThreshold(void)
 {
-  bool* adj = mxGetLogicals(p);
-  mwIndex n_nodes = mxGetM(p);
+  return parallel_symmetry_nnz;
+}
 
-  for (mwIndex i = 0; i < n_nodes; i++) {
-    for (mwIndex j = (i + 1); j < n_nodes; j++) {
-      if (adj[index(i, j, n_nodes)] != 0) {
-        return false;
-      }
+/* Change the parallel symmetry threshold. Mainly so tests can exercise the
+   parallel path on small matrices. Negative values restore the default. */
+void mxIgraphSetParallelSymmetryThreshold(igraph_integer_t const nnz)
+{
+  parallel_symmetry_nnz = nnz < 0 ? MXIGRAPH_PARALLEL_SYMMETRY_NNZ : nnz;
+}
+
+typedef struct {
+  mwIndex const* ir;
+  mwIndex const* jc;
+  mxDouble const* values;
+  mxLogical const* logicals;
+  mwIndex n_nodes;
+} sparse_view_t;
+
+static mxDouble sparse_value_i(sparse_view_t const* view, mwIndex const k)
+{
+  return view->logicals ? view->logicals[k] : view->values[k];
+}
+
+/* Position of the first entry in column j with a row index of at least
+   row. */
+static mwIndex sparse_lower_bound_i(
+  sparse_view_t const* view, mwIndex const j, mwIndex const row)
+{
+  mwIndex lo = view->jc[j];
+  mwIndex hi = view->jc[j + 1];
+  while (lo < hi) {
+    mwIndex const mid = lo + ((hi - lo) / 2);
+    if (view->ir[mid] < row) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
 
-  return true;
+  return lo;
 }
 
-static igraph_bool_t is_tri_full_double(
-  mxArray const* p, mwIndex index(mwIndex, mwIndex, mwIndex))
+/* Check the columns j_start..j_end - 1 for symmetry by merging each column
+   against the rows of the transpose.
+
+   For every nonzero below the diagonal, (i, j), the mirror (j, i) is looked
+   up in column i through cursor[i]. Since the columns are visited in order,
+   the rows looked up in any given column only increase so each cursor only
+   moves forward and every stored entry is visited a constant number of
+   times. A nonzero the cursor has to step over has no mirror, so the check
+   stops there.
+
+   Cursors start at the first row >= j_start in their column. If stamp is
+   NULL the cursors have already been positioned, otherwise the cursor for a
+   column is positioned the first time it is used, stamp records which block
+   last positioned it so a workspace can be reused between blocks.
+
+   The number of nonzeros above and below the diagonal are added to n_upper
+   and n_lower. Every nonzero below the diagonal is matched to a distinct
+   nonzero above it, so the matrix is symmetric if there are no mismatches
+   and the two totals agree across all blocks. */
+static igraph_bool_t is_symmetric_sparse_block_i(sparse_view_t const* view,
+  mwIndex const j_start, mwIndex const j_end, mwIndex* cursor,
+  igraph_integer_t* stamp, igraph_integer_t const block, mwIndex* n_upper,
+  mwIndex* n_lower)
 {
-  mxDouble* adj = mxGetDoubles(p);
-  mwIndex n_nodes = mxGetM(p);
+  mwIndex const* ir = view->ir;
+  mwIndex const* jc = view->jc;
+
+  for (mwIndex j = j_start; j < j_end; j++) {
+    for (mwIndex k = jc[j]; k < jc[j + 1]; k++) {
+      mxDouble const w = sparse_value_i(view, k);
+      mwIndex const i = ir[k];
+
+      if ((w == 0) || (i == j)) {
+        continue;
+      }
+
+      if (i < j) {
+        (*n_upper)++;
+        continue;
+      }
+
+      if (stamp && (stamp[i] != block)) {
+        cursor[i] = sparse_lower_bound_i(view, i, j_start);
+        stamp[i] = block;
+      }
+
+      mwIndex c = cursor[i];
+      while ((c < jc[i + 1]) && (ir[c] < j)) {
+        if (sparse_value_i(view, c) != 0) {
+          return false;
+        }
+        c++;
+      }
 
-  for (mwIndex i = 0; i < n_nodes; i++) {
-    for (mwIndex j = (i + 1); j < n_nodes; j++) {
-      if (adj[index(i, j, n_nodes)] != 0) {
+      if ((c == jc[i + 1]) || (ir[c] != j) || (sparse_value_i(view, c) != w)) {
         return false;
       }
+
+      cursor[i] = c + 1;
+      (*n_lower)++;
     }
   }
 
   return true;
 }
 
-igraph_bool_t mxIgraphIsTriU(mxArray const* p)
+static void sparse_view_init_i(mxArray const* p, sparse_view_t* view)
 {
-  if (mxIsSparse(p)) {
-    return is_tri_sparse(p, comp_greaterthan);
-  }
+  view->ir = mxGetIr(p);
+  view->jc = mxGetJc(p);
+  view->values = mxIsLogical(p) ? NULL : mxGetDoubles(p);
+  view->logicals = mxIsLogical(p) ? mxGetLogicals(p) : NULL;
+  view->n_nodes = mxGetN(p);
+}
 
-  if (mxIsLogical(p)) {
-    return is_tri_full_logical(p, transposed_index);
+static igraph_bool_t is_symmetric_sparse_serial_i(sparse_view_t const* view)
+{
+  mwIndex* cursor = mxMalloc(view->n_nodes * sizeof(*cursor));
+  mwIndex n_upper = 0, n_lower = 0;
+
+  for (mwIndex j = 0; j < view->n_nodes; j++) {
+    cursor[j] = view->jc[j];
   }
 
-  return is_tri_full_double(p, transposed_index);
+  igraph_bool_t res = is_symmetric_sparse_block_i(
+    view, 0, view->n_nodes, cursor, NULL, 0, &n_upper, &n_lower);
+  mxFree(cursor);
+
+  return res && (n_upper == n_lower);
 }
 
-igraph_bool_t mxIgraphIsTriL(mxArray const* p)
+typedef struct {
+  sparse_view_t const* view;
+  mwIndex* block_starts;
+  mwIndex* n_upper;
+  mwIndex* n_lower;
+  mwIndex* cursors;
+  igraph_integer_t* stamps;
+} symmetry_tasks_t;
+
+static igraph_bool_t is_symmetric_sparse_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
 {
-  if (mxIsSparse(p)) {
-    return is_tri_sparse(p, comp_lessthan);
+  symmetry_tasks_t* tasks = data;
+  mwIndex const n_nodes = tasks->view->n_nodes;
+
+  return is_symmetric_sparse_block_i(tasks->view, tasks->block_starts[task],
+    tasks->block_starts[task + 1], tasks->cursors + (thread * n_nodes),
+    tasks->stamps + (thread * n_nodes), task, tasks->n_upper + task,
+    tasks->n_lower + task);
+}
+
+/* Split the columns into blocks with roughly the same number of stored
+   entries and check the blocks in parallel. Each thread has its own cursors
+   which are lazily positioned at the start of the block being checked.
+
+   The per-thread cursors take n_nodes entries each so the number of threads
+   is limited to keep the workspace no larger than the matrix's row
+   indices. The pool is capped at the same number so no thread indexes past
+   the workspace. */
+static igraph_bool_t is_symmetric_sparse_parallel_i(sparse_view_t const* view)
+{
+  mwIndex const n_nodes = view->n_nodes;
+  mwIndex const nnz = view->jc[n_nodes];
+  igraph_integer_t n_threads = mxIgraphThreadCount();
+
+  if ((n_nodes > 0) && ((mwIndex)n_threads > (nnz / n_nodes))) {
+    n_threads = nnz / n_nodes;
   }
 
-  if (mxIsLogical(p)) {
-    return is_tri_full_logical(p, regular_index);
+  if (n_threads < 2) {
+    return is_symmetric_sparse_serial_i(view);
+  }
+
+  // Extra blocks so threads stay busy when entries are not evenly spread.
+  igraph_integer_t const n_blocks = 4 * n_threads;
+  symmetry_tasks_t tasks = { .view = view };
+  tasks.block_starts = mxMalloc((n_blocks + 1) * sizeof(mwIndex));
+  tasks.n_upper = mxCalloc(n_blocks, sizeof(mwIndex));
+  tasks.n_lower = mxCalloc(n_blocks, sizeof(mwIndex));
+  tasks.cursors = mxMalloc(n_threads * n_nodes * sizeof(mwIndex));
+  tasks.stamps = mxMalloc(n_threads * n_nodes * sizeof(igraph_integer_t));
+
+  for (mwIndex i = 0; i < (n_threads * n_nodes); i++) {
+    tasks.stamps[i] = -1;
   }
 
-  return is_tri_full_double(p, regular_index);
+  mwIndex j = 0;
+  for (igraph_integer_t b = 0; b < n_blocks; b++) {
+    mwIndex const first_entry = (nnz / n_blocks) * b;
+    while ((j < n_nodes) && (view->jc[j] < first_entry)) {
+      j++;
+    }
+    tasks.block_starts[b] = j;
+  }
+  tasks.block_starts[n_blocks] = n_nodes;
+
+  igraph_bool_t res = mxIgraphParallelForThreads(
+    n_blocks, n_threads, is_symmetric_sparse_task_i, &tasks);
+
+  mwIndex n_upper = 0, n_lower = 0;
+  for (igraph_integer_t b = 0; b < n_blocks; b++) {
+    n_upper += tasks.n_upper[b];
+    n_lower += tasks.n_lower[b];
+  }
+
+  mxFree(tasks.block_starts);
+  mxFree(tasks.n_upper);
+  mxFree(tasks.n_lower);
+  mxFree(tasks.cursors);
+  mxFree(tasks.stamps);
+
+  return res && (n_upper == n_lower);
 }
 
-static igraph_bool_t is_symmetric_sparse_double_i(mxArray const* p)
+static igraph_bool_t is_symmetric_sparse_i(mxArray const* p)
 {
-  mxDouble* adj = mxGetDoubles(p);
-  mwIndex* ir = mxGetIr(p);
-  mwIndex* jc = mxGetJc(p);
-  mwIndex n_nodes = mxGetM(p);
+  sparse_view_t view;
+  sparse_view_init_i(p, &view);
 
-  mxDouble reflection;
-  mwIndex row_i;
-  for (mwIndex j = 0; j < n_nodes; j++) {
-    for (mwIndex i = jc[j]; i < jc[j + 1]; i++) {
-      row_i = ir[i];
-      reflection = sparse_double_index_i(
-        adj + jc[row_i], j, ir + jc[row_i], jc[row_i + 1] - jc[row_i]);
-      if (reflection != adj[i]) {
-        return false;
-      }
-    }
+  if ((igraph_integer_t)view.jc[view.n_nodes] >= parallel_symmetry_nnz) {
+    return is_symmetric_sparse_parallel_i(&view);
   }
 
-  return true;
+  return is_symmetric_sparse_serial_i(&view);
 }
 
-static igraph_bool_t is_symmetric_sparse_logical_i(mxArray const* p)
+/* Test if the adjacency matrix pointed to by p is symmetric. */
+igraph_bool_t mxIgraphIsSymmetric(mxArray const* p)
 {
-  bool* adj = mxGetLogicals(p);
-  mwIndex* ir = mxGetIr(p);
-  mwIndex* jc = mxGetJc(p);
-  mwIndex n_nodes = mxGetM(p);
+  if (!(mxIgraphIsSquare(p))) {
+    return false;
+  }
 
-  mxDouble reflection;
-  mwIndex row_i;
-  for (mwIndex j = 0; j < n_nodes; j++) {
-    for (mwIndex i = jc[j]; i < jc[j + 1]; i++) {
-      row_i = ir[i];
-      reflection = sparse_logical_index_i(
-        adj + jc[row_i], j, ir + jc[row_i], jc[row_i + 1] - jc[row_i]);
-      if (reflection != adj[i]) {
-        return false;
-      }
-    }
+  if (mxIsSparse(p) && (mxIsDouble(p) || mxIsLogical(p))) {
+    return is_symmetric_sparse_i(p);
+  } else if (!mxIsSparse(p) && (mxIsNumeric(p) || mxIsLogical(p))) {
+    return mxIgraph_dense_is_symmetric(p);
   }
 
-  return true;
+  IGRAPH_FATAL("Received unexpected data type or representation");
 }
 
-static igraph_bool_t is_symmetric_full_logical_i(mxArray const* p)
+static void profile_entry_i(mxIgraphProfile_t* profile, mwIndex const i,
+  mwIndex const j, double const w)
 {
-  bool* adj = mxGetLogicals(p);
-  mwIndex n_nodes = mxGetM(p);
+  profile->nnz++;
 
-  for (mwIndex i = 0; i < n_nodes; i++) {
-    for (mwIndex j = (i + 1); j < n_nodes; j++) {
-      if (adj[i + (j * n_nodes)] != adj[j + (i * n_nodes)]) {
-        return false;
-      }
-    }
+  if (i == j) {
+    profile->n_loops++;
+  } else if (i > j) {
+    profile->is_triu = false;
+  } else {
+    profile->is_tril = false;
   }
 
-  return true;
+  if (w != 1) {
+    profile->is_weighted = true;
+  }
+
+  if (w < profile->min_weight) {
+    profile->min_weight = w;
+  }
+
+  if (w > profile->max_weight) {
+    profile->max_weight = w;
+  }
 }
 
-static igraph_bool_t is_symmetric_full_double_i(mxArray const* p)
+static void profile_sparse_i(mxArray const* p, mxIgraphProfile_t* profile)
 {
-  mxDouble* adj = mxGetDoubles(p);
-  mwIndex n_nodes = mxGetM(p);
-
-  for (mwIndex i = 0; i < n_nodes; i++) {
-    for (mwIndex j = (i + 1); j < n_nodes; j++) {
-      if (adj[i + (j * n_nodes)] != adj[j + (i * n_nodes)]) {
-        return false;
+  mwIndex const* ir = mxGetIr(p);
+  mwIndex const* jc = mxGetJc(p);
+  mwSize const n = mxGetN(p);
+  igraph_bool_t const is_logical = mxIsLogical(p);
+  double const* values = is_logical ? NULL : mxGetDoubles(p);
+  mxLogical const* logicals = is_logical ? mxGetLogicals(p) : NULL;
+
+  for (mwIndex j = 0; j < n; j++) {
+    for (mwIndex k = jc[j]; k < jc[j + 1]; k++) {
+      double const w = is_logical ? logicals[k] : values[k];
+      if (w != 0) {
+        profile_entry_i(profile, ir[k], j, w);
       }
     }
   }
 
-  return true;
+  /* Symmetry needs random access to the transpose so it can not be part of
+     the scan. A triangular matrix is only symmetric if it's diagonal, in
+     which case it must be triangular in both directions. */
+  if (profile->is_triu || profile->is_tril) {
+    profile->is_symmetric = profile->is_triu && profile->is_tril;
+  } else {
+    profile->is_symmetric = profile->is_square && mxIgraphIsSymmetric(p);
+  }
 }
 
-/* Test if the adjacency matrix pointed to by p is symmetric. */
-igraph_bool_t mxIgraphIsSymmetric(mxArray const* p)
+#define PROFILE_FULL_BODY(adj)                                                \
+  do {                                                                        \
+    for (mwIndex j = 0; j < n; j++) {                                         \
+      for (mwIndex i = 0; i < m; i++) {                                       \
+        double const w = (adj)[i + (j * m)];                                  \
+        if (w != 0) {                                                         \
+          profile_entry_i(profile, i, j, w);                                  \
+        }                                                                     \
+      }                                                                       \
+    }                                                                         \
+  } while (0)
+
+#define PROFILE_FULL_CASE(class_id, type, getter)                             \
+  case class_id: {                                                            \
+    type const* adj = getter(p);                                              \
+    PROFILE_FULL_BODY(adj);                                                   \
+    break;                                                                    \
+  }
+
+static void profile_full_i(mxArray const* p, mxIgraphProfile_t* profile)
 {
-  if (!(mxIgraphIsSquare(p))) {
-    return false;
+  mwSize const m = mxGetM(p);
+  mwSize const n = mxGetN(p);
+
+  switch (mxGetClassID(p)) {
+    PROFILE_FULL_CASE(mxLOGICAL_CLASS, mxLogical, mxGetLogicals)
+    MXIGRAPH_NUMERIC_CLASSES(PROFILE_FULL_CASE)
+    default:
+      IGRAPH_FATAL("Received unexpected data type.");
   }
 
-  if (mxIsSparse(p) && mxIsDouble(p)) {
-    return is_symmetric_sparse_double_i(p);
-  } else if (mxIsSparse(p) && mxIsLogical(p)) {
-    return is_symmetric_sparse_logical_i(p);
-  } else if (mxIsDouble(p)) {
-    return is_symmetric_full_double_i(p);
-  } else if (mxIsLogical(p)) {
-    return is_symmetric_full_logical_i(p);
+  /* As with sparse matrices, comparing against the transpose is left out of
+     the scan. The tiled comparison reads the matrix once more but without
+     the strided access. */
+  if (profile->is_triu || profile->is_tril) {
+    profile->is_symmetric = profile->is_triu && profile->is_tril;
+  } else {
+    profile->is_symmetric =
+      profile->is_square && mxIgraph_dense_is_symmetric(p);
   }
+}
 
-  IGRAPH_FATAL("Received unexpected data type or representation");
+#undef PROFILE_FULL_CASE
+#undef PROFILE_FULL_BODY
+
+/* Collect the structural properties of an adjacency matrix in a single scan.
+
+ Functions that need more than one property of the same matrix should get a
+ profile instead of calling the individual predicates, each of which would
+ scan the matrix again. The min and max weights are over the nonzero
+ entries, for matrices with no nonzero entries they are 0.
+
+ p must be a numeric or logical matrix, not a graph object. Sparse matrices
+ can only be double or logical. */
+void mxIgraphProfile(mxArray const* p, mxIgraphProfile_t* profile)
+{
+  profile->is_square = mxIgraphIsSquare(p);
+  profile->is_triu = profile->is_square;
+  profile->is_tril = profile->is_square;
+  profile->is_symmetric = false;
+  profile->is_weighted = false;
+  profile->nnz = 0;
+  profile->n_loops = 0;
+  profile->min_weight = IGRAPH_INFINITY;
+  profile->max_weight = -IGRAPH_INFINITY;
+
+  if (mxIsSparse(p)) {
+    profile_sparse_i(p, profile);
+  } else {
+    profile_full_i(p, profile);
+  }
+
+  if (profile->nnz == 0) {
+    profile->min_weight = 0;
+    profile->max_weight = 0;
+  }
+}
+
+/* Guess if a graph with the given profile is directed or not. */
+igraph_bool_t mxIgraphProfileIsDirected(mxIgraphProfile_t const* profile)
+{
+  return !(profile->is_triu || profile->is_tril || profile->is_symmetric);
+}
+
+/* Number of edges the matrix with the given profile has.
+
+ If the graph is undirected and the matrix symmetric, pairs of symmetric
+ entries are counted as a single edge. */
+igraph_integer_t mxIgraphProfileECount(
+  mxIgraphProfile_t const* profile, igraph_bool_t const is_directed)
+{
+  if (!is_directed && profile->is_symmetric) {
+    return (profile->nnz + profile->n_loops) / 2;
+  }
+
+  return profile->nnz;
 }
 
 // Test if the MATLAB object is of the graph or digraph type.
@@ -327,13 +536,30 @@ igraph_bool_t mxIgraphIsGraph(mxArray const* p)
   return mxIsClass(p, "graph") || mxIsClass(p, "digraph");
 }
 
-/* Guess if the graph is directed or not. */
+/* Test if the MATLAB object is an edge list structure.
+
+ Edge lists are structures with an m x 2 "EndNodes" field, an optional
+ "NumNodes" field and optionally a weight field. */
+igraph_bool_t mxIgraphIsEdgeList(mxArray const* p)
+{
+  return mxIsStruct(p) && (mxGetField(p, 0, "EndNodes") != NULL);
+}
+
+/* Guess if the graph is directed or not.
+
+ Edge lists store each edge's orientation explicitly so, unlike adjacency
+ matrices, there is nothing to guess from and they are treated as directed
+ unless the caller says otherwise. */
 igraph_bool_t mxIgraphIsDirected(mxArray const* p)
 {
   if (mxIgraphIsGraph(p)) {
     return mxIsClass(p, "digraph");
+  } else if (mxIgraphIsEdgeList(p)) {
+    return true;
   } else {
-    return !(mxIgraphIsTriU(p) || mxIgraphIsTriL(p) || mxIgraphIsSymmetric(p));
+    mxIgraphProfile_t profile;
+    mxIgraphProfile(p, &profile);
+    return mxIgraphProfileIsDirected(&profile);
   }
 }
 
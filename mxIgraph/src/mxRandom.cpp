@@ -19,9 +19,23 @@
 /* Wrap MATLAB's internal RNG for use in igraph.
 
 Depends on functions in the mwmathrng library that are not made public. This
-could break in future versions of MATLAB if the exported functions change. */
+could break in future versions of MATLAB if the exported functions change.
 
+Each draw crosses into the mwmathrng library (or, on Windows, back into
+MATLAB), which dominates the run time of generators that need millions of
+draws. Draws can optionally be taken from MATLAB's stream in bulk and served
+from a buffer. The buffer is emptied at the start of every MEX call and
+whenever the generator is switched, so draws left over from a call are
+never used after MATLAB's RNG may have been reseeded. Results are still
+reproducible for a given seed, but they differ from unbuffered results and
+MATLAB's stream advances by whole buffers. Since integers are then derived
+from buffered uniform draws rather than from randi, and normal, exponential,
+geometric, binomial and Poisson variates come from direct samplers rather
+than igraph's generic ones, buffering is off by default. */
+
+#include <math.h>
 #include <mxIgraph.h>
+#include <stdint.h>
 
 void mrRandu(double* arr, size_t len);
 void mrRandi(double* arr, size_t len, double l, double h);
@@ -108,23 +122,72 @@ void mrRandn(double* arr, mwSize len)
 }
 #endif
 
+/* Draws taken from MATLAB's stream ahead of time. Uniform and normal draws
+ are buffered separately since MATLAB generates them with different
+ functions. */
+typedef struct {
+  double* draws;
+  igraph_integer_t pos;
+} mxIgraph_rng_buffer_t;
+
+static mxIgraph_rng_buffer_t mxIgraph_rng_uniform = { NULL, 0 };
+static mxIgraph_rng_buffer_t mxIgraph_rng_normal = { NULL, 0 };
+static igraph_integer_t mxIgraph_rng_buffer_size = 0;
+
 igraph_real_t mxIgraph_rng_get_real(void* state)
 {
+  mxIgraph_rng_buffer_t* buffer = &mxIgraph_rng_uniform;
   double x = 0;
-  mrRandu(&x, 1);
 
-  return x;
+  if (mxIgraph_rng_buffer_size == 0) {
+    mrRandu(&x, 1);
+    return x;
+  }
+
+  if (buffer->pos == mxIgraph_rng_buffer_size) {
+    mrRandu(buffer->draws, mxIgraph_rng_buffer_size);
+    buffer->pos = 0;
+  }
+
+  return buffer->draws[buffer->pos++];
 }
 
+/* MATLAB's uniform draws have 53 bits of precision, so one draw is enough
+ for a full 32 bit integer. */
 static igraph_uint_t mxIgraph_rng_get(void* state)
 {
-  return (mxIgraph_rng_get_real(state) * 0x40000000UL);
+  return (igraph_uint_t)(mxIgraph_rng_get_real(state) * 4294967296.0);
 }
 
+/* Ranges up to 2^53 are drawn from a single uniform or randi draw. Larger
+ ranges, up to the full 64 bit range, combine two 32 bit draws and reject
+ values that would bias the result. */
 static igraph_integer_t mxIgraph_rng_get_integer(
   void* state, igraph_integer_t l, igraph_integer_t h)
 {
+  igraph_uint_t const span = (igraph_uint_t)h - (igraph_uint_t)l;
   double x = 0;
+
+  if (span >= ((igraph_uint_t)1 << 53)) {
+    igraph_uint_t const n = span + 1;
+    igraph_uint_t const limit = n == 0 ? 0 : UINT64_MAX - (UINT64_MAX % n);
+    igraph_uint_t bits;
+
+    do {
+      bits = mxIgraph_rng_get(state) << 32;
+      bits |= mxIgraph_rng_get(state);
+    } while ((n != 0) && (bits >= limit));
+
+    return (igraph_integer_t)((igraph_uint_t)l + (n == 0 ? bits : bits % n));
+  }
+
+  if (mxIgraph_rng_buffer_size > 0) {
+    igraph_real_t const u = mxIgraph_rng_get_real(state);
+    igraph_integer_t const res =
+      l + (igraph_integer_t)(u * ((double)span + 1));
+    return res > h ? h : res;
+  }
+
   mrRandi(&x, 1, l, h);
 
   return x;
@@ -132,12 +195,182 @@ static igraph_integer_t mxIgraph_rng_get_integer(
 
 static igraph_real_t mxIgraph_rng_get_normal(void* state)
 {
+  mxIgraph_rng_buffer_t* buffer = &mxIgraph_rng_normal;
   double x = 0;
-  mrRandn(&x, 1);
 
-  return x;
+  if (mxIgraph_rng_buffer_size == 0) {
+    mrRandn(&x, 1);
+    return x;
+  }
+
+  if (buffer->pos == mxIgraph_rng_buffer_size) {
+    mrRandn(buffer->draws, mxIgraph_rng_buffer_size);
+    buffer->pos = 0;
+  }
+
+  return buffer->draws[buffer->pos++];
+}
+
+/* The samplers below replace igraph's defaults, which are built on get_real
+ and often need several draws per variate, when draws are buffered. MATLAB's
+ uniform draws are never exactly 0 or 1 so their logarithms are always
+ finite. */
+
+static igraph_real_t mxIgraph_rng_get_exp(void* state, igraph_real_t rate)
+{
+  if (!(rate >= 0)) {
+    return IGRAPH_NAN;
+  }
+
+  if (rate == 0) {
+    return IGRAPH_INFINITY;
+  }
+
+  return -log(mxIgraph_rng_get_real(state)) / rate;
 }
 
+/* Number of failures before the first success, by inversion. */
+static igraph_real_t mxIgraph_rng_get_geom(void* state, igraph_real_t p)
+{
+  if (!(p > 0) || (p > 1)) {
+    return IGRAPH_NAN;
+  }
+
+  if (p == 1) {
+    return 0;
+  }
+
+  return floor(log(mxIgraph_rng_get_real(state)) / log1p(-p));
+}
+
+/* Poisson variates by inversion for small means and by Hörmann's
+ transformed rejection (PTRS) otherwise. */
+static igraph_real_t mxIgraph_rng_get_pois(void* state, igraph_real_t mu)
+{
+  if (!(mu >= 0)) {
+    return IGRAPH_NAN;
+  }
+
+  if (mu == 0) {
+    return 0;
+  }
+
+  if (mu < 10) {
+    igraph_real_t u = mxIgraph_rng_get_real(state);
+    igraph_real_t p = exp(-mu);
+    igraph_real_t k = 0;
+
+    while ((u > p) && (p > 0)) {
+      u -= p;
+      k++;
+      p *= mu / k;
+    }
+
+    return k;
+  }
+
+  igraph_real_t const log_mu = log(mu);
+  igraph_real_t const b = 0.931 + (2.53 * sqrt(mu));
+  igraph_real_t const a = -0.059 + (0.02483 * b);
+  igraph_real_t const inv_alpha = 1.1239 + (1.1328 / (b - 3.4));
+  igraph_real_t const v_r = 0.9277 - (3.6224 / (b - 2));
+
+  while (true) {
+    igraph_real_t const u = mxIgraph_rng_get_real(state) - 0.5;
+    igraph_real_t const v = mxIgraph_rng_get_real(state);
+    igraph_real_t const us = 0.5 - fabs(u);
+    igraph_real_t const k = floor((((2 * a) / us) + b) * u + mu + 0.43);
+
+    if ((us >= 0.07) && (v <= v_r)) {
+      return k;
+    }
+
+    if ((k < 0) || ((us < 0.013) && (v > us))) {
+      continue;
+    }
+
+    if ((log(v) + log(inv_alpha) - log((a / (us * us)) + b)) <=
+        (-mu + (k * log_mu) - lgamma(k + 1))) {
+      return k;
+    }
+  }
+}
+
+/* Binomial variates with p <= 0.5, by inversion for small means and by
+ Hörmann's transformed rejection (BTRS) otherwise. */
+static igraph_real_t mxIgraph_rng_binom_i(
+  void* state, igraph_integer_t n, igraph_real_t p)
+{
+  igraph_real_t const q = 1 - p;
+
+  if ((n * p) < 10) {
+    igraph_real_t const s = p / q;
+    igraph_real_t const a = (n + 1) * s;
+    igraph_real_t r = pow(q, (igraph_real_t)n);
+    igraph_real_t u = mxIgraph_rng_get_real(state);
+    igraph_integer_t k = 0;
+
+    while ((u > r) && (k < n)) {
+      u -= r;
+      k++;
+      r *= (a / k) - s;
+    }
+
+    return k;
+  }
+
+  igraph_real_t const spq = sqrt(n * p * q);
+  igraph_real_t const b = 1.15 + (2.53 * spq);
+  igraph_real_t const a = -0.0873 + (0.0248 * b) + (0.01 * p);
+  igraph_real_t const c = (n * p) + 0.5;
+  igraph_real_t const v_r = 0.92 - (4.2 / b);
+  igraph_real_t const alpha = (2.83 + (5.1 / b)) * spq;
+  igraph_real_t const log_pq = log(p / q);
+  igraph_real_t const m = floor((n + 1) * p);
+  igraph_real_t const h = lgamma(m + 1) + lgamma(n - m + 1);
+
+  while (true) {
+    igraph_real_t const u = mxIgraph_rng_get_real(state) - 0.5;
+    igraph_real_t v = mxIgraph_rng_get_real(state);
+    igraph_real_t const us = 0.5 - fabs(u);
+    igraph_real_t const k = floor((((2 * a) / us) + b) * u + c);
+
+    if ((k < 0) || (k > n)) {
+      continue;
+    }
+
+    if ((us >= 0.07) && (v <= v_r)) {
+      return k;
+    }
+
+    v = log(v * alpha / ((a / (us * us)) + b));
+    if (v <= (h - lgamma(k + 1) - lgamma(n - k + 1) + ((k - m) * log_pq))) {
+      return k;
+    }
+  }
+}
+
+static igraph_real_t mxIgraph_rng_get_binom(
+  void* state, igraph_integer_t n, igraph_real_t p)
+{
+  if ((n < 0) || !(p >= 0) || (p > 1)) {
+    return IGRAPH_NAN;
+  }
+
+  if ((n == 0) || (p == 0)) {
+    return 0;
+  }
+
+  if (p == 1) {
+    return n;
+  }
+
+  return p <= 0.5 ? mxIgraph_rng_binom_i(state, n, p) :
+                    n - mxIgraph_rng_binom_i(state, n, 1 - p);
+}
+
+/* Without buffering, igraph's own samplers are used so the draws taken from
+ MATLAB's stream for a given seed stay the same as in previous releases. */
 static igraph_rng_type_t mxIgraph_rng_type = {
   /* name= */ "MATLAB",
   /* bits = */ 32,
@@ -155,11 +388,87 @@ static igraph_rng_type_t mxIgraph_rng_type = {
   /* get_pois= */ NULL,
 };
 
+static igraph_rng_type_t mxIgraph_rng_type_buffered = {
+  /* name= */ "MATLAB",
+  /* bits = */ 32,
+  /* init= */ mxIgraph_rng_init,
+  /* destroy= */ mxIgraph_rng_destroy,
+  /* seed= */ mxIgraph_rng_seed,
+  /* get= */ mxIgraph_rng_get,
+  /* get_int= */ mxIgraph_rng_get_integer,
+  /* get_real= */ mxIgraph_rng_get_real,
+  /* get_norm= */ mxIgraph_rng_get_normal,
+  /* get_geom= */ mxIgraph_rng_get_geom,
+  /* get_binom= */ mxIgraph_rng_get_binom,
+  /* get_exp= */ mxIgraph_rng_get_exp,
+  /* get_gamma= */ NULL,
+  /* get_pois= */ mxIgraph_rng_get_pois,
+};
+
+/* Drop any buffered draws so the next draw comes from MATLAB's stream. */
+void mxIgraphRNGBufferInvalidate(void)
+{
+  mxIgraph_rng_uniform.pos = mxIgraph_rng_buffer_size;
+  mxIgraph_rng_normal.pos = mxIgraph_rng_buffer_size;
+}
+
+igraph_integer_t mxIgraphRNGBufferSize(void)
+{
+  return mxIgraph_rng_buffer_size;
+}
+
+static igraph_rng_type_t const* rng_type_i(void)
+{
+  return mxIgraph_rng_buffer_size > 0 ? &mxIgraph_rng_type_buffered :
+                                        &mxIgraph_rng_type;
+}
+
+static igraph_error_t rng_buffer_resize_i(
+  mxIgraph_rng_buffer_t* buffer, igraph_integer_t const size)
+{
+  if (size == 0) {
+    IGRAPH_FREE(buffer->draws);
+  } else {
+    double* draws = IGRAPH_REALLOC(buffer->draws, size, double);
+    IGRAPH_CHECK_OOM(draws, "Could not allocate RNG buffer.");
+    buffer->draws = draws;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Set the number of draws taken from MATLAB's RNG at once. A size of 0 turns
+ buffering off. */
+igraph_error_t mxIgraphSetRNGBufferSize(igraph_integer_t const size)
+{
+  if (size < 0) {
+    IGRAPH_ERROR("RNG buffer size must be non-negative.", IGRAPH_EINVAL);
+  }
+
+  /* Keep the old size if either allocation fails so the buffers are never
+     shorter than the size. */
+  if ((size > mxIgraph_rng_buffer_size) || (size == 0)) {
+    IGRAPH_CHECK(rng_buffer_resize_i(&mxIgraph_rng_uniform, size));
+    IGRAPH_CHECK(rng_buffer_resize_i(&mxIgraph_rng_normal, size));
+  }
+
+  mxIgraph_rng_buffer_size = size;
+  mxIgraphRNGBufferInvalidate();
+
+  if (igraph_rng_default() == &mxIgraph_rng_instance) {
+    igraph_rng_init(&mxIgraph_rng_instance, rng_type_i());
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
 void mxIgraphSetRNG(void)
 {
+  mxIgraphRNGBufferInvalidate();
+
   /* For some reason it seems the MATLAB rng function needs to be touched if it
   hasn't been otherwise MATLAB crashes. This does not modify the RNG. */
   mexCallMATLAB(0, NULL, 0, NULL, "rng");
-  igraph_rng_init(&mxIgraph_rng_instance, &mxIgraph_rng_type);
+  igraph_rng_init(&mxIgraph_rng_instance, rng_type_i());
   igraph_rng_set_default(&mxIgraph_rng_instance);
 }
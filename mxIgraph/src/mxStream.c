@@ -0,0 +1,115 @@
+/* Copyright 2025 David R. Connell <david32@dcon.addy.io>.
+ *
+ * This file is part of matlab-igraph.
+ *
+ * matlab-igraph is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * matlab-igraph is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with matlab-igraph. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Independent random number streams for parallel tasks.
+
+ Seeding several copies of one generator with different seeds only makes
+ them start at different points of the same sequence, which can overlap.
+ PCG generators instead come in families of distinct sequences selected by
+ the odd increment added at each step, so giving every stream its own
+ increment makes streams independent by construction while one seed still
+ determines all of them.
+
+ This is PCG-XSH-RR with 64 bits of state and 32 bit output (the generator
+ behind igraph's pcg32), with 2^63 selectable streams. The 64 bit output
+ variant would need 128 bit arithmetic, which is not available on every
+ compiler MATLAB supports. */
+
+#include <mxIgraph.h>
+#include <stdint.h>
+
+typedef struct {
+  uint64_t state;
+  uint64_t inc;
+} mxIgraph_stream_state_t;
+
+static uint32_t stream_next_i(mxIgraph_stream_state_t* st)
+{
+  uint64_t const old = st->state;
+  uint32_t const xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+  uint32_t const rot = (uint32_t)(old >> 59);
+
+  st->state = (old * 6364136223846793005ULL) + st->inc;
+
+  return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+static igraph_error_t stream_init_i(void** state)
+{
+  mxIgraph_stream_state_t* st = IGRAPH_CALLOC(1, mxIgraph_stream_state_t);
+  IGRAPH_CHECK_OOM(st, "Could not allocate random number stream.");
+
+  st->inc = 1;
+  *state = st;
+
+  return IGRAPH_SUCCESS;
+}
+
+static void stream_destroy_i(void* state)
+{
+  IGRAPH_FREE(state);
+}
+
+static igraph_error_t stream_seed_i(void* state, igraph_uint_t seed)
+{
+  mxIgraph_stream_state_t* st = state;
+
+  st->state = 0;
+  stream_next_i(st);
+  st->state += seed;
+  stream_next_i(st);
+
+  return IGRAPH_SUCCESS;
+}
+
+static igraph_uint_t stream_get_i(void* state)
+{
+  return stream_next_i(state);
+}
+
+static igraph_rng_type_t const mxIgraph_rngtype_stream = {
+  /* name= */ "PCG32 stream",
+  /* bits= */ 32,
+  /* init= */ stream_init_i,
+  /* destroy= */ stream_destroy_i,
+  /* seed= */ stream_seed_i,
+  /* get= */ stream_get_i,
+  /* get_int= */ NULL,
+  /* get_real= */ NULL,
+  /* get_norm= */ NULL,
+  /* get_geom= */ NULL,
+  /* get_binom= */ NULL,
+  /* get_exp= */ NULL,
+  /* get_gamma= */ NULL,
+  /* get_pois= */ NULL,
+};
+
+/* Initialize rng as stream number stream of the family selected by seed.
+
+ Streams with the same seed and different stream numbers are independent,
+ and the same seed and stream number always give the same sequence. Only
+ the lower 63 bits of stream are used. Destroy with igraph_rng_destroy. */
+igraph_error_t mxIgraphRNGStreamInit(
+  igraph_rng_t* rng, igraph_uint_t const seed, igraph_uint_t const stream)
+{
+  IGRAPH_CHECK(igraph_rng_init(rng, &mxIgraph_rngtype_stream));
+  ((mxIgraph_stream_state_t*)rng->state)->inc =
+    ((uint64_t)stream << 1) | 1;
+
+  return igraph_rng_seed(rng, seed);
+}
@@ -23,6 +23,8 @@
 
 #include <mxIgraph.h>
 
+#include "mxNumeric.h"
+
 /* Return the length of the vector pointed to by p. */
 static igraph_integer_t mxIgraphVectorLength(mxArray const* p)
 {
@@ -38,6 +40,49 @@ static igraph_integer_t mxIgraphVectorLength(mxArray const* p)
   return n > m ? n : m;
 }
 
+/* Copy the first n elements of a real array of any numeric class to dest,
+ subtracting shift. Each class is read in its native width, elements are
+ converted to the destination type before shifting so unsigned classes can
+ not wrap. */
+#define COPY_NUMERIC_CASE(class_id, type, getter, dest_type)                  \
+  case class_id: {                                                            \
+    type const* src = getter(p);                                              \
+    for (igraph_integer_t i = 0; i < n; i++) {                                \
+      dest[i] = (dest_type)src[i] - shift;                                    \
+    }                                                                         \
+    break;                                                                    \
+  }
+
+#define COPY_REAL_CASE(class_id, type, getter)                                \
+  COPY_NUMERIC_CASE(class_id, type, getter, igraph_real_t)
+
+#define COPY_INTEGER_CASE(class_id, type, getter)                             \
+  COPY_NUMERIC_CASE(class_id, type, getter, igraph_integer_t)
+
+static void copy_real_i(mxArray const* p, igraph_real_t* dest,
+  igraph_integer_t const n, igraph_integer_t const shift)
+{
+  switch (mxGetClassID(p)) {
+    MXIGRAPH_NUMERIC_CLASSES(COPY_REAL_CASE)
+    default:
+      IGRAPH_FATAL("Received unexpected data type.");
+  }
+}
+
+static void copy_integer_i(mxArray const* p, igraph_integer_t* dest,
+  igraph_integer_t const n, igraph_integer_t const shift)
+{
+  switch (mxGetClassID(p)) {
+    MXIGRAPH_NUMERIC_CLASSES(COPY_INTEGER_CASE)
+    default:
+      IGRAPH_FATAL("Received unexpected data type.");
+  }
+}
+
+#undef COPY_INTEGER_CASE
+#undef COPY_REAL_CASE
+#undef COPY_NUMERIC_CASE
+
 /* Copy a matlab vector to an igraph real vector.
 
  The igraph vector should be uninitialized, but it's the callers responsibility
@@ -50,20 +95,17 @@ igraph_error_t mxIgraphVectorFromArray(
     return IGRAPH_SUCCESS;
   }
 
-  if (!mxIsDouble(p)) {
+  if (!mxIsNumeric(p) || mxIsComplex(p)) {
     IGRAPH_ERROR("Expected a numeric vector.", IGRAPH_EINVAL);
   }
 
   igraph_integer_t const n = mxIgraphVectorLength(p);
   MXIGRAPH_CHECK_STATUS();
 
-  mxDouble* const x_mat = mxGetDoubles(p);
   igraph_integer_t const shift = shift_start ? 1 : 0;
 
   IGRAPH_CHECK(igraph_vector_init(vec, n));
-  for (igraph_integer_t i = 0; i < n; i++) {
-    VECTOR(*vec)[i] = x_mat[i] - shift;
-  }
+  copy_real_i(p, VECTOR(*vec), n, shift);
 
   return IGRAPH_SUCCESS;
 }
@@ -96,20 +138,17 @@ igraph_error_t mxIgraphVectorIntFromArray(
     return IGRAPH_SUCCESS;
   }
 
-  if (!mxIsDouble(p)) {
+  if (!mxIsNumeric(p) || mxIsComplex(p)) {
     IGRAPH_ERROR("Expected a numeric vector.", IGRAPH_EINVAL);
   }
 
   igraph_integer_t const n = mxIgraphVectorLength(p);
   MXIGRAPH_CHECK_STATUS();
 
-  mxDouble* x_mat = mxGetDoubles(p);
   igraph_integer_t const shift = shift_start ? 1 : 0;
 
   IGRAPH_CHECK(igraph_vector_int_init(vec, n));
-  for (igraph_integer_t i = 0; i < n; i++) {
-    VECTOR(*vec)[i] = x_mat[i] - shift;
-  }
+  copy_integer_i(p, VECTOR(*vec), n, shift);
 
   return IGRAPH_SUCCESS;
 }
@@ -188,21 +227,17 @@ igraph_error_t mxIgraphMatrixFromArray(
     return IGRAPH_SUCCESS;
   }
 
-  if (!mxIsDouble(p)) {
+  if (!mxIsNumeric(p) || mxIsComplex(p)) {
     IGRAPH_ERROR("Expected a numeric matrix.", IGRAPH_EINVAL);
   }
 
-  mxDouble* x_mat = mxGetDoubles(p);
   igraph_integer_t const m = mxGetM(p);
   igraph_integer_t const n = mxGetN(p);
   igraph_integer_t const shift = shift_start ? 1 : 0;
 
+  /* Both MATLAB and igraph matrices are column major. */
   IGRAPH_CHECK(igraph_matrix_init(mat, m, n));
-  for (igraph_integer_t i = 0; i < m; i++) {
-    for (igraph_integer_t j = 0; j < n; j++) {
-      MATRIX(*mat, i, j) = x_mat[i + (j * m)] - shift;
-    }
-  }
+  copy_real_i(p, VECTOR(mat->data), m * n, shift);
 
   return IGRAPH_SUCCESS;
 }
@@ -238,21 +273,16 @@ igraph_error_t mxIgraphMatrixIntFromArray(
     return IGRAPH_SUCCESS;
   }
 
-  if (!mxIsDouble(p)) {
+  if (!mxIsNumeric(p) || mxIsComplex(p)) {
     IGRAPH_ERROR("Expceted a numeric matrix.", IGRAPH_EINVAL);
   }
 
-  mxDouble* x_mat = mxGetDoubles(p);
   igraph_integer_t const m = mxGetM(p);
   igraph_integer_t const n = mxGetN(p);
   igraph_integer_t const shift = shift_start ? 1 : 0;
 
   IGRAPH_CHECK(igraph_matrix_int_init(mat, m, n));
-  for (igraph_integer_t i = 0; i < m; i++) {
-    for (igraph_integer_t j = 0; j < n; j++) {
-      MATRIX(*mat, i, j) = x_mat[i + (j * m)] - shift;
-    }
-  }
+  copy_integer_i(p, VECTOR(mat->data), m * n, shift);
 
   return IGRAPH_SUCCESS;
 }
@@ -13,6 +13,11 @@ classdef TestMxGraph < matlab.unittest.TestCase
 
     methods (TestClassSetup)
         function unWeightedSetup(testCase, n, dtype, repr)
+            testCase.assumeTrue(~strcmp(repr, 'sparse') || ...
+                                ismember(dtype, {'double', 'logical'}), ...
+                                "MATLAB sparse matrices are only double " + ...
+                                "or logical.");
+
             if strcmp(repr, 'graph')
                 % Prevents the Weight attribute from being added to edge table.
                 dtype = 'logical';
@@ -22,6 +27,8 @@ classdef TestMxGraph < matlab.unittest.TestCase
 
             if strcmp(repr, 'graph')
                 testCase.adj = digraph(testCase.adj);
+            elseif strcmp(repr, 'edgelist')
+                testCase.adj = adj2edgelist(testCase.adj, false);
             end
         end
 
@@ -31,6 +38,9 @@ classdef TestMxGraph < matlab.unittest.TestCase
 
             if strcmp(repr, 'graph')
                 testCase.weightedAdj = digraph(testCase.weightedAdj);
+            elseif strcmp(repr, 'edgelist')
+                testCase.weightedAdj = adj2edgelist(testCase.weightedAdj, ...
+                                                    true);
             end
         end
     end
@@ -59,5 +69,138 @@ classdef TestMxGraph < matlab.unittest.TestCase
                                       testCase.graphOpts);
             testCase.verifyEqual(actual, testCase.weightedAdj)
         end
+
+        function testReadGraphWithExtraAttributes(testCase, repr)
+            testCase.assumeEqual(repr, 'graph');
+
+            g = testCase.weightedAdj;
+            g.Edges.Capacity = 2 * g.Edges.Weight;
+            g.Edges.Label = string(1:numedges(g))';
+            g.Nodes.Name = compose("n%d", 1:numnodes(g))';
+
+            testCase.graphOpts.repr = 'full';
+            testCase.graphOpts.dtype = 'double';
+            testCase.graphOpts.isdirected = true;
+            testCase.graphOpts.isweighted = true;
+            testCase.graphOpts.weight = 'Capacity';
+
+            actual = testReproduceAdj(g, testCase.graphOpts);
+            expected = full(adjacency(g, g.Edges.Capacity));
+            testCase.verifyEqual(actual, expected)
+        end
+
+        function testGraphWeightsMatchEdgeTable(testCase, repr)
+            testCase.assumeEqual(repr, 'graph');
+
+            g = graph([1, 1, 2, 3], [2, 3, 3, 3], [0.5, 0, 2, 4]);
+            dg = digraph([1, 2, 2, 3], [2, 1, 3, 3], [1.5, -1, 2, 4]);
+            multi = graph([1, 1, 2], [2, 2, 3], [1, 2, 3]);
+            for G = {g, dg, multi}
+                [s, t, ~, weights] = igutils.graph2edges(G{1}, 'Weight');
+                [expectedS, expectedT] = findedge(G{1});
+
+                testCase.verifyEqual(s, expectedS);
+                testCase.verifyEqual(t, expectedT);
+                testCase.verifyEqual(weights, G{1}.Edges.Weight);
+            end
+        end
+
+        function testReadIntegerEdgeList(testCase)
+            expected = sparse([1 2 3 1], [2 3 1 4], [1 2 3 4], 5, 5);
+            for cls = {'double', 'int32', 'uint32', 'int64'}
+                edgeList.EndNodes = cast([1 2; 2 3; 3 1; 1 4], cls{1});
+                edgeList.NumNodes = 5;
+                edgeList.Cost = [1; 2; 3; 4];
+
+                testCase.graphOpts.repr = 'sparse';
+                testCase.graphOpts.dtype = 'double';
+                testCase.graphOpts.isdirected = true;
+                testCase.graphOpts.isweighted = true;
+                testCase.graphOpts.weight = 'Cost';
+
+                actual = testReproduceAdj(edgeList, testCase.graphOpts);
+                testCase.verifyEqual(actual, expected)
+            end
+        end
+
+        function testEdgeListNodeCount(testCase)
+            edgeList.EndNodes = int32([1 2; 2 3]);
+
+            testCase.graphOpts.repr = 'edgelist';
+            testCase.graphOpts.dtype = 'double';
+            testCase.graphOpts.isdirected = true;
+            testCase.graphOpts.isweighted = false;
+
+            actual = testReproduceAdj(edgeList, testCase.graphOpts);
+            testCase.verifyEqual(actual.NumNodes, 3)
+            testCase.verifyEqual(actual.EndNodes, [1 2; 2 3])
+        end
+
+        function testReadAndCreateNativeTypes(testCase)
+            adj = randi(5, 20) .* (rand(20) > 0.7);
+            edgeList = adj2edgelist(adj, true);
+
+            testCase.graphOpts.repr = 'full';
+            testCase.graphOpts.isdirected = true;
+            testCase.graphOpts.isweighted = true;
+            testCase.graphOpts.weight = 'Weight';
+            for dtype = setdiff(igutils.datatypes(), {'logical'})
+                testCase.graphOpts.dtype = dtype{1};
+                expected = cast(adj, dtype{1});
+
+                actual = testReproduceAdj(expected, testCase.graphOpts);
+                testCase.verifyEqual(actual, expected)
+
+                edgeList.Weight = cast(edgeList.Weight, dtype{1});
+                actual = testReproduceAdj(edgeList, testCase.graphOpts);
+                testCase.verifyEqual(actual, expected)
+            end
+        end
+
+        function testIntegerOutputSaturates(testCase)
+            g = digraph([1 1], [2 2], [200 100], 2);
+
+            testCase.graphOpts.repr = 'full';
+            testCase.graphOpts.dtype = 'int8';
+            testCase.graphOpts.isdirected = true;
+            testCase.graphOpts.isweighted = true;
+            testCase.graphOpts.weight = 'Weight';
+
+            actual = testReproduceAdj(g, testCase.graphOpts);
+            testCase.verifyEqual(actual, int8([0 127; 0 0]))
+        end
+
+        function testParallelEdgesAreSummed(testCase)
+            g = digraph([1 1 2 3], [2 2 3 1], [1 2 3 4], 3);
+
+            testCase.graphOpts.repr = 'sparse';
+            testCase.graphOpts.dtype = 'double';
+            testCase.graphOpts.isdirected = true;
+            testCase.graphOpts.isweighted = true;
+            testCase.graphOpts.weight = 'Weight';
+
+            actual = testReproduceAdj(g, testCase.graphOpts);
+            expected = sparse([1 2 3], [2 3 1], [3 3 4], 3, 3);
+            testCase.verifyEqual(actual, expected)
+        end
+
+        function testSymmetricOutput(testCase)
+            g = graph([1 2 2], [2 3 2], [1 2 3], 3);
+            expected = adjacency(g, g.Edges.Weight);
+
+            testCase.graphOpts.dtype = 'double';
+            testCase.graphOpts.isdirected = false;
+            testCase.graphOpts.isweighted = true;
+            testCase.graphOpts.weight = 'Weight';
+            testCase.graphOpts.symmetric = true;
+
+            testCase.graphOpts.repr = 'sparse';
+            actual = testReproduceAdj(g, testCase.graphOpts);
+            testCase.verifyEqual(actual, expected)
+
+            testCase.graphOpts.repr = 'full';
+            actual = testReproduceAdj(g, testCase.graphOpts);
+            testCase.verifyEqual(actual, full(expected))
+        end
     end
 end
@@ -99,6 +99,94 @@ classdef TestMxPredicate < matlab.unittest.TestCase
 
             actual = testIsSymmetric(tril(testCase.adj));
             testCase.verifyFalse(actual);
+
+            actual = testIsSymmetric(testCase.weightedAdj);
+            testCase.verifyTrue(actual);
+
+            [row, col] = find(tril(testCase.weightedAdj, -1), 1);
+            asymmetric = testCase.weightedAdj;
+            asymmetric(row, col) = asymmetric(row, col) + 1;
+            actual = testIsSymmetric(asymmetric);
+            testCase.verifyFalse(actual);
+        end
+
+        function testParallelSymmetryMatchesSerial(testCase)
+            % Dense enough that every thread gets a block of columns.
+            adj = sprand(500, 500, 0.05);
+            adj = adj + adj';
+            [row, col] = find(tril(adj, -1), 1, 'last');
+            asymmetric = adj;
+            asymmetric(row, col) = asymmetric(row, col) + 1;
+            moved = adj;
+            moved(row, col) = 0;
+            moved(mod(row, 500) + 1, col) = 1;
+
+            mats = {adj, logical(adj), triu(adj), asymmetric, moved, ...
+                    sparse(500, 500)};
+            for i = 1:length(mats)
+                for nThreads = [2, 4, 7]
+                    testCase.verifyEqual( ...
+                        testIsSymmetricParallel(mats{i}, nThreads), ...
+                        testIsSymmetric(mats{i}));
+                end
+            end
+        end
+
+        function testParallelSymmetryWithFewEntriesPerColumn(testCase)
+            % About 4 entries per column, so the workspace is sized for 4
+            % threads while 16 are requested and there are 16 blocks.
+            adj = sprand(2000, 2000, 0.001);
+            adj = adj + adj';
+            asymmetric = adj;
+            [row, col] = find(tril(adj, -1), 1, 'last');
+            asymmetric(row, col) = asymmetric(row, col) + 1;
+
+            for mat = {adj, asymmetric}
+                testCase.verifyEqual(testIsSymmetricParallel(mat{1}, 16), ...
+                                     testIsSymmetric(mat{1}));
+            end
+        end
+
+        function testPredicatesOnNativeTypes(testCase, repr)
+            testCase.assumeEqual(repr, 'full');
+
+            weighted = round(10 * testCase.weightedAdj);
+            for dtype = {'single', 'int8', 'uint16', 'int32', 'uint64'}
+                adj = cast(testCase.adj, dtype{1});
+                testCase.verifyTrue(testIsSymmetric(adj));
+                testCase.verifyFalse(testIsSymmetric(triu(adj)));
+                testCase.verifyTrue(testIsTriU(triu(adj)));
+                testCase.verifyTrue(testIsTriL(tril(adj)));
+                testCase.verifyFalse(testIsWeighted(adj));
+
+                adj = cast(weighted, dtype{1});
+                testCase.verifyTrue(testIsSymmetric(adj));
+                testCase.verifyTrue(testIsWeighted(adj));
+                testCase.verifyEqual(testProfile(adj).nnz, nnz(adj));
+            end
+        end
+
+        function testProfileMatchesPredicates(testCase)
+            mats = {testCase.adj, triu(testCase.adj), tril(testCase.adj), ...
+                    testCase.weightedAdj, triu(testCase.weightedAdj), ...
+                    [testCase.adj testCase.adj]};
+            for i = 1:length(mats)
+                profile = testProfile(mats{i});
+                testCase.verifyEqual(profile.isSquare, testIsSquare(mats{i}));
+                testCase.verifyEqual(profile.isWeighted, ...
+                                     testIsWeighted(mats{i}));
+                testCase.verifyEqual(profile.nnz, nnz(mats{i}));
+                testCase.verifyEqual(profile.nLoops, nnz(diag(mats{i})));
+
+                if ~profile.isSquare
+                    continue
+                end
+
+                testCase.verifyEqual(profile.isTriU, testIsTriU(mats{i}));
+                testCase.verifyEqual(profile.isTriL, testIsTriL(mats{i}));
+                testCase.verifyEqual(profile.isSymmetric, ...
+                                     testIsSymmetric(mats{i}));
+            end
         end
     end
 end
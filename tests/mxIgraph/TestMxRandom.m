@@ -24,5 +24,36 @@ classdef TestMxRandom < matlab.unittest.TestCase
             testCase.verifyEqual(actual1, expected1)
             testCase.verifyEqual(actual2, expected2)
         end
+
+        function testStreamMatchesPCGReference(testCase)
+            % First outputs of pcg32 seeded with initstate 42 and initseq 54
+            % from the PCG reference implementation.
+            expected = [0xa15c02b7 0x7b47f409 0xba1d3330 0x83d2f293 ...
+                        0xbfa4784b 0xcbed606e];
+
+            testCase.verifyEqual(testRNGStream(42, 54, 6), double(expected));
+        end
+
+        function testStreamsDiffer(testCase, seed)
+            a = testRNGStream(seed, 0, 100);
+            b = testRNGStream(seed, 1, 100);
+
+            testCase.verifyNotEqual(a, b);
+            testCase.verifyEqual(testRNGStream(seed, 0, 100), a);
+        end
+
+        function testBatchIndependentOfThreadCount(testCase, seed)
+            rng(seed);
+            expected = testBatchRNG(16, 10, 1);
+
+            for nThreads = [2, 3, 8]
+                rng(seed);
+                testCase.verifyEqual(testBatchRNG(16, 10, nThreads), ...
+                                     expected, ...
+                                     sprintf("%d threads", nThreads));
+            end
+
+            testCase.verifyEqual(size(unique(expected', 'rows'), 1), 16);
+        end
     end
 end
@@ -0,0 +1,41 @@
+#include <mxIgraph.h>
+
+typedef struct {
+  double* draws;
+  igraph_integer_t n_draws;
+} draws_t;
+
+static igraph_error_t draw_task_i(
+  igraph_integer_t task, igraph_integer_t thread, void* data)
+{
+  draws_t* draws = data;
+  double* column = draws->draws + (task * draws->n_draws);
+  igraph_rng_t* rng = igraph_rng_default();
+
+  IGRAPH_UNUSED(thread);
+
+  for (igraph_integer_t i = 0; i < draws->n_draws; i++) {
+    column[i] = igraph_rng_get_integer(rng, 0, 0xFFFFFFFF);
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/* Draw nDraws integers in each of nTasks batch tasks using nThreads threads.
+ Column j holds the draws of task j. */
+void mexFunction(int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  igraph_integer_t const n_tasks = mxGetScalar(prhs[0]);
+  igraph_integer_t const n_threads = mxIgraphThreadCount();
+  igraph_integer_t failed;
+  draws_t draws = { .n_draws = mxGetScalar(prhs[1]) };
+
+  mxIgraphSetRNG();
+
+  plhs[0] = mxCreateDoubleMatrix(draws.n_draws, n_tasks, mxREAL);
+  draws.draws = mxGetDoubles(plhs[0]);
+
+  mxIgraphSetThreadCount((igraph_integer_t)mxGetScalar(prhs[2]));
+  mxIgraphBatchRun(n_tasks, draw_task_i, &draws, &failed);
+  mxIgraphSetThreadCount(n_threads);
+}
@@ -0,0 +1,18 @@
+#include "igraph.h"
+
+#include <mxIgraph.h>
+
+void mexFunction(int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  igraph_integer_t const n_threads = mxIgraphThreadCount();
+
+  mxIgraphSetParallelSymmetryThreshold(0);
+  mxIgraphSetThreadCount((igraph_integer_t)mxGetScalar(prhs[1]));
+
+  igraph_bool_t flag = mxIgraphIsSymmetric(prhs[0]);
+
+  mxIgraphSetThreadCount(n_threads);
+  mxIgraphSetParallelSymmetryThreshold(-1);
+
+  plhs[0] = mxCreateLogicalScalar(flag);
+}
@@ -0,0 +1,28 @@
+#include "igraph.h"
+
+#include <mxIgraph.h>
+
+void mexFunction(int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  mxIgraphProfile_t profile;
+  char const* fields[] = { "isSquare", "isTriU", "isTriL", "isSymmetric",
+    "isWeighted", "nnz", "nLoops", "minWeight", "maxWeight" };
+  mwSize const n_fields = sizeof(fields) / sizeof(fields[0]);
+
+  mxIgraphProfile(prhs[0], &profile);
+
+  plhs[0] = mxCreateStructMatrix(1, 1, n_fields, fields);
+  mxSetField(plhs[0], 0, "isSquare", mxCreateLogicalScalar(profile.is_square));
+  mxSetField(plhs[0], 0, "isTriU", mxCreateLogicalScalar(profile.is_triu));
+  mxSetField(plhs[0], 0, "isTriL", mxCreateLogicalScalar(profile.is_tril));
+  mxSetField(
+    plhs[0], 0, "isSymmetric", mxCreateLogicalScalar(profile.is_symmetric));
+  mxSetField(
+    plhs[0], 0, "isWeighted", mxCreateLogicalScalar(profile.is_weighted));
+  mxSetField(plhs[0], 0, "nnz", mxCreateDoubleScalar(profile.nnz));
+  mxSetField(plhs[0], 0, "nLoops", mxCreateDoubleScalar(profile.n_loops));
+  mxSetField(
+    plhs[0], 0, "minWeight", mxCreateDoubleScalar(profile.min_weight));
+  mxSetField(
+    plhs[0], 0, "maxWeight", mxCreateDoubleScalar(profile.max_weight));
+}
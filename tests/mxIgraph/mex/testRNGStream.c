@@ -0,0 +1,21 @@
+#include <mxIgraph.h>
+
+/* Return the first n raw outputs of stream number stream seeded by seed. */
+void mexFunction(int nlhs, mxArray* plhs[], int nrhs, mxArray const* prhs[])
+{
+  igraph_uint_t const seed = mxGetScalar(prhs[0]);
+  igraph_uint_t const stream = mxGetScalar(prhs[1]);
+  igraph_integer_t const n = mxGetScalar(prhs[2]);
+  igraph_rng_t rng;
+  double* out;
+
+  mxIgraphRNGStreamInit(&rng, seed, stream);
+
+  plhs[0] = mxCreateDoubleMatrix(1, n, mxREAL);
+  out = mxGetDoubles(plhs[0]);
+  for (igraph_integer_t i = 0; i < n; i++) {
+    out[i] = rng.type->get(rng.state);
+  }
+
+  igraph_rng_destroy(&rng);
+}
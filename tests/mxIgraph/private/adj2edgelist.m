@@ -0,0 +1,7 @@
+function edgeList = adj2edgelist(adj, isweighted)
+    [s, t, w] = find(adj);
+    edgeList = struct('EndNodes', [s t], 'NumNodes', size(adj, 1));
+    if isweighted
+        edgeList.Weight = double(w);
+    end
+end
@@ -0,0 +1,102 @@
+classdef TestBatch < matlab.unittest.TestCase
+    properties
+        graphs;
+    end
+
+    methods (TestClassSetup)
+        function setupGraphs(testCase)
+            nNodes = [20 35 50];
+            testCase.graphs = cell(1, length(nNodes));
+            for i = 1:length(nNodes)
+                adj = triu(sprand(nNodes(i), nNodes(i), 0.2) > 0, 1);
+                testCase.graphs{i} = double(adj | adj');
+            end
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testClusterMatchesSingleCalls(testCase)
+            actual = igraph.cluster(testCase.graphs, 'fastgreedy');
+
+            testCase.verifySize(actual, size(testCase.graphs));
+            for i = 1:length(testCase.graphs)
+                expected = igraph.cluster(testCase.graphs{i}, 'fastgreedy');
+                testCase.verifyEqual(actual{i}, expected);
+            end
+        end
+
+        function testCentralityMatchesSingleCalls(testCase)
+            actual = igraph.centrality(testCase.graphs, 'betweenness');
+
+            for i = 1:length(testCase.graphs)
+                expected = igraph.centrality(testCase.graphs{i}, ...
+                                             'betweenness');
+                testCase.verifyEqual(actual{i}, expected);
+            end
+        end
+
+        function testStochasticMethodsAreReproducible(testCase)
+            igraph.rng(1);
+            expected = igraph.cluster(testCase.graphs, 'leiden', ...
+                                      'metric', 'modularity');
+
+            igraph.rng(1);
+            actual = igraph.cluster(testCase.graphs, 'leiden', ...
+                                    'metric', 'modularity');
+
+            testCase.verifyEqual(actual, expected);
+        end
+
+        function testGraphDependentDefaults(testCase)
+            actual = igraph.cluster(testCase.graphs, 'labelpropagation');
+
+            for i = 1:length(testCase.graphs)
+                testCase.verifyLength(actual{i}, ...
+                                      size(testCase.graphs{i}, 1));
+            end
+        end
+
+        function testTaskErrorsKeepTheirMessage(testCase)
+            % Spinglass can not cluster disconnected graphs.
+            disconnected = blkdiag(testCase.graphs{1}, testCase.graphs{2});
+            singleErr = [];
+            try
+                igraph.cluster(disconnected, 'spinglass');
+            catch singleErr
+            end
+            testCase.assumeNotEmpty(singleErr, ...
+                                    "Spinglass accepted a disconnected " + ...
+                                    "graph.");
+            reason = strtrim(extractAfter(singleErr.message, ...
+                                          newline + "    "));
+
+            batchErr = [];
+            try
+                igraph.cluster({testCase.graphs{1}, disconnected}, ...
+                               'spinglass');
+            catch batchErr
+            end
+            testCase.assertNotEmpty(batchErr);
+            testCase.verifySubstring(batchErr.message, "graph 2");
+            testCase.verifySubstring(batchErr.message, reason);
+        end
+
+        function testTaskWarningsAreReported(testCase)
+            disconnected = blkdiag(testCase.graphs{1}, testCase.graphs{2});
+
+            lastwarn('');
+            igraph.centrality(disconnected, 'closeness');
+            single = lastwarn();
+            testCase.assumeNotEmpty(single, ...
+                                    "Closeness did not warn on a " + ...
+                                    "disconnected graph.");
+
+            lastwarn('');
+            igraph.centrality({testCase.graphs{1}, disconnected}, ...
+                              'closeness');
+            reason = strtrim(extractBefore(single, newline));
+            testCase.verifySubstring(lastwarn(), reason);
+            testCase.verifySubstring(lastwarn(), "1 of 2 tasks");
+        end
+    end
+end
@@ -0,0 +1,55 @@
+classdef TestCache < matlab.unittest.TestCase
+    properties
+        adj;
+        membership;
+    end
+
+    methods (TestClassSetup)
+        function setupGraph(testCase)
+            adj = triu(sprand(50, 50, 0.2) > 0, 1);
+            testCase.adj = double(adj | adj');
+            testCase.membership = randi(4, [1 50]);
+        end
+    end
+
+    methods (TestMethodSetup)
+        function clearCache(testCase)
+            igraph.cache("clear");
+            testCase.addTeardown(@() igraph.cache("capacity", 4));
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testRepeatedCallsHitCache(testCase)
+            igraph.modularity(testCase.adj, testCase.membership);
+            igraph.modularity(testCase.adj, testCase.membership);
+            info = igraph.cache();
+
+            testCase.verifyEqual(info.misses, 1);
+            testCase.verifyEqual(info.hits, 1);
+        end
+
+        function testModifiedGraphIsReconverted(testCase)
+            g = testCase.adj;
+            before = igraph.modularity(g, testCase.membership);
+            g(1, 2) = ~g(1, 2);
+            g(2, 1) = g(1, 2);
+            actual = igraph.modularity(g, testCase.membership);
+
+            igraph.cache("capacity", 0);
+            expected = igraph.modularity(g, testCase.membership);
+
+            testCase.verifyNotEqual(actual, before);
+            testCase.verifyEqual(actual, expected);
+        end
+
+        function testCapacityIsRespected(testCase)
+            igraph.cache("capacity", 1);
+            igraph.modularity(testCase.adj, testCase.membership);
+            igraph.modularity(full(testCase.adj), testCase.membership);
+            info = igraph.cache();
+
+            testCase.verifyEqual(info.entries, 1);
+        end
+    end
+end
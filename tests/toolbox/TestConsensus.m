@@ -0,0 +1,79 @@
+classdef TestConsensus < matlab.unittest.TestCase
+    properties
+        adj;
+        memberships;
+    end
+
+    methods (TestClassSetup)
+        function setupPartitions(testCase)
+            testCase.adj = plantedPartition(15, 0.6);
+            testCase.memberships = igraph.cluster(testCase.adj, 'leiden', ...
+                                                  'metric', 'modularity', ...
+                                                  'nStarts', 10, ...
+                                                  'returnAll', true);
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testMatchesDense(testCase)
+            actual = igraph.consensus(testCase.memberships);
+
+            expected = zeros(size(testCase.memberships, 2));
+            for p = 1:size(testCase.memberships, 1)
+                memb = testCase.memberships(p, :);
+                expected = expected + (memb' == memb);
+            end
+            expected = expected ./ size(testCase.memberships, 1);
+            expected(logical(eye(size(expected)))) = 0;
+
+            testCase.verifyTrue(issparse(actual));
+            testCase.verifyEqual(full(actual), expected, 'AbsTol', 1e-12);
+        end
+
+        function testRestrictedToEdges(testCase)
+            actual = igraph.consensus(testCase.memberships, testCase.adj);
+            allPairs = igraph.consensus(testCase.memberships);
+
+            testCase.verifyEqual(actual, allPairs .* (testCase.adj ~= 0), ...
+                                 'AbsTol', 1e-12);
+        end
+
+        function testThreshold(testCase)
+            actual = igraph.consensus(testCase.memberships, ...
+                                      'threshold', 0.5);
+            allPairs = igraph.consensus(testCase.memberships);
+
+            testCase.verifyEqual(actual, allPairs .* (allPairs >= 0.5), ...
+                                 'AbsTol', 1e-12);
+        end
+
+        function testIdenticalPartitions(testCase)
+            memb = repmat([1 1 2 2 3], 4, 1);
+            actual = igraph.consensus(memb);
+
+            testCase.verifyEqual(full(actual), ...
+                                 double(memb(1, :)' == memb(1, :)) - ...
+                                 eye(5));
+        end
+
+        function testIterationReachesConsensus(testCase)
+            igraph.rng(3);
+            [consensus, membership] = ...
+                igraph.consensus(testCase.memberships, testCase.adj, ...
+                                 'method', 'leiden', 'metric', ...
+                                 'modularity', 'threshold', 0.2);
+
+            testCase.verifyLength(membership, size(testCase.adj, 1));
+            testCase.verifyTrue(all(nonzeros(consensus) == 1));
+        end
+
+        function testMembershipNeedsMethod(testCase)
+            testCase.verifyError(@() callWithTwoOutputs(testCase.memberships), ...
+                                 "igraph:invalidOption");
+        end
+    end
+end
+
+function callWithTwoOutputs(memberships)
+    [~, ~] = igraph.consensus(memberships);
+end
@@ -0,0 +1,63 @@
+classdef TestDispatch < matlab.unittest.TestCase
+    properties
+        dispatcher;
+    end
+
+    methods (TestClassSetup)
+        function getDispatcher(testCase)
+            % The dispatcher is private to the igraph package.
+            packageDir = fileparts(which("igraph.reindexMembership"));
+            oldDir = cd(fullfile(packageDir, "private"));
+            testCase.dispatcher = @mexIgraphDispatcher;
+            cd(oldDir);
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testNameAndOpcodeAgree(testCase)
+            memb = [3; 3; 1; 2; 1];
+            opcode = testCase.dispatcher("opcode", "reindexMembership");
+
+            testCase.verifyEqual(testCase.dispatcher(opcode, memb), ...
+                                 testCase.dispatcher("reindexMembership", ...
+                                                     memb));
+        end
+
+        function testOpcodeRejectsUnknownName(testCase)
+            testCase.verifyError(@() testCase.dispatcher("opcode", ...
+                                                         "notAFunction"), ...
+                                 "igraph:invalidValue");
+        end
+
+        function testUnknownOpcodeErrors(testCase)
+            opcode = testCase.dispatcher("opcode", "reindexMembership");
+
+            testCase.verifyError(@() testCase.dispatcher(opcode + 1, 1), ...
+                                 "igraph:internal");
+            testCase.verifyError(@() testCase.dispatcher(-1, 1), ...
+                                 "igraph:internal");
+            testCase.verifyError(@() testCase.dispatcher(0.5, 1), ...
+                                 "igraph:internal");
+        end
+
+        function testRepeatedCallsAgree(testCase)
+            memb = [3; 3; 1; 2; 1];
+            first = igraph.reindexMembership(memb);
+            second = igraph.reindexMembership(memb);
+
+            testCase.verifyEqual(second, first);
+        end
+
+        function testTreeRootFindsRoot(testCase)
+            star = sparse([1, 1, 1], [2, 3, 4], 1, 4, 4);
+
+            testCase.verifyEqual(igraph.treeRoot(star, 'mode', 'out'), 1);
+        end
+
+        function testTreeRootOfNonTreeIsZero(testCase)
+            ring = igraph.generate('ring', 'nNodes', 5);
+
+            testCase.verifyEqual(igraph.treeRoot(ring), 0);
+        end
+    end
+end
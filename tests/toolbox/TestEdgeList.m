@@ -0,0 +1,34 @@
+classdef TestEdgeList < matlab.unittest.TestCase
+    properties (TestParameter)
+        badNumNodes = {-1, NaN, 2.5, Inf, [3, 4]};
+        reservedName = {'EndNodes', 'NumNodes'};
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testInvalidNumNodes(testCase, badNumNodes)
+            edgeList.EndNodes = [1, 2; 2, 1];
+            edgeList.NumNodes = badNumNodes;
+
+            testCase.verifyError(@() igraph.centrality(edgeList, ...
+                                                       'pagerank'), ...
+                                 "igraph:invalidValue");
+        end
+
+        function testReadReservedWeightName(testCase, reservedName)
+            edgeList.EndNodes = [1, 2; 2, 1];
+            edgeList.NumNodes = 2;
+
+            testCase.verifyError(@() igraph.layout(edgeList, 'circle', ...
+                                                   'isweighted', true, ...
+                                                   'weight', reservedName), ...
+                                 "igraph:invalidValue");
+        end
+
+        function testCreateReservedWeightName(testCase, reservedName)
+            testCase.verifyError( ...
+                @() igutils.setGraphOutProps(repr = 'edgelist', ...
+                                             weight = reservedName), ...
+                "igraph:invalidOption");
+        end
+    end
+end
@@ -0,0 +1,59 @@
+classdef TestEnsemble < matlab.unittest.TestCase
+    properties
+        adj;
+        membership;
+    end
+
+    methods (TestClassSetup)
+        function setupGraph(testCase)
+            [testCase.adj, testCase.membership] = plantedPartition();
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testObservedMatchesModularity(testCase)
+            [values, observed] = igraph.ensemble(testCase.adj, 'rewire', ...
+                                                 'modularity', ...
+                                                 'membership', ...
+                                                 testCase.membership, ...
+                                                 'nReplicates', 50);
+
+            testCase.verifySize(values, [50 1]);
+            testCase.verifyEqual(observed, ...
+                                 igraph.modularity(testCase.adj, ...
+                                                   testCase.membership), ...
+                                 'AbsTol', 1e-10);
+            testCase.verifyLessThan(mean(values), observed);
+        end
+
+        function testReproducible(testCase)
+            igraph.rng(3);
+            expected = igraph.ensemble(testCase.adj, 'erdosrenyi', ...
+                                       'transitivity', 'nReplicates', 20);
+            igraph.rng(3);
+            actual = igraph.ensemble(testCase.adj, 'erdosrenyi', ...
+                                     'transitivity', 'nReplicates', 20);
+
+            testCase.verifyEqual(actual, expected);
+        end
+
+        function testAllStatistics(testCase)
+            models = {'rewire', 'configuration', 'erdosrenyi'};
+            stats = {'transitivity', 'assortativity', 'pathlength'};
+            for i = 1:length(models)
+                for j = 1:length(stats)
+                    values = igraph.ensemble(testCase.adj, models{i}, ...
+                                             stats{j}, 'nReplicates', 5);
+                    testCase.verifySize(values, [5 1]);
+                end
+            end
+        end
+
+        function testModularityNeedsMembership(testCase)
+            testCase.verifyError(@() igraph.ensemble(testCase.adj, ...
+                                                     'rewire', ...
+                                                     'modularity'), ...
+                                 "igraph:invalidOption");
+        end
+    end
+end
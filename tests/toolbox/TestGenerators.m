@@ -29,6 +29,9 @@ classdef TestGenerators < matlab.unittest.TestCase
                       'CitedType', 'CitingCitedType', 'sbm', 'hsbm', ...
                       'DotProduct', 'TreePrufer', 'TreeLERW', ...
                       'SimpleInterconnectedIslands'};
+
+        barabasiMethod = {'BarabasiBag', 'BarabasiPsumTree', ...
+                          'BarabasiPsumTreeMultiple'};
     end
 
     methods (Test, TestTags = {'Unit', 'methods'})
@@ -46,5 +49,16 @@ classdef TestGenerators < matlab.unittest.TestCase
             actual = igraph.randgame(gameMethod);
             testCase.verifyNotEmpty(actual);
         end
+
+        function testBarabasiStartFrom(testCase, barabasiMethod)
+            start = igraph.generate('ring', 'nNodes', 5);
+            actual = igraph.randgame(barabasiMethod, 'nNodes', 20, ...
+                                     'startFrom', start);
+
+            adj = adjacency(actual);
+            testCase.verifyEqual(numnodes(actual), 20);
+            testCase.verifyEqual(full(adj(1:5, 1:5)), ...
+                                 full(adjacency(start)));
+        end
     end
 end
@@ -0,0 +1,82 @@
+classdef TestInfer < matlab.unittest.TestCase
+    properties (TestParameter)
+        flag = {true, false};
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testCentralityInfersDirected(testCase)
+            adj = sparse([1, 2, 3, 3], [2, 3, 1, 4], 1, 4, 4);
+            inferred = igraph.centrality(adj, 'pagerank');
+            explicit = igraph.centrality(adj, 'pagerank', ...
+                                         'isdirected', true);
+
+            testCase.verifyEqual(inferred, explicit);
+        end
+
+        function testExplicitFlagOverridesInference(testCase, flag)
+            adj = sparse([1, 2, 3, 3], [2, 3, 1, 4], 1, 4, 4);
+            inferred = igraph.centrality(adj, 'betweenness', ...
+                                         'isdirected', 'infer');
+            explicit = igraph.centrality(adj, 'betweenness', ...
+                                         'isdirected', flag);
+
+            testCase.verifyEqual(isequal(inferred, explicit), flag);
+        end
+
+        function testStringInfer(testCase)
+            adj = [0, 1, 1; 1, 0, 1; 1, 1, 0];
+            membership = [1, 1, 2];
+
+            testCase.verifyEqual( ...
+                igraph.modularity(adj, membership, 'isdirected', "infer"), ...
+                igraph.modularity(adj, membership, 'isdirected', false));
+        end
+
+        function testSaveResolvesInferredWeights(testCase)
+            adj = [0, 2; 2, 0];
+            filename = [tempname(), '.txt'];
+
+            testCase.verifyError( ...
+                @() igraph.save(filename, adj, 'format', 'edgelist'), ...
+                "igraph:weighted");
+        end
+
+        function testGraphInferMatchesIsWeighted(testCase)
+            kk = @(g, varargin) igraph.layout(g, 'kamadakawai', varargin{:});
+            g = graph([1, 2, 3, 3], [2, 3, 1, 4]);
+            testCase.verifyEqual(kk(g, 'isweighted', 'infer'), ...
+                                 kk(g, 'isweighted', igraph.isweighted(g)));
+
+            g.Edges.Cost = [1; 5; 2; 1];
+            inferred = kk(g, 'isweighted', 'infer');
+            testCase.verifyTrue(igraph.isweighted(g));
+            testCase.verifyEqual(inferred, ...
+                                 kk(g, 'isweighted', true, 'weight', 'Cost'));
+            testCase.verifyNotEqual(inferred, kk(g, 'isweighted', false));
+        end
+
+        function testEdgeListInferMatchesIsWeighted(testCase)
+            kk = @(g, varargin) igraph.layout(g, 'kamadakawai', varargin{:});
+            edgeList.EndNodes = [1, 2; 2, 3; 3, 1; 3, 4];
+            edgeList.NumNodes = 4;
+            testCase.verifyEqual( ...
+                kk(edgeList, 'isweighted', 'infer'), ...
+                kk(edgeList, 'isweighted', igraph.isweighted(edgeList)));
+
+            edgeList.Cost = [1; 5; 2; 1];
+            inferred = kk(edgeList, 'isweighted', 'infer');
+            testCase.verifyTrue(igraph.isweighted(edgeList));
+            testCase.verifyEqual(inferred, kk(edgeList, 'isweighted', true, ...
+                                              'weight', 'Cost'));
+            testCase.verifyNotEqual(inferred, ...
+                                    kk(edgeList, 'isweighted', false));
+        end
+
+        function testInvalidFlag(testCase)
+            testCase.verifyError( ...
+                @() igraph.centrality(eye(3), 'pagerank', ...
+                                      'isdirected', 'guess'), ...
+                "igraph:NotAFlag");
+        end
+    end
+end
@@ -0,0 +1,48 @@
+classdef TestLayout < matlab.unittest.TestCase
+    properties (TestParameter)
+        layoutMethod = {'random', 'circle', 'star', 'grid', 'graphopt', ...
+                        'fruchtermanreingold', 'kamadakawai', 'gem', ...
+                        'davidsonharel', 'lgl'};
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testLayoutSize(testCase, layoutMethod)
+            g = igraph.generate('ring', 'nNodes', 10);
+            pos = igraph.layout(g, layoutMethod);
+
+            testCase.verifySize(pos, [10, 2]);
+        end
+
+        function testStarCenter(testCase)
+            g = igraph.generate('star', 'nNodes', 5);
+            pos = igraph.layout(g, 'star', 'center', 3);
+
+            testCase.verifyEqual(pos(3, :), [0, 0], AbsTol = 1e-12);
+        end
+
+        function testLglRootIsOneBased(testCase)
+            g = igraph.generate('ring', 'nNodes', 10);
+
+            for root = [1, 10]
+                pos = igraph.layout(g, 'lgl', 'root', root);
+                testCase.verifySize(pos, [10, 2]);
+            end
+        end
+
+        function testCircleOrder(testCase)
+            g = igraph.generate('ring', 'nNodes', 4);
+            pos = igraph.layout(g, 'circle', 'order', [3, 1, 2, 4]);
+
+            testCase.verifyEqual(pos(3, :), [1, 0], AbsTol = 1e-12);
+        end
+
+        function testReingoldTilfordRoot(testCase)
+            tree = sparse([1, 1, 2], [2, 3, 4], 1, 4, 4);
+            tree = tree + tree';
+            pos = igraph.layout(tree, 'reingoldtilford', 'root', 2);
+
+            testCase.verifyEqual(pos(2, 2), 0);
+            testCase.verifyEqual(pos([1, 4], 2), [1; 1]);
+        end
+    end
+end
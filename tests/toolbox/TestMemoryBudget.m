@@ -0,0 +1,51 @@
+classdef TestMemoryBudget < matlab.unittest.TestCase
+    methods (TestMethodSetup)
+        function restoreBudget(testCase)
+            testCase.addTeardown(@() igraph.memoryBudget('default'));
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testDefaultBudgetIsPositive(testCase)
+            testCase.verifyGreaterThan(igraph.memoryBudget(), 0);
+        end
+
+        function testSetBudget(testCase)
+            igraph.memoryBudget(1e6);
+            testCase.verifyEqual(igraph.memoryBudget(), 1e6);
+        end
+
+        function testFullOverBudgetFails(testCase)
+            igraph.memoryBudget(1e5);
+            actual = @() igraph.generate('ring', 'nNodes', 1000, ...
+                                         'repr', 'full');
+
+            testCase.verifyError(actual, "igraph:outOfMemory");
+        end
+
+        function testSparseUnderBudgetSucceeds(testCase)
+            igraph.memoryBudget(1e5);
+            g = igraph.generate('ring', 'nNodes', 1000, 'repr', 'sparse');
+
+            testCase.verifyEqual(nnz(g), 1000);
+        end
+
+        function testAutoPicksSmallerRepresentation(testCase)
+            sparseGraph = igraph.generate('ring', 'nNodes', 1000, ...
+                                          'repr', 'auto');
+            denseGraph = igraph.generate('full', 'nNodes', 10, ...
+                                         'repr', 'auto');
+
+            testCase.verifyTrue(issparse(sparseGraph));
+            testCase.verifyFalse(issparse(denseGraph));
+        end
+
+        function testAutoIsFullForIntegerTypes(testCase)
+            g = igraph.generate('ring', 'nNodes', 100, 'repr', 'auto', ...
+                                'dtype', 'int8');
+
+            testCase.verifyClass(g, 'int8');
+            testCase.verifyFalse(issparse(g));
+        end
+    end
+end
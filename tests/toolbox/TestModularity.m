@@ -0,0 +1,66 @@
+classdef TestModularity < matlab.unittest.TestCase
+    properties
+        adj;
+        memberships;
+        gammas = [0.5 1 2];
+    end
+
+    methods (TestClassSetup)
+        function setupGraph(testCase)
+            [testCase.adj, planted] = plantedPartition(15, 0.6, 11);
+            testCase.memberships = [planted; ...
+                                    randi(3, [1 45]); ...
+                                    ones(1, 45)];
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testMatchesDefinition(testCase)
+            q = igraph.modularity(testCase.adj, testCase.memberships, ...
+                                  'resolution', testCase.gammas);
+
+            A = full(double(testCase.adj));
+            k = sum(A, 2);
+            twoM = sum(k);
+            expected = zeros(size(testCase.memberships, 1), ...
+                             length(testCase.gammas));
+            for p = 1:size(testCase.memberships, 1)
+                same = testCase.memberships(p, :) == ...
+                       testCase.memberships(p, :)';
+                for r = 1:length(testCase.gammas)
+                    B = A - testCase.gammas(r) * (k * k') / twoM;
+                    expected(p, r) = sum(B(same)) / twoM;
+                end
+            end
+
+            testCase.verifyEqual(q, expected, 'AbsTol', 1e-10);
+        end
+
+        function testBatchMatchesSingle(testCase)
+            q = igraph.modularity(testCase.adj, testCase.memberships);
+
+            testCase.verifySize(q, [size(testCase.memberships, 1) 1]);
+            for p = 1:size(testCase.memberships, 1)
+                testCase.verifyEqual(q(p), ...
+                                     igraph.modularity(...
+                                         testCase.adj, ...
+                                         testCase.memberships(p, :)), ...
+                                     'AbsTol', 1e-12);
+            end
+        end
+
+        function testContributionsSumToModularity(testCase)
+            [q, contributions] = igraph.modularity(...
+                testCase.adj, testCase.memberships(1, :), ...
+                'resolution', testCase.gammas);
+
+            testCase.verifySize(contributions, [3 length(testCase.gammas)]);
+            testCase.verifyEqual(sum(contributions, 1), q, 'AbsTol', 1e-12);
+
+            [~, contributions] = igraph.modularity(...
+                testCase.adj, testCase.memberships);
+            testCase.verifyClass(contributions, 'cell');
+            testCase.verifySize(contributions{3}, [1 1]);
+        end
+    end
+end
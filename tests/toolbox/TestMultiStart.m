@@ -0,0 +1,76 @@
+classdef TestMultiStart < matlab.unittest.TestCase
+    properties
+        adj;
+    end
+
+    methods (TestClassSetup)
+        function setupGraph(testCase)
+            testCase.adj = plantedPartition();
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testBestIsMaxOfAll(testCase)
+            igraph.rng(1);
+            [best, bestQuality] = igraph.cluster(testCase.adj, 'leiden', ...
+                                                 'metric', 'modularity', ...
+                                                 'nStarts', 8);
+            igraph.rng(1);
+            [runs, quality] = igraph.cluster(testCase.adj, 'leiden', ...
+                                            'metric', 'modularity', ...
+                                            'nStarts', 8, 'returnAll', true);
+
+            testCase.verifySize(runs, [8 igraph.numnodes(testCase.adj)]);
+            testCase.verifySize(quality, [8 1]);
+
+            [maxQuality, idx] = max(quality);
+            testCase.verifyEqual(bestQuality, maxQuality);
+            testCase.verifyEqual(best, runs(idx, :));
+        end
+
+        function testInfomapMinimizesCodelength(testCase)
+            igraph.rng(1);
+            [~, bestQuality] = igraph.cluster(testCase.adj, 'infomap', ...
+                                              'nStarts', 4);
+            igraph.rng(1);
+            [~, quality] = igraph.cluster(testCase.adj, 'infomap', ...
+                                          'nStarts', 4, 'returnAll', true);
+
+            testCase.verifyEqual(bestQuality, min(quality));
+        end
+
+        function testReproducible(testCase)
+            igraph.rng(7);
+            expected = igraph.cluster(testCase.adj, 'labelpropagation', ...
+                                      'nStarts', 5, 'returnAll', true);
+            igraph.rng(7);
+            actual = igraph.cluster(testCase.adj, 'labelpropagation', ...
+                                    'nStarts', 5, 'returnAll', true);
+
+            testCase.verifyEqual(actual, expected);
+        end
+
+        function testQualityIsModularity(testCase)
+            [membership, quality] = igraph.cluster(testCase.adj, ...
+                                                   'fastgreedy');
+
+            testCase.verifyEqual(quality, ...
+                                 igraph.modularity(testCase.adj, membership), ...
+                                 'AbsTol', 1e-10);
+        end
+
+        function testDeterministicMethodsFail(testCase)
+            testCase.verifyError(@() igraph.cluster(testCase.adj, ...
+                                                    'fastgreedy', ...
+                                                    'nStarts', 2), ...
+                                 "igraph:invalidOption");
+        end
+
+        function testBatchFails(testCase)
+            testCase.verifyError(@() igraph.cluster({testCase.adj}, ...
+                                                    'leiden', ...
+                                                    'nStarts', 2), ...
+                                 "igraph:invalidOption");
+        end
+    end
+end
@@ -0,0 +1,80 @@
+classdef TestPairwiseCompare < matlab.unittest.TestCase
+    properties
+        memberships;
+        others;
+        n = 60;
+        k = 5;
+    end
+
+    properties (TestParameter)
+        method = {'vi', 'nmi', 'splitjoin', 'rand', 'ari'};
+    end
+
+    methods (TestClassSetup)
+        function setupMemberships(testCase)
+            testCase.memberships = randi(testCase.k, [6 testCase.n]);
+            testCase.memberships(2, :) = testCase.memberships(1, :);
+            testCase.memberships(3, :) = 1;
+            testCase.others = randi(2 * testCase.k, [4 testCase.n]);
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testAllPairsMatchesCompare(testCase, method)
+            scores = igraph.pairwiseCompare(testCase.memberships, method);
+
+            nParts = size(testCase.memberships, 1);
+            expected = zeros(nParts);
+            for i = 1:nParts
+                for j = 1:nParts
+                    expected(i, j) = igraph.compare(...
+                        testCase.memberships(i, :), ...
+                        testCase.memberships(j, :), method);
+                end
+            end
+
+            testCase.verifyEqual(scores, expected, 'AbsTol', 1e-10);
+            testCase.verifyEqual(scores, scores');
+        end
+
+        function testOneVsManyMatchesCompare(testCase, method)
+            scores = igraph.pairwiseCompare(testCase.memberships, ...
+                                            testCase.others, method);
+
+            testCase.verifySize(scores, [size(testCase.memberships, 1), ...
+                                         size(testCase.others, 1)]);
+            for i = 1:size(testCase.memberships, 1)
+                for j = 1:size(testCase.others, 1)
+                    testCase.verifyEqual(scores(i, j), ...
+                                         igraph.compare(...
+                                             testCase.memberships(i, :), ...
+                                             testCase.others(j, :), ...
+                                             method), ...
+                                         'AbsTol', 1e-10);
+                end
+            end
+        end
+
+        function testSeveralMethods(testCase)
+            [vi, nmi] = igraph.pairwiseCompare(testCase.memberships, ...
+                                               {'vi', 'nmi'});
+
+            testCase.verifyEqual(vi, igraph.pairwiseCompare(...
+                testCase.memberships, 'vi'));
+            testCase.verifyEqual(nmi, igraph.pairwiseCompare(...
+                testCase.memberships, 'nmi'));
+        end
+
+        function testDefaultsToNmi(testCase)
+            testCase.verifyEqual(...
+                igraph.pairwiseCompare(testCase.memberships), ...
+                igraph.pairwiseCompare(testCase.memberships, 'nmi'));
+        end
+
+        function testFailsForMismatchedNodes(testCase)
+            actual = @() igraph.pairwiseCompare(testCase.memberships, ...
+                                                testCase.others(:, 2:end));
+            testCase.verifyError(actual, "igraph:notEqualLength");
+        end
+    end
+end
@@ -47,6 +47,54 @@ classdef TestRNG < matlab.unittest.TestCase
 
             testCase.verifyNotEqual(actual, expected);
         end
+
+        function reproduceWithBufferedMatlabRng(testCase)
+            previous = igraph.rngBuffer();
+            testCase.addTeardown(@() igraph.rngBuffer(previous));
+            igraph.rngBuffer(4096);
+
+            igraph.rng(testCase.seed(1), 'matlab');
+            expected1 = igraph.randgame(testCase.method);
+            expected2 = igraph.randgame(testCase.method);
+
+            rng(testCase.seed(1));
+            actual1 = igraph.randgame(testCase.method);
+            actual2 = igraph.randgame(testCase.method);
+
+            testCase.verifyEqual(actual1, expected1);
+            testCase.verifyEqual(actual2, expected2);
+            testCase.verifyNotEqual(actual2, actual1);
+        end
+
+        function reproduceBufferedSamplers(testCase)
+            previous = igraph.rngBuffer();
+            testCase.addTeardown(@() igraph.rngBuffer(previous));
+            igraph.rngBuffer(4096);
+
+            % G(n, p) skips over non-edges with geometric draws.
+            igraph.rng(testCase.seed(1), 'matlab');
+            expected = igraph.randgame('RenyiErdos', 'nNodes', 200, ...
+                                       'probability', 0.05);
+
+            igraph.rng(testCase.seed(1));
+            actual = igraph.randgame('RenyiErdos', 'nNodes', 200, ...
+                                     'probability', 0.05);
+
+            testCase.verifyEqual(actual, expected);
+            testCase.verifyGreaterThan(igraph.numedges(actual), 0.8 * 995);
+            testCase.verifyLessThan(igraph.numedges(actual), 1.2 * 995);
+        end
+
+        function bufferSizeCanBeChanged(testCase)
+            previous = igraph.rngBuffer();
+            testCase.addTeardown(@() igraph.rngBuffer(previous));
+
+            igraph.rngBuffer(100);
+            testCase.verifyEqual(igraph.rngBuffer(), 100);
+
+            igraph.rngBuffer(0);
+            testCase.verifyEqual(igraph.rngBuffer(), 0);
+        end
     end
 
     methods (Test, TestTags = {'Repeatability'})
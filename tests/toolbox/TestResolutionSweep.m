@@ -0,0 +1,70 @@
+classdef TestResolutionSweep < matlab.unittest.TestCase
+    properties
+        adj;
+        gammas = [0.25 0.5 1 2 4];
+    end
+
+    methods (TestClassSetup)
+        function setupGraph(testCase)
+            testCase.adj = plantedPartition();
+        end
+    end
+
+    methods (Test, TestTags = {'Unit'})
+        function testOutputSizes(testCase)
+            [memberships, quality, nComms] = ...
+                igraph.cluster(testCase.adj, 'leiden', 'metric', ...
+                               'modularity', 'resolution', testCase.gammas);
+
+            nRes = length(testCase.gammas);
+            testCase.verifySize(memberships, ...
+                                [nRes igraph.numnodes(testCase.adj)]);
+            testCase.verifySize(quality, [nRes 1]);
+            testCase.verifyEqual(nComms, max(memberships, [], 2));
+        end
+
+        function testQualityIsModularity(testCase)
+            [memberships, quality] = ...
+                igraph.cluster(testCase.adj, 'multilevel', ...
+                               'resolution', testCase.gammas);
+
+            for i = 1:length(testCase.gammas)
+                testCase.verifyEqual(quality(i), ...
+                                     igraph.modularity(testCase.adj, ...
+                                                       memberships(i, :)), ...
+                                     'AbsTol', 1e-10);
+            end
+        end
+
+        function testFirstStepMatchesSingleCall(testCase)
+            igraph.rng(5);
+            memberships = igraph.cluster(testCase.adj, 'leiden', ...
+                                         'resolution', testCase.gammas);
+            igraph.rng(5);
+            expected = igraph.cluster(testCase.adj, 'leiden', ...
+                                      'resolution', testCase.gammas(1));
+
+            testCase.verifyEqual(memberships(1, :), expected);
+        end
+
+        function testParallelSweepIsReproducible(testCase)
+            igraph.rng(5);
+            expected = igraph.cluster(testCase.adj, 'leiden', ...
+                                      'resolution', testCase.gammas, ...
+                                      'parallelSweep', true);
+            igraph.rng(5);
+            actual = igraph.cluster(testCase.adj, 'leiden', ...
+                                    'resolution', testCase.gammas, ...
+                                    'parallelSweep', true);
+
+            testCase.verifyEqual(actual, expected);
+        end
+
+        function testOtherMethodsFail(testCase)
+            testCase.verifyError(@() igraph.cluster(testCase.adj, ...
+                                                    'infomap', ...
+                                                    'resolution', [1 2]), ...
+                                 "igraph:invalidOption");
+        end
+    end
+end
@@ -0,0 +1,19 @@
+function [adj, membership] = plantedPartition(blockSize, pIn, seed)
+%PLANTEDPARTITION three community stochastic block model
+%   [ADJ, MEMBERSHIP] = PLANTEDPARTITION(BLOCKSIZE, PIN, SEED) seeds the RNG
+%   with SEED then samples three blocks of BLOCKSIZE nodes with edge
+%   probability PIN inside blocks and 0.05 between them. MEMBERSHIP is the
+%   planted partition.
+
+    arguments
+        blockSize (1, 1) = 20;
+        pIn (1, 1) = 0.5;
+        seed (1, 1) = 42;
+    end
+
+    pOut = 0.05;
+    igraph.rng(seed);
+    adj = igraph.randgame('sbm', 'blockSizes', repelem(blockSize, 3), ...
+                          'preference', pOut + ((pIn - pOut) * eye(3)));
+    membership = repelem(1:3, blockSize);
+end
@@ -0,0 +1,42 @@
+function info = cache(action, value)
+%CACHE inspect or control igraph's converted graph cache
+%   Converting an adjacency matrix to igraph's internal graph type can take
+%   longer than the algorithm run on it. To avoid repeating the conversion,
+%   functions that only read their graph keep the most recently converted
+%   graphs between calls. Repeated calls on the same (unmodified) matrix with
+%   the same ISDIRECTED and ISWEIGHTED options reuse the cached graph. Graphs
+%   passed as GRAPH or DIGRAPH objects are not cached.
+%
+%   INFO = CACHE() return a struct with the cache's hits, misses, number of
+%   entries, and capacity.
+%
+%   CACHE('clear') free all cached graphs and reset the hit and miss counts.
+%
+%   CACHE('capacity', N) keep at most N graphs in the cache (default 4).
+%   Setting N to 0 disables the cache.
+%
+%   See also IGRAPH.CLUSTER, IGRAPH.CENTRALITY.
+
+    arguments
+        action (1, :) char ...
+            {igutils.mustBeMemberi(action, {'info', 'clear', 'capacity'})} ...
+            = 'info';
+        value (1, 1) {mustBeNonnegative, mustBeInteger} = 0;
+    end
+
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    if strcmpi(action, 'capacity') && nargin < 2
+        error("igraph:missingArgument", ...
+              "Setting the cache's capacity requires a value.");
+    end
+
+    if nargout == 0 && ~strcmpi(action, 'info')
+        mexIgraphDispatcher(opcode, lower(action), value);
+    else
+        info = mexIgraphDispatcher(opcode, lower(action), value);
+    end
+end
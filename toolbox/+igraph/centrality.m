@@ -16,6 +16,13 @@ function values = centrality(graph, method, graphOpts, methodOpts, attribute)
 %   store the results such that GRAPH.Nodes.NAME will be a vector of centrality
 %   values. Note: The original GRAPH is not modified.
 %
+%   VALUES = CENTRALITY(GRAPHS, METHOD, ...) when GRAPHS is a cell array of
+%   graphs, calculate the centrality of every graph in a single call and
+%   return a cell array of results the same size as GRAPHS. Graphs are
+%   processed in parallel. Options that default to values based on the graph
+%   (such as 'vids') are determined separately for each graph. The 'result'
+%   option can not be used with a batch of graphs.
+%
 %   Method specific arguments:
 %      'normalized'   logical for 'closeness', 'harmonic'; whether to return
 %                     the mean (true) or sum (false) of the results (default
@@ -30,15 +37,14 @@ function values = centrality(graph, method, graphOpts, methodOpts, attribute)
 %   See also IGRAPH.ISDIRECTED.
 
     arguments
-       graph {igutils.mustBeGraph};
+       graph {igutils.mustBeGraphOrBatch};
        method (1, :) char ...
            {igutils.mustBeMemberi(method, ...
                                   {'closeness', 'harmonic', 'betweenness', ...
                                    'pagerank', 'burt', 'constraint', ...
                                    'eigenvector'})};
-       graphOpts.isdirected = igraph.isdirected(graph);
-       methodOpts.vids (1, :) {mustBePositive, mustBeInteger} = ...
-           1:igraph.numnodes(graph);
+       graphOpts.isdirected {igutils.mustBeFlag};
+       methodOpts.vids (1, :) {mustBePositive, mustBeInteger};
        methodOpts.mode (1, :) char {igutils.mustBeMode} = 'all';
        methodOpts.normalized (1, 1) logical = true;
        methodOpts.damping (1, 1) ...
@@ -47,11 +53,34 @@ function values = centrality(graph, method, graphOpts, methodOpts, attribute)
            {igutils.mustHoldNodeAttr(graph, attribute.results)} = '';
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     method = lower(method);
     if strcmp(method, 'constraint')
         method = 'burt';
     end
 
+    if iscell(graph)
+        if ~isempty(attribute.results)
+            error("igraph:invalidOption", ...
+                  "Results can not be stored as node attributes when " + ...
+                  "calculating centrality for a batch of graphs.");
+        end
+
+        [graphOpts, methodOpts] = cellfun(@(g) setDefaults(g, graphOpts, ...
+                                                           methodOpts), ...
+                                          graph, 'UniformOutput', false);
+        values = mexIgraphDispatcher(opcode, graph, method, ...
+                                     graphOpts, methodOpts);
+        values = reshape(values, size(graph));
+        return
+    end
+
+    [graphOpts, methodOpts] = setDefaults(graph, graphOpts, methodOpts);
+
     if ~isempty(attribute.results) && ...
             length(methodOpts.vids) < igraph.numnodes(graph)
         error("Cannot store results in graph as node attributes " + ...
@@ -59,7 +88,7 @@ function values = centrality(graph, method, graphOpts, methodOpts, attribute)
               "nodes (i.e. when vids is not a vector of all node ids.)");
     end
 
-    values = mexIgraphDispatcher(mfilename(), graph, method, graphOpts, ...
+    values = mexIgraphDispatcher(opcode, graph, method, graphOpts, ...
                                  methodOpts);
 
     if ~isempty(attribute.results)
@@ -67,3 +96,13 @@ function values = centrality(graph, method, graphOpts, methodOpts, attribute)
         values = graph;
     end
 end
+
+function [graphOpts, methodOpts] = setDefaults(graph, graphOpts, methodOpts)
+    if ~igutils.isoptionset(graphOpts, 'isdirected')
+        graphOpts.isdirected = 'infer';
+    end
+
+    if ~igutils.isoptionset(methodOpts, 'vids')
+        methodOpts.vids = 1:igraph.numnodes(graph);
+    end
+end
@@ -1,4 +1,6 @@
-function membership = cluster(graph, method, graphOpts, methodOpts, attribute)
+function [membership, quality, nCommunities] = ...
+    cluster(graph, method, graphOpts, methodOpts, startOpts, sweepOpts, ...
+            attribute)
 %CLUSTER perform community detection on a graph
 %   MEMBERSHIP = CLUSTER(GRAPH, METHOD) use METHOD to find a community
 %   structure for the graph. See below for method specific options.
@@ -26,6 +28,55 @@ function membership = cluster(graph, method, graphOpts, methodOpts, attribute)
 %   store the results such that GRAPH.Nodes.NAME will be the membership vector.
 %   Note: The original GRAPH is not modified.
 %
+%   MEMBERSHIPS = CLUSTER(GRAPHS, METHOD, ...) when GRAPHS is a cell array of
+%   graphs, cluster every graph in a single call and return a cell array of
+%   membership vectors the same size as GRAPHS. The same options are used for
+%   each graph, options that default to values based on the graph are
+%   determined separately for each graph. Graphs are clustered in parallel
+%   and each gets its own random number stream seeded from the current RNG
+%   (see IGRAPH.RNG), so results are reproducible for a given seed and do not
+%   depend on the number of threads but will differ from clustering the
+%   graphs one at a time. The 'result' option can not be used with a batch of
+%   graphs.
+%
+%   [MEMBERSHIP, QUALITY] = CLUSTER(...) also return the quality of the
+%   community structure. For 'infomap' this is the codelength of the
+%   partition (lower is better), for all other methods it is the partition's
+%   modularity (higher is better), regardless of the metric the method
+%   optimizes. With a batch of graphs, QUALITY is an array the same size as
+%   GRAPHS.
+%
+%   MEMBERSHIP = CLUSTER(GRAPH, METHOD, 'nStarts', N) run a stochastic method
+%   N times on the same graph and return the best community structure found,
+%   as rated by QUALITY. Restarts run in parallel, each with its own random
+%   number stream seeded from the current RNG, so results are reproducible
+%   for a given seed and do not depend on the number of threads. Ties go to
+%   the earliest restart. Can not be used with the deterministic methods
+%   'optimal', 'LeadingEigenvector', 'walktrap', 'EdgeBetweenness' and
+%   'FastGreedy' or with a batch of graphs.
+%
+%   [MEMBERSHIPS, QUALITY] = CLUSTER(GRAPH, METHOD, 'nStarts', N,
+%   'returnAll', true) return the result of every restart instead of only the
+%   best. MEMBERSHIPS is an N x numnodes matrix with one community structure
+%   per row and QUALITY is an N x 1 vector. The 'result' option can not be
+%   used when returning all restarts.
+%
+%   [MEMBERSHIP, QUALITY, NCOMMUNITIES] = CLUSTER(...) also return the
+%   number of communities found.
+%
+%   [MEMBERSHIPS, QUALITY, NCOMMUNITIES] = CLUSTER(GRAPH, METHOD,
+%   'resolution', GAMMAS) for the 'multilevel' and 'leiden' methods, when
+%   GAMMAS is a vector, cluster the graph at each resolution in GAMMAS.
+%   MEMBERSHIPS has one row per resolution and QUALITY and NCOMMUNITIES are
+%   column vectors with one value per resolution. The graph is converted,
+%   and the node strengths for Leiden's modularity metric are computed, once
+%   for the whole sweep. Leiden starts each resolution from the partition
+%   found at the previous resolution, so sorting GAMMAS in increasing order
+%   lets each step refine the last. Set 'parallelSweep' to true to instead
+%   cluster every resolution independently in parallel, each with its own
+%   random number stream seeded from the current RNG. A sweep can not be
+%   combined with restarts, a batch of graphs or the 'result' option.
+%
 %   MEMBERSHIP = CLUSTER(GRAPH, 'optimal') Find the community structure that
 %   maximizes Newman's modularity. This algorithm is slow for larger graphs and
 %   likely unfeasible for graphs beyond ~100 nodes. See
@@ -148,7 +199,7 @@ function membership = cluster(graph, method, graphOpts, methodOpts, attribute)
 %   See also IGRAPH.MODULARITY, IGRAPH.COMPARE.
 
     arguments
-        graph {igutils.mustBeGraph};
+        graph {igutils.mustBeGraphOrBatch};
         method (1, :) char ...
             {igutils.mustBeMemberi(method, ...
                                    {'optimal', 'spinglass', 'leadingeigenvector', ...
@@ -157,7 +208,7 @@ function membership = cluster(graph, method, graphOpts, methodOpts, attribute)
                                     'fluidcommunities', 'labelpropagation', ...
                                     'infomap'})};
 
-        graphOpts.isdirected (1, 1) logical = igraph.isdirected(graph);
+        graphOpts.isdirected {igutils.mustBeFlag};
         methodOpts.nSpins;
         methodOpts.parallel;
         methodOpts.tempStart;
@@ -177,161 +228,121 @@ function membership = cluster(graph, method, graphOpts, methodOpts, attribute)
         methodOpts.mode;
         methodOpts.nTrials;
         methodOpts.nodeWeights;
+        startOpts.nStarts (1, 1) {mustBePositive, mustBeInteger} = 1;
+        startOpts.returnAll (1, 1) logical = false;
+        sweepOpts.parallelSweep (1, 1) logical = false;
         attribute.results (1, :) char ...
             {igutils.mustHoldNodeAttr(graph, attribute.results)} = '';
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     method = lower(method);
     if strcmp(method, 'louvain')
         method = 'multilevel';
     end
 
-    methodOpts = namedargs2cell(methodOpts);
-    switch method
-      case 'optimal'
-        methodOpts = parseNullOptions(graph, methodOpts{:});
-      case 'spinglass'
-        methodOpts = parseSpinglassOptions(graph, methodOpts{:});
-      case 'leadingeigenvector'
-        methodOpts = parseLeadingEigenvectorOptions(graph, methodOpts{:});
-      case 'walktrap'
-        methodOpts = parseWalktrapOptions(graph, methodOpts{:});
-      case 'edgebetweenness'
-        methodOpts = parseEdgeBetweenness(graph, methodOpts{:});
-      case 'fastgreedy'
-        methodOpts = parseNullOptions(graph, methodOpts{:});
-      case 'multilevel'
-        methodOpts = parseMultilevelOptions(graph, methodOpts{:});
-      case 'leiden'
-        methodOpts = parseLeidenOptions(graph, methodOpts{:});
-      case 'fluidcommunities'
-        methodOpts = parseFluidCommunitiesOptions(graph, methodOpts{:});
-      case 'labelpropagation'
-        methodOpts = parseLabelPropagationOptions(graph, methodOpts{:});
-      case 'infomap'
-        methodOpts = parseInfomapOptions(graph, methodOpts{:});
+    isMultiStart = startOpts.nStarts > 1 || startOpts.returnAll;
+    if isMultiStart && ...
+            ismember(method, {'optimal', 'leadingeigenvector', 'walktrap', ...
+                              'edgebetweenness', 'fastgreedy'})
+        error("igraph:invalidOption", ...
+              "Method %s is deterministic and can not be restarted.", ...
+              method);
     end
 
-    membership = mexIgraphDispatcher(mfilename(), graph, method, graphOpts, ...
-                                     methodOpts);
-
-    if ~isempty(attribute.results)
-        graph.Nodes.(attribute.results) = membership';
-        membership = graph;
+    if startOpts.returnAll && ~isempty(attribute.results)
+        error("igraph:invalidOption", ...
+              "Results can not be stored as node attributes when " + ...
+              "returning all restarts.");
     end
-end
 
-function opts = parseNullOptions(~)
-    arguments
-        ~
+    isSweep = isfield(methodOpts, 'resolution') && ...
+              numel(methodOpts.resolution) > 1;
+    if isSweep && ~ismember(method, {'multilevel', 'leiden'})
+        error("igraph:invalidOption", ...
+              "Only the multilevel and leiden methods accept a vector " + ...
+              "of resolutions.");
     end
 
-    opts = struct();
-end
-
-function opts = parseSpinglassOptions(graph, opts)
-    arguments
-        graph %#ok<INUSA>
-        opts.nSpins (1, 1) {mustBePositive, mustBeInteger} = 4;
-        opts.parallel (1, 1) logical = min(graph) > 0;
-        opts.tempStart (1, 1) {mustBeNumeric} = 1;
-        opts.tempEnd (1, 1) {mustBeNumeric} = 0.01;
-        opts.coolingFactor (1, 1) {mustBeNumeric} = 0.99;
-        opts.updateRule (1, :) ...
-            {igutils.mustBeMemberi(opts.updateRule, ...
-                                   {'simple', 'config'})} = 'simple';
-        opts.resolution (1, 1) {mustBeNumeric} = 0.8;
-        opts.negResolution (1, 1) {mustBeNumeric} = 0.1;
+    if isSweep && (isMultiStart || iscell(graph) || ...
+                   ~isempty(attribute.results))
+        error("igraph:invalidOption", ...
+              "A resolution sweep can not be combined with restarts, a " + ...
+              "batch of graphs or storing results as node attributes.");
     end
 
-    opts.updateRule = lower(opts.updateRule);
-end
+    if iscell(graph)
+        if ~isempty(attribute.results)
+            error("igraph:invalidOption", ...
+                  "Results can not be stored as node attributes when " + ...
+                  "clustering a batch of graphs.");
+        end
 
-function opts = parseLeadingEigenvectorOptions(graph, opts)
-    arguments
-        graph %#ok<INUSA>
-        opts.maxSteps (1, 1) {mustBePositive, mustBeInteger} = 5;
-        opts.initial (1, :) ...
-            {igutils.mustBePartition} = 1:igraph.numnodes(graph);
-    end
-end
+        if isMultiStart
+            error("igraph:invalidOption", ...
+                  "Restarts can not be used when clustering a batch of " + ...
+                  "graphs.");
+        end
 
-function opts = parseWalktrapOptions(~, opts)
-    arguments
-        ~
-        opts.nSteps (1, 1) {mustBePositive, mustBeInteger} = 4;
-    end
-end
-
-function opts = parseEdgeBetweenness(graph, opts)
-    arguments
-        graph %#ok<INUSA>
-        opts.isweighted (1, 1) logical = igraph.isweighted(graph);
+        [graphOpts, methodOpts] = cellfun(@(g) parseOptions(g, method, ...
+                                                            graphOpts, ...
+                                                            methodOpts), ...
+                                          graph, 'UniformOutput', false);
+        if nargout > 1
+            [membership, quality] = mexIgraphDispatcher(opcode, ...
+                                                        graph, method, ...
+                                                        graphOpts, ...
+                                                        methodOpts);
+            quality = reshape(quality, size(graph));
+        else
+            membership = mexIgraphDispatcher(opcode, graph, method, ...
+                                             graphOpts, methodOpts);
+        end
+        membership = reshape(membership, size(graph));
+        nCommunities = cellfun(@max, membership);
+        return
     end
-end
-
-function opts = parseMultilevelOptions(~, opts)
-    arguments
-        ~
-        opts.resolution (1, 1) {mustBeNonnegative} = 1;
-    end
-end
 
-function opts = parseLeidenOptions(graph, opts)
-    arguments
-        graph  %#ok<INUSA>
-        opts.resolution (1, 1) {mustBeNumeric} = 1;
-        opts.randomness (1, 1) {mustBePositive} = 0.01;
-        opts.nIterations (1, 1) {mustBeInteger} = -1;
-        opts.metric (1, :) char ...
-            {igutils.mustBeMemberi(opts.metric, ...
-                                   {'modularity', 'cpm', ...
-                                    'constantpottsmodel'})} = 'cpm';
-        opts.initial (1, :) ...
-            {igutils.mustBePartition} = 1:igraph.numnodes(graph);
+    [graphOpts, methodOpts] = parseOptions(graph, method, graphOpts, ...
+                                           methodOpts);
+    if isMultiStart
+        methodOpts.nStarts = startOpts.nStarts;
+        methodOpts.returnAll = startOpts.returnAll;
     end
 
-    opts.metric = lower(opts.metric);
-    if strcmp(opts.metric, 'constantpottsmodel')
-        opts.metric = 'cpm';
+    if isSweep
+        methodOpts.parallelSweep = sweepOpts.parallelSweep;
     end
-end
 
-function opts = parseFluidCommunitiesOptions(~, opts)
-    arguments
-        ~
-        opts.nCommunities (1, 1) {mustBePositive, mustBeInteger} = 1;
+    results = cell(1, max(1, min(nargout, 2 + isSweep)));
+    [results{:}] = mexIgraphDispatcher(opcode, graph, method, ...
+                                       graphOpts, methodOpts);
+    membership = results{1};
+    if nargout > 1
+        quality = results{2};
     end
-end
 
-function opts = parseLabelPropagationOptions(graph, opts)
-    arguments
-        graph %#ok<INUSA>
-        opts.mode (1, :) char {igutils.mustBeMode} = 'all';
-        opts.initial (1, :) ...
-            {igutils.mustBePartition} = 1:igraph.numnodes(graph);
-        opts.fixed (1, :) logical = false(1, igraph.numnodes(graph));
+    if nargout > 2 && isSweep
+        nCommunities = results{3};
+    elseif nargout > 2
+        nCommunities = max(membership, [], 2);
     end
 
-    if length(opts.fixed) ~= length(opts.initial)
-        throwAsCaller(MException("igraph:wrongLength", ...
-                                 "Option fixed must match " + ...
-                                 "length of option initial"));
+    if ~isempty(attribute.results)
+        graph.Nodes.(attribute.results) = membership';
+        membership = graph;
     end
 end
 
-function opts = parseInfomapOptions(graph, opts)
-    arguments
-        graph
-        opts.nTrials (1, 1) {mustBePositive,mustBeInteger} = 1;
-        opts.nodeWeights (1, :) {mustBePositive} = ...
-            ones(1, igraph.numnodes(graph));
+function [graphOpts, methodOpts] = parseOptions(graph, method, graphOpts, ...
+                                                methodOpts)
+    if ~igutils.isoptionset(graphOpts, 'isdirected')
+        graphOpts.isdirected = 'infer';
     end
 
-    if length(opts.nodeWeights) ~= igraph.numnodes(graph)
-        throwAsCaller(MException("igraph:wrongLength", ...
-                                 "The length of node weights must be" + ...
-                                 " equal to the number of nodes in the" + ...
-                                 " adjacency matrix."));
-    end
+    methodOpts = parseClusterOptions(graph, method, methodOpts);
 end
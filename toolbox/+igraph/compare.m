@@ -24,6 +24,11 @@ function score = compare(comm1, comm2, method)
                                             'adjustedrand','ari'})} = 'nmi';
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     method = lower(method);
     if strcmp(method, 'splitjoin')
         method = 'split_join';
@@ -33,7 +38,7 @@ function score = compare(comm1, comm2, method)
         method = 'adjusted_rand';
     end
 
-    score = mexIgraphDispatcher(mfilename(), comm1, comm2, method);
+    score = mexIgraphDispatcher(opcode, comm1, comm2, method);
 end
 
 function mustBeEqualLength(a, b)
@@ -0,0 +1,123 @@
+function [consensus, membership] = consensus(memberships, graph, opts, ...
+                                             methodOpts)
+%CONSENSUS co-assignment matrix of a set of community structures
+%   CONSENSUS = CONSENSUS(MEMBERSHIPS) for an nPartitions x nNodes matrix
+%   MEMBERSHIPS with one membership vector per row, such as the output of
+%   IGRAPH.CLUSTER with 'returnAll', return the sparse nNodes x nNodes matrix
+%   whose (i, j) entry is the fraction of partitions that place nodes i and j
+%   in the same community. The diagonal is left empty.
+%
+%   CONSENSUS = CONSENSUS(MEMBERSHIPS, GRAPH) only count node pairs joined by
+%   an edge in GRAPH. Edge directions and weights are ignored. For large
+%   graphs this keeps the consensus matrix as sparse as GRAPH instead of
+%   holding every pair of nodes that share a community.
+%
+%   CONSENSUS = CONSENSUS(..., 'threshold', T) drop node pairs placed in the
+%   same community by less than a fraction T of the partitions (default 0,
+%   keep every pair that shares a community at least once).
+%
+%   [CONSENSUS, MEMBERSHIP] = CONSENSUS(..., 'method', METHOD) iterate
+%   consensus clustering (see: Andrea Lancichinetti & Santo Fortunato (2012)
+%   Consensus Clustering in Complex Networks, Scientific Reports.). The
+%   weighted graph of the consensus matrix is clustered nStarts times with
+%   METHOD and a new consensus matrix is built from the results, with the
+%   same restriction and threshold, until every partition agrees or the
+%   maximum number of iterations is reached. CONSENSUS is the final
+%   consensus matrix and MEMBERSHIP is the first partition of the final
+%   iteration. METHOD can be any of the stochastic methods accepted by
+%   IGRAPH.CLUSTER: 'SpinGlass', 'multilevel' (or 'louvain'), 'leiden',
+%   'FluidCommunities', 'LabelPropagation' and 'infomap', and takes the same
+%   method options. Each clustering gets its own random number stream seeded
+%   from the current RNG (see IGRAPH.RNG) and they run in parallel.
+%
+%         Name            Description
+%       --------------------------------------------------------------------
+%        'nStarts'        Number of times to cluster the consensus graph in
+%                         each iteration (default the number of rows of
+%                         MEMBERSHIPS).
+%        'maxIterations'  Maximum number of times to cluster the consensus
+%                         graph (default 20).
+%
+%   See also IGRAPH.CLUSTER, IGRAPH.COMPARE.
+
+    arguments
+        memberships (:, :) {mustBeInteger, mustBePositive};
+        graph {mustBeGraphOrEmpty} = [];
+        opts.threshold (1, 1) {mustBeInRange(opts.threshold, 0, 1)} = 0;
+        opts.method (1, :) char = '';
+        opts.nStarts (1, 1) {mustBePositive, mustBeInteger} = ...
+            size(memberships, 1);
+        opts.maxIterations (1, 1) {mustBeNonnegative, mustBeInteger} = 20;
+        methodOpts.nSpins;
+        methodOpts.parallel;
+        methodOpts.tempStart;
+        methodOpts.tempEnd;
+        methodOpts.coolingFactor;
+        methodOpts.updateRule;
+        methodOpts.resolution;
+        methodOpts.negResolution;
+        methodOpts.initial;
+        methodOpts.randomness;
+        methodOpts.nIterations;
+        methodOpts.metric;
+        methodOpts.fixed;
+        methodOpts.mode;
+        methodOpts.nTrials;
+        methodOpts.nodeWeights;
+        methodOpts.nCommunities;
+    end
+
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    nNodes = size(memberships, 2);
+    if ~isempty(graph) && igraph.numnodes(graph) ~= nNodes
+        error("igraph:wrongLength", ...
+              "The number of columns of memberships must be equal to " + ...
+              "the number of nodes in the graph.");
+    end
+
+    graphOpts = struct('isdirected', false);
+    if ~isempty(graph)
+        graphOpts.isdirected = 'infer';
+    end
+
+    opts.method = lower(opts.method);
+    if strcmp(opts.method, 'louvain')
+        opts.method = 'multilevel';
+    end
+
+    if isempty(opts.method)
+        if nargout > 1
+            error("igraph:invalidOption", ...
+                  "A membership can only be returned when a method is set.");
+        end
+
+        methodOpts = struct();
+    else
+        igutils.mustBeMemberi(opts.method, ...
+                              {'spinglass', 'multilevel', 'leiden', ...
+                               'fluidcommunities', 'labelpropagation', ...
+                               'infomap'});
+        methodOpts = parseClusterOptions(sparse(nNodes, nNodes), ...
+                                         opts.method, methodOpts);
+    end
+
+    if nargout > 1
+        [consensus, membership] = mexIgraphDispatcher(opcode, ...
+                                                      memberships, graph, ...
+                                                      graphOpts, opts, ...
+                                                      methodOpts);
+    else
+        consensus = mexIgraphDispatcher(opcode, memberships, graph, ...
+                                        graphOpts, opts, methodOpts);
+    end
+end
+
+function mustBeGraphOrEmpty(graph)
+    if ~isempty(graph)
+        igutils.mustBeGraph(graph);
+    end
+end
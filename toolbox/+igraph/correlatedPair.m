@@ -67,10 +67,15 @@ function g2 = correlateWith(g1, graphOpts, methodOpts)
         methodOpts.density = igraph.edgeDensity(g1);
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", "correlateWith");
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphOutProps(graphOpts{:}, template = g1);
 
-    g2 = mexIgraphDispatcher(mfunctionname(), g1, graphOpts, methodOpts);
+    g2 = mexIgraphDispatcher(opcode, g1, graphOpts, methodOpts);
 end
 
 function [g1, g2] = generatePair(nNodes, graphOpts, methodOpts)
@@ -82,9 +87,14 @@ function [g1, g2] = generatePair(nNodes, graphOpts, methodOpts)
         methodOpts.density = 0.5;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", "generatePair");
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphOutProps(graphOpts{:});
 
-    [g1, g2] = mexIgraphDispatcher(mfunctionname(), nNodes, ...
+    [g1, g2] = mexIgraphDispatcher(opcode, nNodes, ...
                                    graphOpts, methodOpts);
 end
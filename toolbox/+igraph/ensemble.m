@@ -0,0 +1,107 @@
+function [values, observed] = ensemble(graph, nullModel, statistic, ...
+                                       graphOpts, methodOpts)
+%ENSEMBLE measure a statistic over random replicates of a graph
+%   VALUES = ENSEMBLE(GRAPH, NULLMODEL, STATISTIC) generate random replicates
+%   of GRAPH from the null model NULLMODEL and return the STATISTIC of each
+%   replicate as a column vector. Replicates are generated and measured in
+%   parallel, each with its own random number stream seeded from the current
+%   RNG (see IGRAPH.RNG), and are never returned to MATLAB, so only the
+%   statistics take up memory. Results are reproducible for a given seed and
+%   do not depend on the number of threads.
+%
+%   [VALUES, OBSERVED] = ENSEMBLE(...) also return the statistic of GRAPH
+%   itself. The z-score of the observed statistic is then
+%   (OBSERVED - mean(VALUES)) / std(VALUES).
+%
+%   Edge weights are ignored by both the null models and the statistics.
+%
+%   Null models:
+%
+%       Name              Description
+%   -------------------------------------------------------------------------
+%      'rewire'          Rewire the edges of GRAPH preserving the degree of
+%                        every node, see IGRAPH.REWIRE.
+%      'configuration'   A random graph with the same degree sequence as
+%                        GRAPH. Replicates may contain self-loops and
+%                        multiple edges.
+%      'ErdosRenyi'      A random graph with the same number of nodes and
+%                        edges as GRAPH.
+%
+%   Statistics:
+%
+%       Name              Description
+%   -------------------------------------------------------------------------
+%      'modularity'      Modularity of the partition given by the
+%                        'membership' option, see IGRAPH.MODULARITY.
+%      'transitivity'    Global clustering coefficient, ignoring edge
+%                        directions. NaN for graphs without connected
+%                        triples.
+%      'assortativity'   Degree assortativity.
+%      'PathLength'      Average shortest path length between connected
+%                        node pairs.
+%
+%   Statistic and null model names are case insensitive.
+%
+%         Name           Description
+%       --------------------------------------------------------------------
+%        'nReplicates'  Number of replicates to generate (default 1000).
+%        'nRewires'     Number of rewiring trials per replicate for the
+%                       'rewire' null model (default 10 times the number of
+%                       edges).
+%        'membership'   The partition to score for the 'modularity'
+%                       statistic.
+%        'resolution'   Resolution for the 'modularity' statistic
+%                       (default 1).
+%        'isdirected'   Whether to treat the graph as directed (defaults to
+%                       the result of IGRAPH.ISDIRECTED).
+%
+%   See also IGRAPH.REWIRE, IGRAPH.RANDGAME, IGRAPH.MODULARITY.
+
+    arguments
+        graph {igutils.mustBeGraph};
+        nullModel (1, :) char ...
+            {igutils.mustBeMemberi(nullModel, ...
+                                   {'rewire', 'configuration', ...
+                                    'erdosrenyi'})};
+        statistic (1, :) char ...
+            {igutils.mustBeMemberi(statistic, ...
+                                   {'modularity', 'transitivity', ...
+                                    'assortativity', 'pathlength'})};
+        graphOpts.isdirected {igutils.mustBeFlag} = 'infer';
+        methodOpts.nReplicates (1, 1) ...
+            {mustBeNonnegative, mustBeInteger} = 1000;
+        methodOpts.nRewires (1, 1) {mustBeNonnegative, mustBeInteger} = ...
+            10 * igraph.numedges(graph);
+        methodOpts.membership {igutils.mustBePartition} = [];
+        methodOpts.resolution (1, 1) {mustBeNonnegative} = 1;
+    end
+
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    nullModel = lower(nullModel);
+    statistic = lower(statistic);
+
+    if strcmp(statistic, 'modularity') && isempty(methodOpts.membership)
+        error("igraph:invalidOption", ...
+              "The modularity statistic requires a membership.");
+    end
+
+    if ~isempty(methodOpts.membership) && ...
+            length(methodOpts.membership) ~= igraph.numnodes(graph)
+        error("igraph:wrongLength", ...
+              "The length of the membership must be equal to the " + ...
+              "number of nodes in the graph.");
+    end
+
+    if nargout > 1
+        [values, observed] = mexIgraphDispatcher(opcode, graph, ...
+                                                 nullModel, statistic, ...
+                                                 graphOpts, methodOpts);
+    else
+        values = mexIgraphDispatcher(opcode, graph, nullModel, ...
+                                     statistic, graphOpts, methodOpts);
+    end
+end
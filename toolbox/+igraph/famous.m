@@ -37,8 +37,13 @@ function graph = famous(name, graphOpts)
         graphOpts.?igutils.GraphOutProps;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphOutProps(graphOpts{:});
 
-    graph = mexIgraphDispatcher(mfilename(), lower(name), graphOpts);
+    graph = mexIgraphDispatcher(opcode, lower(name), graphOpts);
 end
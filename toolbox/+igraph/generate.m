@@ -187,6 +187,11 @@ function graph = generate(method, graphOpts, methodOpts)
         methodOpts.shift;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     method = lower(method);
     if strcmp(method, 'fullcitation')
         method = 'citation';
@@ -228,7 +233,7 @@ function graph = generate(method, graphOpts, methodOpts)
               method);
     end
 
-    graph = mexIgraphDispatcher(mfilename(), method, graphOpts, methodOpts);
+    graph = mexIgraphDispatcher(opcode, method, graphOpts, methodOpts);
 end
 
 function opts = parseOptionsStar(opts)
@@ -1,7 +1,8 @@
 function TF = isdirected(graph)
 %ISDIRECTED guess if a graph is directed.
 %   TF = ISDIRECTED(GRAPH) returns false if the GRAPH is symmetric or a upper
-%   or lower triangular matrix, true otherwise.
+%   or lower triangular matrix, true otherwise. Edge lists store the
+%   orientation of each edge so are always assumed to be directed.
 %
 %   See also IGRAPH.ISWEIGHTED.
 
@@ -11,6 +12,8 @@ function TF = isdirected(graph)
         TF = true;
     elseif isa(graph, "graph")
         TF = false;
+    elseif igutils.isedgelist(graph)
+        TF = true;
     else
         TF = mexIgraphIsDirected(graph);
     end
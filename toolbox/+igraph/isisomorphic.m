@@ -17,5 +17,10 @@ function TF = isisomorphic(g1, g2, graphOpts)
             igraph.isdirected(g1) || igraph.isdirected(g2);
     end
 
-    TF = mexIgraphDispatcher(mfilename(), g1, g2, graphOpts);
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    TF = mexIgraphDispatcher(opcode, g1, g2, graphOpts);
 end
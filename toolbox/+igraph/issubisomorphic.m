@@ -18,11 +18,16 @@ function TF = issubisomorphic(g1, g2, graphOpts)
             igraph.isdirected(g1) || igraph.isdirected(g2);
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     if igraph.numnodes(g2) >= igraph.numnodes(g1)
         eid = "igraph:notASubgraph";
         msg = "Graph 2 must be smaller than graph 1.";
         error(eid, msg);
     end
 
-    TF = mexIgraphDispatcher(mfilename(), g1, g2, graphOpts);
+    TF = mexIgraphDispatcher(opcode, g1, g2, graphOpts);
 end
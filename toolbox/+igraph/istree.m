@@ -10,11 +10,16 @@ function TF = istree(graph, opts)
         opts.mode (1, :) char {igutils.mustBeMode} = 'all';
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     if ~igutils.isoptionset(opts, "isdirected")
        opts.isdirected = ~issymmetric(graph) || opts.mode ~= "all";
     end
 
     opts.mode = lower(opts.mode);
     opts.findRoot = false;
-    TF = mexIgraphDispatcher(mfilename(), graph, opts);
+    TF = mexIgraphDispatcher(opcode, graph, opts);
 end
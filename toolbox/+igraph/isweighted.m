@@ -1,13 +1,20 @@
 function TF = isweighted(graph)
 %ISWEIGHTED guess if a graph is weighted
 %   TF = ISWEIGHTED(GRAPH) return true if GRAPH contains values other than 0
-%   and 1.
+%   and 1. Edge lists are weighted if they have a field other than EndNodes
+%   and NumNodes.
 %
 %   See also IGRAPH.ISDIRECTED.
 
     if igutils.isgraph(graph)
         TF = igutils.hasEdgeAttr(graph);
+    elseif igutils.isedgelist(graph)
+        TF = ~isempty(edgeListAttrs(graph));
     else
         TF = sum(graph == 1 | graph == 0, 'all') ~= numel(graph);
     end
 end
+
+function attrs = edgeListAttrs(graph)
+    attrs = setdiff(fieldnames(graph), {'EndNodes', 'NumNodes'});
+end
@@ -216,6 +216,11 @@ function pos = layout(graph, method, graphOpts, methodOpts)
         methodOpts.circular
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphInProps(graph, graphOpts{:});
 
@@ -275,7 +280,7 @@ function pos = layout(graph, method, graphOpts, methodOpts)
               method);
     end
 
-    pos = mexIgraphDispatcher(mfilename(), graph, method, graphOpts, ...
+    pos = mexIgraphDispatcher(opcode, graph, method, graphOpts, ...
                               methodOpts);
 end
 
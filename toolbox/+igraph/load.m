@@ -80,6 +80,11 @@ function graph = load(filename, ioOptions, graphOpts)
         graphOpts.isdirected (1, 1) logical;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphOutProps(graphOpts{:});
 
@@ -120,7 +125,7 @@ function graph = load(filename, ioOptions, graphOpts)
         userSetDirectedness = false;
     end
 
-    graph = mexIgraphDispatcher(mfilename(), filename, ioOptions, graphOpts);
+    graph = mexIgraphDispatcher(opcode, filename, ioOptions, graphOpts);
 
     if ~userSetDirectedness
         graphOpts.isdirected = igraph.isdirected(graph);
@@ -0,0 +1,46 @@
+function budget = memoryBudget(bytes)
+%MEMORYBUDGET inspect or set the memory available to returned graphs
+%   Before returning a graph, functions estimate how much memory the requested
+%   representation needs and fail with the estimate, rather than building the
+%   graph, if it is larger than the memory budget. This guards against asking
+%   for a full adjacency matrix of a graph with millions of nodes. The
+%   estimate for 'auto' representations is for whichever of 'full' or
+%   'sparse' was picked.
+%
+%   BUDGET = MEMORYBUDGET() return the current budget in bytes. By default the
+%   budget is half of the machine's physical memory.
+%
+%   MEMORYBUDGET(BYTES) set the budget to BYTES. Use Inf to disable the check.
+%
+%   MEMORYBUDGET('default') restore the default budget.
+%
+%   See also IGRAPH.GENERATE, IGRAPH.RANDGAME, IGRAPH.LOAD.
+
+    arguments
+        bytes = [];
+    end
+
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    if isempty(bytes)
+        action = 'get';
+        bytes = 0;
+    elseif ischar(bytes) || isstring(bytes)
+        mustBeMember(lower(bytes), {'default'});
+        action = 'default';
+        bytes = 0;
+    else
+        mustBeScalarOrEmpty(bytes);
+        mustBeNonnegative(bytes);
+        action = 'set';
+    end
+
+    if nargout == 0 && ~strcmp(action, 'get')
+        mexIgraphDispatcher(opcode, action, double(bytes));
+    else
+        budget = mexIgraphDispatcher(opcode, action, double(bytes));
+    end
+end
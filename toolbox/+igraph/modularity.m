@@ -1,4 +1,5 @@
-function q = modularity(graph, membership, graphOpts, methodOpts)
+function [q, contributions] = modularity(graph, membership, graphOpts, ...
+                                         methodOpts)
 %MODULARITY calculate the modularity of a graph under a partition
 %   Q = MODULARITY(GRAPH, MEMBERSHIP) calculates the Newman modularity for the
 %   given GRAPH with structure provided by MEMBERSHIP.
@@ -11,15 +12,52 @@ function q = modularity(graph, membership, graphOpts, methodOpts)
 %   'isdirected' determines whether the graph should be treated as directed or
 %   not. Defaults to the results of IGRAPH.ISDIRECTED.
 %
+%   MEMBERSHIP can also be an nPartitions x nNodes matrix with one membership
+%   vector per row, such as the output of IGRAPH.CLUSTER with 'returnAll', and
+%   RESOLUTION a vector. Q is then the nPartitions x nResolutions matrix of
+%   the modularity of every partition at every resolution. The graph is only
+%   read once and each partition needs a single pass over the edges no
+%   matter how many resolutions are given. Partitions are scored in parallel.
+%
+%   [Q, CONTRIBUTIONS] = MODULARITY(...) also return each community's
+%   contribution to the modularity as an nCommunities x nResolutions matrix,
+%   where row i is the community with ID i. The contributions sum to Q. When
+%   MEMBERSHIP is a matrix, CONTRIBUTIONS is an nPartitions x 1 cell array
+%   with one such matrix per partition.
+%
 %   See also IGRAPH.OPTIMALMODULARITY, IGRAPH.CLUSTER.
 
     arguments
         graph {igutils.mustBeGraph};
-        membership {igutils.mustBePartition};
-        graphOpts.isdirected (1, 1) logical = igraph.isdirected(graph);
-        methodOpts.resolution (1, 1) {mustBeNonnegative} = 1;
+        membership (:, :) {igutils.mustBePartition};
+        graphOpts.isdirected {igutils.mustBeFlag} = 'infer';
+        methodOpts.resolution (1, :) {mustBeNonnegative, mustBeNonempty} = 1;
+    end
+
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    isSingle = isvector(membership) && ...
+        length(membership) == igraph.numnodes(graph);
+    if isSingle
+        membership = membership(:);
+    else
+        membership = membership';
+    end
+
+    if nargout < 2
+        q = mexIgraphDispatcher(opcode, graph, membership, graphOpts, ...
+                                methodOpts);
+        return
     end
 
-    q = mexIgraphDispatcher(mfilename(), graph, membership, graphOpts, ...
-                            methodOpts);
+    [q, contributions] = mexIgraphDispatcher(opcode, graph, ...
+                                             membership, graphOpts, ...
+                                             methodOpts);
+
+    if isSingle
+        contributions = contributions{1};
+    end
 end
@@ -11,6 +11,8 @@ function n = numedges(graph)
 
     if igutils.isgraph(graph)
         n = graph.numedges();
+    elseif igutils.isedgelist(graph)
+        n = size(graph.EndNodes, 1);
     elseif issymmetric(graph)
         n = nnz(graph);
         nDiag = sum(diag(graph) ~= 0);
@@ -11,6 +11,15 @@ function n = numnodes(graph)
 
     if igutils.isgraph(graph)
         n = graph.numnodes();
+    elseif igutils.isedgelist(graph)
+        if isfield(graph, 'NumNodes')
+            n = double(graph.NumNodes);
+        else
+            n = double(max(graph.EndNodes, [], 'all'));
+            if isempty(n)
+                n = 0;
+            end
+        end
     else
         n = size(graph, 2);
     end
@@ -25,8 +25,13 @@ function q = optimalModularity(graph, graphOpts)
         graphOpts.?igutils.GraphInProps;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphInProps(graph, graphOpts{:});
 
-    q = mexIgraphDispatcher(mfilename(), graph, graphOpts);
+    q = mexIgraphDispatcher(opcode, graph, graphOpts);
 end
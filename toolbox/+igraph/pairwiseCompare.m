@@ -0,0 +1,72 @@
+function varargout = pairwiseCompare(memberships, others, method)
+%PAIRWISECOMPARE score the similarity of many membership vectors at once
+%   SCORES = PAIRWISECOMPARE(MEMBERSHIPS) compare every pair of rows of the
+%   nPartitions x nNodes matrix MEMBERSHIPS, such as the output of
+%   IGRAPH.CLUSTER with 'returnAll', and return the symmetric nPartitions x
+%   nPartitions matrix of scores. SCORES(i, j) is IGRAPH.COMPARE(
+%   MEMBERSHIPS(i, :), MEMBERSHIPS(j, :)).
+%
+%   SCORES = PAIRWISECOMPARE(MEMBERSHIPS, OTHERS) compare every row of
+%   MEMBERSHIPS against every row of OTHERS, which must have the same number
+%   of columns, returning an nPartitions x nOthers matrix.
+%
+%   SCORES = PAIRWISECOMPARE(..., METHOD) use method METHOD to compare the
+%   membership vectors. METHOD accepts the same names as IGRAPH.COMPARE.
+%
+%   [SCORES1, SCORES2, ...] = PAIRWISECOMPARE(..., {METHOD1, METHOD2, ...})
+%   score the pairs with several methods at once, returning one matrix per
+%   method. Every partition is reindexed once and all methods are computed
+%   from a single contingency table per pair, so asking for several methods
+%   costs little more than asking for one. Pairs are compared in parallel.
+%
+%   See also IGRAPH.COMPARE, IGRAPH.CONSENSUS.
+
+    arguments
+        memberships (:, :) {mustBeInteger, mustBePositive};
+        others = [];
+        method = 'nmi';
+    end
+
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    if nargin == 2 && (ischar(others) || isstring(others) || ...
+                       iscell(others))
+        method = others;
+        others = [];
+    end
+
+    if ~isempty(others)
+        mustBeInteger(others);
+        mustBePositive(others);
+        if size(others, 2) ~= size(memberships, 2)
+            error("igraph:notEqualLength", ...
+                  "Memberships and others must have the same number " + ...
+                  "of columns.");
+        end
+    end
+
+    method = cellstr(method);
+    for i = 1:length(method)
+        igutils.mustBeMemberi(method{i}, {'vi', 'nmi', 'splitjoin', ...
+                                          'rand', 'adjustedrand', 'ari'});
+        method{i} = lower(method{i});
+        if strcmp(method{i}, 'splitjoin')
+            method{i} = 'split_join';
+        end
+
+        if strcmp(method{i}, 'adjustedrand') || strcmp(method{i}, 'ari')
+            method{i} = 'adjusted_rand';
+        end
+    end
+
+    if nargout > length(method)
+        error("igraph:tooManyOutputs", ...
+              "Requested more outputs than comparison methods.");
+    end
+
+    [varargout{1:max(nargout, 1)}] = ...
+        mexIgraphDispatcher(opcode, memberships', others', method);
+end
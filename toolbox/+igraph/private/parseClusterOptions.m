@@ -0,0 +1,150 @@
+function methodOpts = parseClusterOptions(graph, method, methodOpts)
+%PARSECLUSTEROPTIONS validate and fill in defaults for cluster method options
+%   METHODOPTS = PARSECLUSTEROPTIONS(GRAPH, METHOD, METHODOPTS) check the
+%   options in struct METHODOPTS are valid for cluster method METHOD and add
+%   defaults, some of which depend on GRAPH, for any that are missing. METHOD
+%   should already be lower case with aliases resolved.
+%
+%   See also IGRAPH.CLUSTER.
+
+    methodOpts = namedargs2cell(methodOpts);
+    switch method
+      case 'optimal'
+        methodOpts = parseNullOptions(graph, methodOpts{:});
+      case 'spinglass'
+        methodOpts = parseSpinglassOptions(graph, methodOpts{:});
+      case 'leadingeigenvector'
+        methodOpts = parseLeadingEigenvectorOptions(graph, methodOpts{:});
+      case 'walktrap'
+        methodOpts = parseWalktrapOptions(graph, methodOpts{:});
+      case 'edgebetweenness'
+        methodOpts = parseEdgeBetweenness(graph, methodOpts{:});
+      case 'fastgreedy'
+        methodOpts = parseNullOptions(graph, methodOpts{:});
+      case 'multilevel'
+        methodOpts = parseMultilevelOptions(graph, methodOpts{:});
+      case 'leiden'
+        methodOpts = parseLeidenOptions(graph, methodOpts{:});
+      case 'fluidcommunities'
+        methodOpts = parseFluidCommunitiesOptions(graph, methodOpts{:});
+      case 'labelpropagation'
+        methodOpts = parseLabelPropagationOptions(graph, methodOpts{:});
+      case 'infomap'
+        methodOpts = parseInfomapOptions(graph, methodOpts{:});
+    end
+end
+
+function opts = parseNullOptions(~)
+    arguments
+        ~
+    end
+
+    opts = struct();
+end
+
+function opts = parseSpinglassOptions(graph, opts)
+    arguments
+        graph %#ok<INUSA>
+        opts.nSpins (1, 1) {mustBePositive, mustBeInteger} = 4;
+        opts.parallel (1, 1) logical = min(graph) > 0;
+        opts.tempStart (1, 1) {mustBeNumeric} = 1;
+        opts.tempEnd (1, 1) {mustBeNumeric} = 0.01;
+        opts.coolingFactor (1, 1) {mustBeNumeric} = 0.99;
+        opts.updateRule (1, :) ...
+            {igutils.mustBeMemberi(opts.updateRule, ...
+                                   {'simple', 'config'})} = 'simple';
+        opts.resolution (1, 1) {mustBeNumeric} = 0.8;
+        opts.negResolution (1, 1) {mustBeNumeric} = 0.1;
+    end
+
+    opts.updateRule = lower(opts.updateRule);
+end
+
+function opts = parseLeadingEigenvectorOptions(graph, opts)
+    arguments
+        graph %#ok<INUSA>
+        opts.maxSteps (1, 1) {mustBePositive, mustBeInteger} = 5;
+        opts.initial (1, :) ...
+            {igutils.mustBePartition} = 1:igraph.numnodes(graph);
+    end
+end
+
+function opts = parseWalktrapOptions(~, opts)
+    arguments
+        ~
+        opts.nSteps (1, 1) {mustBePositive, mustBeInteger} = 4;
+    end
+end
+
+function opts = parseEdgeBetweenness(graph, opts)
+    arguments
+        graph %#ok<INUSA>
+        opts.isweighted (1, 1) logical = igraph.isweighted(graph);
+    end
+end
+
+function opts = parseMultilevelOptions(~, opts)
+    arguments
+        ~
+        opts.resolution (1, :) {mustBeNonempty, mustBeNonnegative} = 1;
+    end
+end
+
+function opts = parseLeidenOptions(graph, opts)
+    arguments
+        graph  %#ok<INUSA>
+        opts.resolution (1, :) {mustBeNonempty, mustBeNumeric} = 1;
+        opts.randomness (1, 1) {mustBePositive} = 0.01;
+        opts.nIterations (1, 1) {mustBeInteger} = -1;
+        opts.metric (1, :) char ...
+            {igutils.mustBeMemberi(opts.metric, ...
+                                   {'modularity', 'cpm', ...
+                                    'constantpottsmodel'})} = 'cpm';
+        opts.initial (1, :) ...
+            {igutils.mustBePartition} = 1:igraph.numnodes(graph);
+    end
+
+    opts.metric = lower(opts.metric);
+    if strcmp(opts.metric, 'constantpottsmodel')
+        opts.metric = 'cpm';
+    end
+end
+
+function opts = parseFluidCommunitiesOptions(~, opts)
+    arguments
+        ~
+        opts.nCommunities (1, 1) {mustBePositive, mustBeInteger} = 1;
+    end
+end
+
+function opts = parseLabelPropagationOptions(graph, opts)
+    arguments
+        graph %#ok<INUSA>
+        opts.mode (1, :) char {igutils.mustBeMode} = 'all';
+        opts.initial (1, :) ...
+            {igutils.mustBePartition} = 1:igraph.numnodes(graph);
+        opts.fixed (1, :) logical = false(1, igraph.numnodes(graph));
+    end
+
+    if length(opts.fixed) ~= length(opts.initial)
+        throwAsCaller(MException("igraph:wrongLength", ...
+                                 "Option fixed must match " + ...
+                                 "length of option initial"));
+    end
+end
+
+function opts = parseInfomapOptions(graph, opts)
+    arguments
+        graph
+        opts.nTrials (1, 1) {mustBePositive,mustBeInteger} = 1;
+        opts.nodeWeights (1, :) {mustBePositive} = ...
+            ones(1, igraph.numnodes(graph));
+    end
+
+    if length(opts.nodeWeights) ~= igraph.numnodes(graph)
+        throwAsCaller(MException("igraph:wrongLength", ...
+                                 "The length of node weights must be" + ...
+                                 " equal to the number of nodes in the" + ...
+                                 " adjacency matrix."));
+    end
+end
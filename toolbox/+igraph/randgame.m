@@ -541,6 +541,11 @@ function graph = randgame(method, graphOpts, methodOpts)
         methodOpts.nInterEdges;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     method = lower(method);
     switch method
       case 'generatorrandomgraph'
@@ -630,7 +635,7 @@ function graph = randgame(method, graphOpts, methodOpts)
                                  "representation or set multiple to false."));
     end
 
-    graph = mexIgraphDispatcher(mfilename(), method, graphOpts, methodOpts);
+    graph = mexIgraphDispatcher(opcode, method, graphOpts, methodOpts);
 end
 
 function opts = parseOptionsGrg(opts)
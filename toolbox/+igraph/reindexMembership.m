@@ -10,5 +10,10 @@ function memb = reindexMembership(memb)
         memb {igutils.mustBePartition};
     end
 
-    memb = mexIgraphDispatcher(mfilename(), memb);
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    memb = mexIgraphDispatcher(opcode, memb);
 end
@@ -36,6 +36,11 @@ function graph = rewire(graph, graphOpts, methodOpts)
         methodOpts.loops (1, 1) logical = false;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphOutProps(graphOpts{:}, template = graph);
     graphOpts = namedargs2cell(graphOpts);
@@ -70,5 +75,5 @@ function graph = rewire(graph, graphOpts, methodOpts)
         methodOpts.probability = methodOpts.nRewires / igraph.numedges(graph);
     end
 
-    graph = mexIgraphDispatcher(mfilename(), graph, graphOpts, methodOpts);
+    graph = mexIgraphDispatcher(opcode, graph, graphOpts, methodOpts);
 end
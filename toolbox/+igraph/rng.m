@@ -34,7 +34,12 @@ function rng(seed, generator)
                                     'pcg64', 'current'})} = 'current';
     end
 
-    generator = mexIgraphDispatcher(mfilename(), seed, generator);
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    generator = mexIgraphDispatcher(opcode, seed, generator);
 
     if strcmp(generator, 'matlab')
         rng(seed);
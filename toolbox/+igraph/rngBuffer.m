@@ -0,0 +1,51 @@
+function n = rngBuffer(n)
+%RNGBUFFER inspect or set how many of MATLAB's random numbers igraph buffers
+%   When igraph uses MATLAB's RNG (see IGRAPH.RNG) every random number is
+%   requested from MATLAB one at a time, which dominates the run time of
+%   random graph generators and other methods that need millions of random
+%   numbers. With buffering, uniform and normal random numbers are instead
+%   drawn from MATLAB's stream in blocks and handed out as needed. Normal,
+%   exponential, geometric, binomial and Poisson variates are also generated
+%   directly from these draws rather than through igraph's generic samplers,
+%   which need several draws per variate.
+%
+%   N = RNGBUFFER() return the current buffer size. A size of 0, the
+%   default, means random numbers are not buffered.
+%
+%   RNGBUFFER(N) draw N random numbers at a time. A few thousand is
+%   usually enough. Set N to 0 to turn buffering off.
+%
+%   Buffered numbers left over at the end of a call, or when the generator is
+%   switched, are discarded, so results are still reproducible after
+%   reseeding with IGRAPH.RNG or MATLAB's RNG. They will differ from the
+%   unbuffered results for the same seed though, and MATLAB's stream advances
+%   by whole buffers. The buffer has no effect on the generators other than
+%   'matlab'.
+%
+%   See also IGRAPH.RNG.
+
+    arguments
+        n = [];
+    end
+
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    if isempty(n)
+        action = 'get';
+        n = 0;
+    else
+        mustBeScalarOrEmpty(n);
+        mustBeNonnegative(n);
+        mustBeInteger(n);
+        action = 'set';
+    end
+
+    if nargout == 0 && strcmp(action, 'set')
+        mexIgraphDispatcher(opcode, action, double(n));
+    else
+        n = mexIgraphDispatcher(opcode, action, double(n));
+    end
+end
@@ -60,6 +60,11 @@ function save(filename, graph, ioOpts, graphOpts)
         graphOpts.?igutils.GraphInProps;
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
     graphOpts = namedargs2cell(graphOpts);
     graphOpts = igutils.setGraphInProps(graph, graphOpts{:});
 
@@ -80,10 +85,14 @@ function save(filename, graph, ioOpts, graphOpts)
         mustBeUndirected();
     end
 
-    mexIgraphDispatcher(mfilename(), filename, graph, ioOpts.format, ...
+    mexIgraphDispatcher(opcode, filename, graph, ioOpts.format, ...
                         graphOpts);
 
     function mustBeUndirected()
+        if strcmp(graphOpts.isdirected, 'infer')
+            graphOpts.isdirected = igraph.isdirected(graph);
+        end
+
         if graphOpts.isdirected
             eid = "igraph:directed";
             msg = "The '%s' format can only store undirected graphs but " + ...
@@ -96,6 +105,10 @@ function save(filename, graph, ioOpts, graphOpts)
     end
 
     function mustBeUnweighted()
+        if strcmp(graphOpts.isweighted, 'infer')
+            graphOpts.isweighted = igraph.isweighted(graph);
+        end
+
         if graphOpts.isweighted
             eid = "igraph:weighted";
             msg = "The '%s' format can only store unweighted graphs but " + ...
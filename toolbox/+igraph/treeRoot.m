@@ -11,11 +11,16 @@ function root = treeRoot(graph, opts)
         opts.mode (1, :) char {igutils.mustBeMode} = 'all';
     end
 
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", "istree");
+    end
+
     if ~igutils.isoptionset(opts, "isdirected")
        opts.isdirected = igraph.isdirected(graph) || opts.mode ~= "all";
     end
 
     opts.mode = lower(opts.mode);
     opts.findRoot = true;
-    root = mexIgraphDispatcher("isTree", graph, opts);
+    root = mexIgraphDispatcher(opcode, graph, opts);
 end
@@ -12,5 +12,10 @@ function verbose(handler, ison)
         ison (1, 1) logical;
     end
 
-    mexIgraphDispatcher(mfilename(), handler, ison);
+    persistent opcode
+    if isempty(opcode)
+        opcode = mexIgraphDispatcher("opcode", mfilename());
+    end
+
+    mexIgraphDispatcher(opcode, handler, ison);
 end
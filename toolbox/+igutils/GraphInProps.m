@@ -7,8 +7,8 @@ classdef GraphInProps
 %   See also IGUTILS.GRAPHOUTPROPS, IGUTILS.SETGRAPHINPROPS.
 
     properties (SetAccess = public)
-        isdirected (1, 1) logical
-        isweighted (1, 1) logical
+        isdirected {igutils.mustBeFlag}
+        isweighted {igutils.mustBeFlag}
         weight (1, :) char
     end
 end
@@ -8,9 +8,11 @@ classdef GraphOutProps
 
     properties (SetAccess = public)
         repr (1, :) char ...
-            {igutils.mustBeMemberi(repr, {'sparse', 'full', 'graph'})};
+            {igutils.mustBeMemberi(repr, [igutils.representations(), ...
+                                           {'auto'}])};
         dtype (1, :) char ...
-            {igutils.mustBeMemberi(dtype, {'double', 'logical'})};
+            {igutils.mustBeMemberi(dtype, igutils.datatypes())};
         weight (1, :) char
+        symmetric (1, 1) logical
     end
 end
@@ -3,5 +3,6 @@ function types = datatypes()
 %
 %   See also IGUTILS.REPRESENTATIONS.
 
-    types = {'logical', 'double'};
+    types = {'logical', 'double', 'single', 'int8', 'int16', 'int32', ...
+             'int64', 'uint8', 'uint16', 'uint32', 'uint64'};
 end
@@ -0,0 +1,36 @@
+function g = edges2graph(s, t, nNodes, isdirected, weights, weightVar)
+%EDGES2GRAPH create a graph type from an edge list
+%   G = EDGES2GRAPH(S, T, NNODES, ISDIRECTED) create a graph (or digraph if
+%   ISDIRECTED) with NNODES nodes and edges from S to T.
+%   G = EDGES2GRAPH(..., WEIGHTS, WEIGHTVAR) also add the edge variable
+%   WEIGHTVAR with values WEIGHTS.
+%
+%   This is intended for use inside mxIgraph files. It is in a public location
+%   only to ensure it is available regardless of where the MATLAB file that
+%   calls a mex function is located. Should be regarded as private.
+%
+%   Unlike STRUCT2GRAPH, the graph is built directly from the numeric arrays
+%   so no node or edge tables are created.
+%
+%   See also IGUTILS.STRUCT2GRAPH.
+
+    if isdirected
+        construct = @digraph;
+    else
+        construct = @graph;
+    end
+
+    if nargin < 5
+        g = construct(s, t);
+        if numnodes(g) < nNodes
+            g = addnode(g, nNodes - numnodes(g));
+        end
+
+        return
+    end
+
+    g = construct(s, t, weights, nNodes);
+    if ~strcmp(weightVar, 'Weight')
+        g.Edges.Properties.VariableNames{'Weight'} = weightVar;
+    end
+end
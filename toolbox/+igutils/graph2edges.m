@@ -0,0 +1,33 @@
+function [s, t, nNodes, weights] = graph2edges(graph, weightVar)
+%GRAPH2EDGES collect the edge list of a graph type
+%   [S, T, NNODES] = GRAPH2EDGES(GRAPH) returns the source and target nodes
+%   of each edge, in edge order, and the number of nodes.
+%   [S, T, NNODES, WEIGHTS] = GRAPH2EDGES(GRAPH, WEIGHTVAR) also returns the
+%   edge variable WEIGHTVAR.
+%
+%   This is intended for use inside mxIgraph files. It is in a public location
+%   only to ensure it is available regardless of where the mex file that
+%   depends on it is located.
+%
+%   Unlike GRAPH2STRUCT, the Edges table is not built for the common case.
+%   When WEIGHTVAR is 'Weight' and GRAPH has no parallel edges, weights are
+%   read from the weighted adjacency matrix. Multigraphs and other weight
+%   variables fall back to GRAPH.Edges, which builds the whole table since
+%   MATLAB has no accessor for a single edge variable.
+%
+%   See also IGUTILS.GRAPH2STRUCT.
+
+    [s, t] = findedge(graph);
+    nNodes = numnodes(graph);
+
+    if nargout < 4
+        return
+    end
+
+    if strcmp(weightVar, 'Weight') && ~ismultigraph(graph)
+        adj = adjacency(graph, 'weighted');
+        weights = full(adj(sub2ind(size(adj), s, t)));
+    else
+        weights = double(graph.Edges.(weightVar));
+    end
+end
@@ -0,0 +1,7 @@
+function TF = isedgelist(g)
+%ISEDGELIST determines if argument is an edge list structure
+%   An edge list is a structure with an m x 2 EndNodes field, an optional
+%   NumNodes field, and optionally a weight field holding one value per edge.
+
+    TF = isstruct(g) && isscalar(g) && isfield(g, 'EndNodes');
+end
@@ -0,0 +1,13 @@
+function mustBeFlag(flag)
+%MUSTBEFLAG assert the argument is a logical scalar or "infer"
+
+    isinfer = (ischar(flag) || isstring(flag)) && strcmp(flag, "infer");
+    islogicalscalar = isscalar(flag) && (islogical(flag) || ...
+                                         (isnumeric(flag) && ...
+                                          (flag == 0 || flag == 1)));
+    if ~(isinfer || islogicalscalar)
+        eid = "igraph:NotAFlag";
+        msg = "Value must be a logical scalar or ""infer"".";
+        throwAsCaller(MException(eid, msg));
+    end
+end
@@ -8,6 +8,17 @@ function mustBeGraph(graph)
         return
     end
 
+    if igutils.isedgelist(graph)
+        endNodes = graph.EndNodes;
+        if ~(isnumeric(endNodes) && isreal(endNodes) && ...
+             ismatrix(endNodes) && size(endNodes, 2) == 2)
+            msg = "Edge list EndNodes must be a real numeric m x 2 array.";
+            throwAsCaller(MException(eid, msg));
+        end
+
+        return
+    end
+
     if ~((isnumeric(graph) || islogical(graph)))
         msg = "Adjacency matrix must be numeric or logical";
     end
@@ -0,0 +1,22 @@
+function mustBeGraphOrBatch(graph)
+%MUSTBEGRAPHORBATCH assert the argument is a graph or a cell array of graphs
+%   Functions that accept a cell array of graphs run on every graph in a
+%   single call. See IGUTILS.MUSTBEGRAPH for what counts as a graph.
+%
+%   See also IGUTILS.MUSTBEGRAPH.
+
+    if ~iscell(graph)
+        igutils.mustBeGraph(graph);
+        return
+    end
+
+    for i = 1:numel(graph)
+        try
+            igutils.mustBeGraph(graph{i});
+        catch err
+            throwAsCaller(MException(err.identifier, ...
+                                     "Graph %d in batch is invalid: %s", ...
+                                     i, err.message));
+        end
+    end
+end
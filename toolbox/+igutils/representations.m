@@ -1,5 +1,5 @@
 function reprs = representations()
 %REPRESENTATIONS return all graph representations supported by matlab-igraph
 
-    reprs = {'sparse', 'full', 'graph'};
+    reprs = {'sparse', 'full', 'graph', 'edgelist'};
 end
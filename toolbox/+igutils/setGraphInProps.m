@@ -5,6 +5,11 @@ function args = setGraphInProps(graph, args)
 %   be in the form of a structure. To pass this to a function convert it to a
 %   cell with NAMEDARGS2CELL then call with ARGS{:}.
 %
+%   For adjacency matrices, unset 'isdirected' and 'isweighted' options are
+%   set to 'infer'. These are resolved by the MEX conversion layer in the same
+%   pass it uses to read the matrix's edges instead of scanning the matrix
+%   again here.
+%
 %   Options for output graphs (IGUTILS.GRAPHOUTPROPS) can also be passed in and
 %   will be returned untouched. This allows a single graph option set to be
 %   used for both creation of the input graph and the returned graph.
@@ -14,23 +19,40 @@ function args = setGraphInProps(graph, args)
     arguments
         graph
         args.?igutils.GraphOutProps
-        args.isweighted
-        args.isdirected
+        args.isweighted {igutils.mustBeFlag}
+        args.isdirected {igutils.mustBeFlag}
     end
 
     isoptionset = @igutils.isoptionset;
+    isadj = ~(igutils.isgraph(graph) || igutils.isedgelist(graph));
     if ~isoptionset(args, 'isdirected')
-        args.isdirected = igraph.isdirected(graph);
+        if isadj
+            args.isdirected = 'infer';
+        else
+            args.isdirected = igraph.isdirected(graph);
+        end
     end
 
     if ~isoptionset(args, 'isweighted')
-        args.isweighted = igraph.isweighted(graph);
+        if isadj
+            args.isweighted = 'infer';
+        else
+            args.isweighted = igraph.isweighted(graph);
+        end
     end
 
-    if args.isweighted && isoptionset(args, 'weight')
-        if ~igutils.isgraph(graph)
+    if ~isequal(args.isweighted, false) && isoptionset(args, 'weight')
+        if igutils.isedgelist(graph)
+            if ~isfield(graph, args.weight)
+                throwAsCaller(MException("igraph:invalidWeight", ...
+                                         "The requested weight field " + ...
+                                         "('%s') was not found in the " + ...
+                                         "edge list.", args.weight));
+            end
+        elseif ~igutils.isgraph(graph)
             warning("Option 'weight' set but is only used for 'graph' " + ...
-                    "representations, the value will be ignored.");
+                    "and 'edgelist' representations, the value will " + ...
+                    "be ignored.");
         elseif ~igutils.hasEdgeAttr(graph, args.weight)
             edgeAttrs = igutils.listEdgeAttr(graph);
             throwAsCaller(MException("igraph:invalidWeight", ...
@@ -46,9 +68,16 @@ function args = setGraphInProps(graph, args)
         if igutils.hasEdgeAttr(graph, 'Weight');
             args.weight = 'Weight';
         elseif igutils.hasEdgeAttr(graph)
-            args.weight = igutils.listEdgeAttrs(graph)
+            args.weight = igutils.listEdgeAttrs(graph);
             args.weight = args.weight{1};
         end
+    elseif igutils.isedgelist(graph)
+        weightFields = setdiff(fieldnames(graph), {'EndNodes', 'NumNodes'});
+        if isempty(weightFields) || isfield(graph, 'Weight')
+            args.weight = 'Weight';
+        else
+            args.weight = weightFields{1};
+        end
     else
         args.weight = 'Weight';
     end
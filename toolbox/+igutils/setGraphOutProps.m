@@ -20,6 +20,7 @@ function args = setGraphOutProps(args)
         args.repr
         args.dtype
         args.multiple
+        args.symmetric
     end
 
     isoptionset = @igutils.isoptionset;
@@ -48,33 +49,56 @@ function args = setGraphOutProps(args)
     args.repr = lower(args.repr);
 
     if isoptionset(args, 'weight')
-        if ~strcmp(args.repr, 'graph')
-            warning("Option weight is only used for 'graph' " + ...
-                    "representation, ignoring value.");
+        if ~ismember(args.repr, {'graph', 'edgelist'})
+            warning("Option weight is only used for 'graph' and " + ...
+                    "'edgelist' representations, ignoring value.");
         end
     else
         args.weight = 'Weight';
     end
 
+    if strcmp(args.repr, 'edgelist') && ...
+            ismember(args.weight, {'EndNodes', 'NumNodes'})
+        throwAsCaller(MException("igraph:invalidOption", ...
+                                 "The weight field of an edge list can " + ...
+                                 "not be named '%s'.", args.weight));
+    end
+
+    if ~isoptionset(args, 'symmetric')
+        args.symmetric = false;
+    end
+
+    if strcmp(args.repr, 'sparse') && ...
+            ~ismember(args.dtype, {'double', 'logical'})
+        throwAsCaller(MException("igraph:invalidOption", ...
+                                 "Sparse matrices can only be 'double' " + ...
+                                 "or 'logical', use 'full' as " + ...
+                                 "representation to return a '%s' " + ...
+                                 "graph.", args.dtype));
+    end
+
     if isoptionset(args, 'multiple') && args.multiple && ...
-            ~strcmp(args.repr, 'graph')
+            ~ismember(args.repr, {'graph', 'edgelist'})
         throwAsCaller(MException("igraph:invalidOption", ...
                                  "Adjacency matrices cannot express " + ...
-                                 "multigraphs, use 'graph' as " + ...
-                                 "representation or set multiple to false."));
+                                 "multigraphs, use 'graph' or " + ...
+                                 "'edgelist' as representation or set " + ...
+                                 "multiple to false."));
     end
 end
 
 function type = dtype(graph)
     type = 'double';
-    if ~igutils.isgraph(graph) && islogical(graph)
-        type = 'logical';
+    if ~igutils.isgraph(graph) && ~igutils.isedgelist(graph)
+        type = class(graph);
     end
 end
 
 function type = repr(graph)
    if igutils.isgraph(graph)
        type = 'graph';
+   elseif igutils.isedgelist(graph)
+       type = 'edgelist';
    elseif issparse(graph)
        type = 'sparse';
    else
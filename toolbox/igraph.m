@@ -56,7 +56,8 @@
 %       error will be thrown. If the WEIGHT argument is set but the graph is
 %       not of a 'graph' representation (see REPR option in functions returning
 %       graphs section) a warning will be printed and the value of WEIGHT will
-%       be ignored.
+%       be ignored. For the 'edgelist' representation, WEIGHT names the field
+%       holding the weights.
 %
 %       If the results of the function are of the form of a vector with one
 %       value per node or edge and the graph is in a 'graph' representation,
@@ -84,29 +85,58 @@
 %       matrix syntax.
 %
 %       To change the format a graph is returned in, the arguments: REPR,
-%       DTYPE, and WEIGHT can be passed to any function that returns a graph
-%       (including those that modify a graph).
+%       DTYPE, WEIGHT, and SYMMETRIC can be passed to any function that
+%       returns a graph (including those that modify a graph).
 %
 %       REPR describes the graphs representation can be one of the strings
-%       'full', 'sparse', or 'graph' (default). If REPR is 'full' the graph
-%       will be represented as an adjacency matrix. 'sparse' will also
-%       represent the graph as an adjacency matrix but will be in a sparse
-%       matrix instead of a full matrix. This can significantly reduce memory
-%       requirements for large graphs with a low edge density. Lastly 'graph'
-%       will return a graph as either a MATLAB GRAPH or DIGRAPH object
-%       depending on if the graph is directed or not.
-%
-%       DTYPE changes the data type used to store the graph. It can be either
-%       'double' (default) or 'logical'. 'logical' can reduce memory
-%       requirements but it will always drop any weights the graph may have. In
-%       the case of a 'graph' representation, the weights attribute will be
-%       omitted altogether rather than storing 1 for every edge.
+%       'full', 'sparse', 'edgelist', or 'graph' (default). If REPR is 'full'
+%       the graph will be represented as an adjacency matrix. 'sparse' will
+%       also represent the graph as an adjacency matrix but will be in a
+%       sparse matrix instead of a full matrix. This can significantly reduce
+%       memory requirements for large graphs with a low edge density.
+%       'edgelist' returns a structure with an m x 2 'EndNodes' field, a
+%       'NumNodes' field, and, if weighted, a field named by WEIGHT holding
+%       the edge weights. No adjacency matrix is formed to read or write edge
+%       lists and, like 'graph', they can hold multiple edges between a node
+%       pair. Edge lists given as input may store their end nodes as any
+%       numeric type and may omit 'NumNodes', in which case the largest end
+%       node is used. Edge lists are assumed to be directed
+%       unless ISDIRECTED is false. Lastly 'graph' will return a graph as
+%       either a MATLAB GRAPH or DIGRAPH object depending on if the graph is
+%       directed or not. 'auto' returns whichever of a 'full' or 'sparse'
+%       adjacency matrix takes less memory, always 'full' if DTYPE is not
+%       'double' or 'logical'.
+%
+%       Before building the returned graph, its size in the requested
+%       representation is estimated. If the estimate exceeds the memory
+%       budget (by default half of the physical memory) an error giving the
+%       estimate is raised instead. See IGRAPH.MEMORYBUDGET to change the
+%       budget.
+%
+%       DTYPE changes the data type used to store the graph. It can be
+%       'double' (default), 'logical', 'single', or any of MATLAB's integer
+%       types ('int8', 'uint8', ..., 'int64', 'uint64'). 'logical' can reduce
+%       memory requirements but it will always drop any weights the graph may
+%       have. In the case of a 'graph' representation, the weights attribute
+%       will be omitted altogether rather than storing 1 for every edge.
+%       'single' and the integer types apply to 'full' adjacency matrices and
+%       the weights of 'edgelist' graphs, weights are rounded and saturated
+%       as MATLAB's casts would. MATLAB's sparse matrices can only be 'double'
+%       or 'logical'. Input graphs may be any of these types, they are read
+%       in their own type without first being converted to double.
 %
 %       WEIGHT is the same as for input graphs. When the return representation
 %       is 'graph', the WEIGHT argument can be used to store WEIGHTS in
 %       an edge attribute different than the default 'Weight' name. If a value
-%       is passed when REPR is not 'graph' a warning will be printed and the
-%       value will be ignored.
+%       is passed when REPR is not 'graph' or 'edgelist' a warning will be
+%       printed and the value will be ignored.
+%
+%       SYMMETRIC, when true, stores each edge of an undirected graph in both
+%       triangles of an adjacency matrix. By default (false) each edge only
+%       appears once so the adjacency matrix of an undirected graph is
+%       triangular. Ignored for directed graphs and the 'graph'
+%       representation. In adjacency matrices, the weights of parallel
+%       edges are summed.
 %
 %   Examples:
 %      Get the well known Zachary Karate Club graph, display information about